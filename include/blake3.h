@@ -0,0 +1,68 @@
+#ifndef BLAKE3_H
+#define BLAKE3_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Размер куска (chunk) BLAKE3 — листа дерева.
+ */
+constexpr size_t BLAKE3_CHUNK_LEN = 1024;
+
+/**
+ * @brief Потоковый контекст BLAKE3.
+ *
+ * Вход делится на куски по 1024 байта, каждый сжимается блоками по 64 байта
+ * в цепочечное значение (CV); CV кусков сводятся в двоичное дерево.
+ * Готовые поддеревья хранятся в стеке: их число равно числу единичных
+ * бит в счётчике завершённых кусков, поэтому 54 записей хватает на 2⁶⁴ байт.
+ */
+struct Blake3Context {
+    std::array<uint32_t, 8> key;            ///< Ключ (для обычного хеша — IV).
+    std::array<uint32_t, 8> cv;             ///< CV текущего куска.
+    uint64_t chunk_counter;                 ///< Номер текущего куска.
+    std::array<uint8_t, 64> block;          ///< Неполный блок текущего куска.
+    size_t used;                            ///< Заполнено байт в block.
+    unsigned blocks_compressed;             ///< Сжато блоков текущего куска.
+    uint8_t flags;                          ///< Флаги режима (для обычного хеша 0).
+    std::array<std::array<uint32_t, 8>, 54> stack;
+    size_t stack_size;
+};
+
+void blake3_init(Blake3Context& ctx);
+
+/**
+ * @brief Добавляет данные.
+ *
+ * Целые куски, за которыми есть ещё данные, сжимаются пачками сразу по
+ * нескольким кускам: по 16 на AVX‑512, по 8 на AVX2, по 4 на SSE4.1.
+ */
+void blake3_update(Blake3Context& ctx, const uint8_t* data, size_t size);
+
+/**
+ * @brief Завершает вычисление.
+ *
+ * BLAKE3 — функция с расширяемым выходом: первые 32 байта — стандартный
+ * дайджест, более длинный выход продолжает его.
+ *
+ * @param out  Буфер результата.
+ * @param size Длина выхода в байтах (обычно 32).
+ */
+void blake3_final(Blake3Context& ctx, uint8_t* out, size_t size = 32);
+
+/**
+ * @brief Вычисляет BLAKE3 файла.
+ *
+ * Файл делится на выровненные поддеревья размером с буфер пула; они
+ * читаются позиционно и хешируются параллельно, их CV сводятся по
+ * порядку. Последний (возможно неполный) сегмент досчитывается потоково,
+ * так как он содержит корень дерева.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Хеш в hex или пустая строка при ошибке чтения.
+ */
+std::string blake3_file(const std::string& filepath, unsigned threads = 0);
+
+#endif
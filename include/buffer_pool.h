@@ -0,0 +1,76 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Общий для процесса пул буферов ввода‑вывода с ограничением памяти.
+ *
+ * Все функции чтения файлов берут буферы только отсюда. Суммарный объём
+ * выделенных буферов не превышает memory_limit(); если свободных буферов
+ * нет и лимит исчерпан, acquire() блокирует поток до возврата буфера
+ * другим потоком. Возвращённые буферы не освобождаются, а переиспользуются,
+ * поэтому в установившемся режиме выделений памяти нет.
+ */
+namespace buffer_pool {
+    /// Размер буфера по умолчанию.
+    constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+    /// Минимальный размер буфера при очень малом лимите.
+    constexpr size_t MIN_BUFFER_SIZE = 64 << 10;
+    /// Лимит памяти по умолчанию.
+    constexpr uint64_t DEFAULT_MEMORY_LIMIT = 256ull << 20;
+
+    /**
+     * @brief RAII‑владелец буфера из пула; при разрушении возвращает его в пул.
+     */
+    class Buffer {
+    public:
+        Buffer() = default;
+        Buffer(Buffer&& other) noexcept;
+        Buffer& operator=(Buffer&& other) noexcept;
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        ~Buffer();
+
+        uint8_t* data() const { return data_.get(); }
+        size_t size() const { return size_; }
+
+    private:
+        friend Buffer acquire();
+        std::unique_ptr<uint8_t[]> data_;
+        size_t size_ = 0;
+    };
+
+    /**
+     * @brief Задаёт лимит памяти пула в байтах.
+     *
+     * Размер буфера — четверть лимита, но не больше DEFAULT_BUFFER_SIZE и не
+     * меньше MIN_BUFFER_SIZE, так что при лимите от 4 · MIN_BUFFER_SIZE в пуле
+     * помещается не меньше четырёх буферов, а при меньшем — от одного до трёх.
+     * Уже выданные буферы остаются действительными; лишние свободные буферы
+     * освобождаются.
+     *
+     * @param bytes Максимальный суммарный объём буферов.
+     * @return false, если bytes < MIN_BUFFER_SIZE: в такой лимит не помещается
+     *         ни один буфер, и лимит не меняется.
+     */
+    bool set_memory_limit(uint64_t bytes);
+
+    /// Текущий лимит памяти пула.
+    uint64_t memory_limit();
+
+    /// Размер буферов, выдаваемых acquire().
+    size_t buffer_size();
+
+    /// Сколько буферов сейчас выделено (выданных и свободных).
+    size_t allocated_buffers();
+
+    /**
+     * @brief Берёт буфер из пула, при исчерпании лимита ждёт освобождения.
+     */
+    Buffer acquire();
+}
+
+#endif
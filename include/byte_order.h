@@ -0,0 +1,82 @@
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief Чтение и запись целых в заданном порядке байт.
+ *
+ * Используются для бинарных форматов (состояния хешей, файлы‑спутники),
+ * чтобы они не зависели от порядка байт платформы.
+ */
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Загрузка одной инструкцией (mov/movbe) вместо сборки по байтам.
+inline uint32_t load_le32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return __builtin_bswap32(load_le32(p));
+}
+
+inline uint64_t load_be64(const uint8_t* p) {
+    return __builtin_bswap64(load_le64(p));
+}
+#else
+inline uint32_t load_le32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline uint64_t load_le64(const uint8_t* p) {
+    return uint64_t(load_le32(p)) | (uint64_t(load_le32(p + 4)) << 32);
+}
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline uint64_t load_be64(const uint8_t* p) {
+    return (uint64_t(load_be32(p)) << 32) | uint64_t(load_be32(p + 4));
+}
+#endif
+
+inline void store_le32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = uint8_t(v >> (8 * i));
+}
+
+inline void store_le64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * i));
+}
+
+inline void store_be32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = uint8_t(v >> (8 * (3 - i)));
+}
+
+inline void store_be64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * (7 - i)));
+}
+
+/// Дописывает v в конец out в little endian.
+inline void append_le32(std::string& out, uint32_t v) {
+    uint8_t b[4];
+    store_le32(b, v);
+    out.append(reinterpret_cast<const char*>(b), 4);
+}
+
+inline void append_le64(std::string& out, uint64_t v) {
+    uint8_t b[8];
+    store_le64(b, v);
+    out.append(reinterpret_cast<const char*>(b), 8);
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CAS_H
+#define CAS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Итог проверки хранилища, адресуемого по содержимому.
+struct CasReport {
+    uint64_t verified = 0;                ///< Блобов, совпавших со своим именем.
+    uint64_t bytes = 0;                   ///< Прочитано байт.
+    std::vector<std::string> corrupt;     ///< Содержимое не соответствует имени.
+    std::vector<std::string> misnamed;    ///< Имя не является дайджестом алгоритма каталога.
+    std::vector<std::string> unreadable;  ///< Ошибка чтения.
+};
+
+/**
+ * @brief Проверяет хранилище вида "<algo>/<hex‑дайджест>".
+ *
+ * Если в root есть каталог blobs (OCI image layout), проверяется он.
+ * Каждый подкаталог с именем алгоритма, известного make_hasher(), обходится
+ * рекурсивно (допускаются промежуточные каталоги вида "sha256/ab/abcd…"),
+ * имя каждого файла сравнивается с его хешем. Прочие каталоги и файлы
+ * верхнего уровня пропускаются. Блобы проверяются параллельно через
+ * hash_files(), крупные первыми, чтобы последний поток не заканчивал
+ * один большой файл.
+ *
+ * Имя в верхнем регистре с верным хешем считается misnamed: в OCI
+ * дайджест записывается строчными буквами.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return false, если root не является каталогом или его нельзя обойти.
+ */
+bool cas_verify(const std::string& root, CasReport& report, unsigned threads = 0);
+
+#endif
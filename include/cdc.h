@@ -0,0 +1,87 @@
+#ifndef CDC_H
+#define CDC_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Параметры разбиения FastCDC.
+ *
+ * Граница не ставится раньше min_size и ставится принудительно на max_size;
+ * средний размер куска близок к avg_size.
+ */
+struct CdcParams {
+    uint64_t min_size = 16 << 10;
+    uint64_t avg_size = 64 << 10;
+    uint64_t max_size = 256 << 10;
+};
+
+/// Кусок файла с границами, зависящими от содержимого.
+struct CdcChunk {
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    std::string hash;   ///< SHA‑256 куска (hex).
+};
+
+/// Статистика дедупликации по набору кусков.
+struct DedupStats {
+    uint64_t files = 0;
+    uint64_t chunks = 0;
+    uint64_t unique_chunks = 0;
+    uint64_t total_bytes = 0;
+    uint64_t unique_bytes = 0;
+
+    /// total_bytes / unique_bytes; 1 — повторов нет.
+    double ratio() const;
+};
+
+/**
+ * @brief Проверяет параметры: 64 <= min_size <= avg_size <= max_size.
+ */
+bool cdc_params_valid(const CdcParams& params);
+
+/**
+ * @brief Разбивает файл на куски FastCDC и хеширует каждый SHA‑256.
+ *
+ * Gear‑хеш: fp = (fp << 1) + GEAR[байт]; граница — когда старшие биты fp
+ * под маской равны нулю. Нормализованное разбиение: до avg_size маска на
+ * бит строже, после — на бит мягче, что сужает разброс размеров. Первые
+ * min_size байт куска не сканируются.
+ *
+ * Файл читается один раз порциями из пула буферов. Поиск границ идёт на
+ * вызывающем потоке, SHA‑256 кусков — конвейером на рабочих потоках
+ * (кусок i на исполнителе i % threads), поэтому сканирование следующей
+ * порции перекрывается с хешированием предыдущих. Пустой файл — без кусков.
+ *
+ * @param threads Потоков для SHA‑256; 0 — по числу ядер.
+ * @return false при неверных параметрах или ошибке чтения.
+ */
+bool cdc_chunk_file(const std::string& filepath, const CdcParams& params,
+                    std::vector<CdcChunk>& chunks, unsigned threads = 0);
+
+/**
+ * @brief Добавляет куски одного файла в статистику дедупликации.
+ *
+ * Куски с одинаковым хешем считаются одним; seen хранит уже встреченные хеши.
+ */
+void add_dedup_stats(const std::vector<CdcChunk>& chunks, std::unordered_set<std::string>& seen, DedupStats& stats);
+
+/**
+ * @brief Разбивает файл или все файлы каталога и пишет список кусков.
+ *
+ * @code
+ * # fastcdc min=16384 avg=65536 max=262144
+ * file: dir/a.bin
+ * <sha256> <offset> <length>
+ * ...
+ * @endcode
+ *
+ * @param list_path Путь к списку; пустой — список не пишется.
+ * @return false при ошибке чтения файлов или записи списка.
+ */
+bool cdc_chunk_tree(const std::string& path, const CdcParams& params, const std::string& list_path,
+                    DedupStats& stats, unsigned threads = 0);
+
+#endif
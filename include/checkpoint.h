@@ -0,0 +1,41 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Результат хеширования с контрольными точками.
+ */
+struct CheckpointResult {
+    std::string hash;           ///< Хеш в hex; пустая строка при ошибке.
+    uint64_t resumed_from = 0;  ///< Смещение, с которого продолжено вычисление.
+    unsigned checkpoints = 0;   ///< Сколько контрольных точек записано.
+};
+
+/**
+ * @brief Путь к файлу контрольной точки по умолчанию: "<filepath>.<algo>.checkpoint".
+ */
+std::string checkpoint_path(const std::string& filepath, const std::string& algo);
+
+/**
+ * @brief Хеширует файл, периодически сохраняя состояние алгоритма.
+ *
+ * Каждые interval байт состояние хешера (Hasher::save_state()) вместе с
+ * размером и mtime файла записывается в файл контрольной точки. Если при
+ * запуске найдена контрольная точка для того же алгоритма и неизменённого
+ * файла, вычисление продолжается с неё, так что после сбоя теряется не
+ * больше interval байт работы. После успешного завершения контрольная
+ * точка удаляется.
+ *
+ * @param algo       Имя алгоритма (см. make_hasher()).
+ * @param filepath   Путь к файлу.
+ * @param interval   Интервал между контрольными точками в байтах (> 0).
+ * @param checkpoint Путь к файлу контрольной точки; пустой — checkpoint_path().
+ * @return Пустой hash при ошибке чтения, неизвестном алгоритме или
+ *         алгоритме без сериализации состояния (Hasher::save_state()).
+ */
+CheckpointResult hash_file_checkpointed(const std::string& algo, const std::string& filepath,
+                                        uint64_t interval, const std::string& checkpoint = "");
+
+#endif
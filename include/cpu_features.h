@@ -0,0 +1,95 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+/**
+ * @brief Определение возможностей процессора для выбора SIMD‑ядер.
+ *
+ * SIMD‑ядра собираются через __attribute__((target(...))) только на x86
+ * компиляторами GCC/Clang (макрос HASH_X86_SIMD), а выбираются во время
+ * выполнения, поэтому исполняемый файл работает и на старых процессорах.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_X86_SIMD 1
+#endif
+
+/**
+ * @brief Обрамляют ядра AVX‑512: GCC 12 при -Wall принимает заполнитель
+ *        _mm512_undefined_*() внутри _mm512_unpack*, _mm512_ror_epi32 и
+ *        подобных intrinsics за неинициализированную переменную ('__Y').
+ *
+ * Предупреждения ложные, поэтому отключаются только на участках с ядрами.
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#define HASH_AVX512_WARNINGS_PUSH                                   \
+    _Pragma("GCC diagnostic push")                                  \
+    _Pragma("GCC diagnostic ignored \"-Wuninitialized\"")           \
+    _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define HASH_AVX512_WARNINGS_POP _Pragma("GCC diagnostic pop")
+#else
+#define HASH_AVX512_WARNINGS_PUSH
+#define HASH_AVX512_WARNINGS_POP
+#endif
+
+/**
+ * @brief Уровни SIMD‑ядер по возрастанию ширины.
+ *
+ * Признаки процессора отнесены к уровню, с которого они есть у всех
+ * процессоров: SSE4.2 и PCLMULQDQ — к sse41, BMI1/BMI2 — к avx2.
+ */
+enum class SimdLevel { scalar, sse2, sse41, avx2, avx512f, avx512bw };
+
+/// Все уровни по возрастанию — для перебора в тестах.
+constexpr SimdLevel SIMD_LEVELS[] = { SimdLevel::scalar, SimdLevel::sse2, SimdLevel::sse41,
+                                      SimdLevel::avx2, SimdLevel::avx512f, SimdLevel::avx512bw };
+
+/**
+ * @brief Ограничивает SIMD‑ядра уровнем level (по умолчанию — без ограничения).
+ *
+ * cpu_has_*() для признаков выше level возвращают false, и диспетчеры
+ * выбирают более узкое ядро. Так тесты проверяют каждое ядро на машине,
+ * где доступны и более широкие; уровень выше возможностей процессора
+ * ничего не добавляет.
+ */
+void set_simd_max_level(SimdLevel level);
+
+/// Текущий предел уровня SIMD‑ядер.
+SimdLevel simd_max_level();
+
+/**
+ * @brief Разрешает или запрещает SIMD‑ядра (по умолчанию разрешены).
+ *
+ * То же, что set_simd_max_level() с SimdLevel::scalar или без ограничения.
+ */
+void set_simd_enabled(bool enabled);
+
+/// Разрешены ли SIMD‑ядра (предел выше SimdLevel::scalar).
+bool simd_enabled();
+
+/// Доступен ли SSE2 (с учётом set_simd_max_level()); на x86‑64 есть всегда.
+bool cpu_has_sse2();
+
+/// Доступен ли SSE4.1 (с учётом set_simd_max_level()).
+bool cpu_has_sse41();
+
+/// Доступен ли SSE4.2 (инструкция crc32; с учётом set_simd_max_level()).
+bool cpu_has_sse42();
+
+/// Доступен ли PCLMULQDQ (умножение без переносов; с учётом set_simd_max_level()).
+bool cpu_has_pclmul();
+
+/// Доступен ли BMI1 (andn; с учётом set_simd_max_level()).
+bool cpu_has_bmi();
+
+/// Доступен ли BMI2 (rorx, shrx; с учётом set_simd_max_level()).
+bool cpu_has_bmi2();
+
+/// Доступен ли AVX2 (с учётом set_simd_max_level()).
+bool cpu_has_avx2();
+
+/// Доступен ли AVX‑512F с поддержкой ОС (с учётом set_simd_max_level()).
+bool cpu_has_avx512f();
+
+/// Доступен ли AVX‑512BW (байтовые перестановки vpshufb на 512 битах; с учётом set_simd_max_level()).
+bool cpu_has_avx512bw();
+
+#endif
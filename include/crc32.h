@@ -0,0 +1,55 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Контрольные суммы CRC32 (IEEE 802.3, как у zlib/gzip/zip) и
+ *        CRC32C (Castagnoli, как у iSCSI/ext4).
+ *
+ * ВНИМАНИЕ: CRC обнаруживает случайные повреждения, но не защищает от
+ * намеренных изменений; для проверки целостности против злоумышленника
+ * нужны SHA‑2/BLAKE.
+ *
+ * Функции продолжают вычисление как crc32() из zlib: crc — итог
+ * предыдущей части (0 для начала), результат — CRC всех данных, так что
+ * crc32c(crc32c(0, a), b) == CRC32C(a || b).
+ */
+uint32_t crc32c(uint32_t crc, const uint8_t* data, size_t size);
+
+/// CRC32 (IEEE); соглашения те же, что у crc32c().
+uint32_t crc32_ieee(uint32_t crc, const uint8_t* data, size_t size);
+
+/**
+ * @brief CRC32C конкатенации A || B по CRC частей и длине B.
+ *
+ * Позволяет считать CRC кусков файла параллельно и затем свести их
+ * по порядку, не перечитывая данные. Стоимость — O(log len_b).
+ */
+uint32_t crc32c_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b);
+
+/// То же, что crc32c_combine(), для CRC32 (IEEE).
+uint32_t crc32_ieee_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b);
+
+/**
+ * @brief Вычисляет CRC32C файла.
+ *
+ * Файл делится на сегменты размером с буфер пула; их CRC считаются
+ * параллельно и сводятся через crc32c_combine().
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return 8 hex‑символов (значение CRC в big endian, как печатают
+ *         утилиты) или пустая строка при ошибке чтения.
+ */
+std::string crc32c_file(const std::string& filepath, unsigned threads = 0);
+
+/**
+ * @brief Вычисляет CRC32 (IEEE) файла; совпадает с crc32 из gzip/zip.
+ *
+ * @return 8 hex‑символов или пустая строка при ошибке чтения.
+ */
+std::string crc32_file(const std::string& filepath, unsigned threads = 0);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef ETAG_H
+#define ETAG_H
+
+#include <cstdint>
+#include <string>
+
+/// Размер части по умолчанию (как у aws cli).
+constexpr uint64_t S3_DEFAULT_PART_SIZE = 8ull << 20;
+
+/**
+ * @brief Вычисляет ETag объекта S3, загруженного частями по part_size байт.
+ *
+ * Для файла не больше одной части это обычный MD5 (как при загрузке одним
+ * запросом). Иначе — MD5 от склеенных бинарных MD5 частей и суффикс
+ * "-<число частей>". MD5 частей считаются параллельно.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return ETag без кавычек или пустая строка при ошибке.
+ */
+std::string s3_etag(const std::string& filepath, uint64_t part_size, unsigned threads = 0);
+
+/**
+ * @brief Проверяет файл по ожидаемому ETag.
+ *
+ * Кавычки вокруг ETag допускаются. Число частей берётся из суффикса "-N",
+ * а размер части подбирается среди типичных значений (5, 8, 16, ... МиБ и
+ * ceil(размер / N), округлённого до МиБ), для которых получается ровно N частей.
+ *
+ * @param part_size Если не nullptr — размер части, на котором ETag совпал.
+ * @return true, если найден размер части, дающий ожидаемый ETag.
+ */
+bool verify_s3_etag(const std::string& filepath, const std::string& expected, uint64_t* part_size = nullptr);
+
+#endif
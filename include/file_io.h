@@ -0,0 +1,74 @@
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Приёмник очередной порции данных файла.
+ */
+using ChunkSink = std::function<void(const uint8_t* data, size_t size)>;
+
+/**
+ * @brief Последовательно читает файл порциями через буфер из buffer_pool.
+ *
+ * Буфер берётся один на всё чтение и возвращается в пул по окончании,
+ * поэтому одновременное чтение многих файлов укладывается в лимит пула.
+ *
+ * @param filepath Путь к файлу.
+ * @param sink     Вызывается для каждой прочитанной порции по порядку.
+ * @return false, если файл не удалось открыть или прочитать.
+ */
+bool read_file_chunks(const std::string& filepath, const ChunkSink& sink);
+
+/**
+ * @brief Файл, открытый только для позиционного чтения (pread).
+ *
+ * Позиционное чтение не сдвигает общий указатель файла, поэтому один
+ * объект можно одновременно читать из нескольких потоков без блокировок.
+ */
+class RandomAccessFile {
+public:
+    explicit RandomAccessFile(const std::string& filepath);
+    ~RandomAccessFile();
+    RandomAccessFile(const RandomAccessFile&) = delete;
+    RandomAccessFile& operator=(const RandomAccessFile&) = delete;
+
+    bool is_open() const;
+
+    /// Текущий размер файла в байтах.
+    uint64_t size() const;
+
+    /**
+     * @brief Читает не больше size байт по смещению offset.
+     * @return Число прочитанных байт (0 — конец файла) или -1 при ошибке.
+     */
+    int64_t read_at(uint64_t offset, uint8_t* buffer, size_t size) const;
+
+    /**
+     * @brief Читает ровно length байт с offset порциями через буфер пула.
+     * @return false при ошибке чтения или если файл короче offset + length.
+     */
+    bool read_range(uint64_t offset, uint64_t length, const ChunkSink& sink) const;
+
+private:
+#ifdef _WIN32
+    void* handle_;
+#else
+    int fd_;
+#endif
+};
+
+/**
+ * @brief Читает ровно length байт файла, начиная со смещения offset.
+ *
+ * Данные за пределами [offset, offset + length) не читаются, даже если
+ * файл в это время дописывается.
+ *
+ * @return false, если файл не открылся или оказался короче offset + length.
+ */
+bool read_file_range(const std::string& filepath, uint64_t offset, uint64_t length, const ChunkSink& sink);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef FSVERITY_H
+#define FSVERITY_H
+
+#include <cstdint>
+#include <string>
+
+/// Размер блока дерева fs-verity (значение по умолчанию fsverity-utils).
+constexpr uint64_t FSVERITY_BLOCK_SIZE = 4096;
+
+/**
+ * @brief Вычисляет дайджест fs-verity (SHA‑256, блок 4 КиБ, без соли) в userspace.
+ *
+ * Нижний уровень — SHA‑256 каждого блока данных (последний дополняется
+ * нулями до 4 КиБ), каждый следующий — SHA‑256 блоков по 128 хешей
+ * нижнего уровня, пока не останется один хеш. Дайджест — SHA‑256
+ * 256‑байтового дескриптора (версия, алгоритм, log2 блока, размер файла,
+ * корень). Совпадает с `fsverity digest`. Блоки хешируются параллельно
+ * пачками, а дерево строится по мере чтения: кроме буферов пула хранится
+ * не больше 128 хешей на уровень.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Дайджест в hex или пустая строка при ошибке чтения.
+ */
+std::string fsverity_compute(const std::string& filepath, unsigned threads = 0);
+
+/**
+ * @brief Запрашивает у ядра измерение файла с включённым fs-verity.
+ *
+ * FS_IOC_MEASURE_VERITY возвращает дайджест, не читая данных. Принимается
+ * только SHA‑256; блок дерева задаётся при включении verity на файле.
+ *
+ * @return Дайджест в hex или пустая строка, если файл не защищён
+ *         fs-verity, ФС или платформа это не поддерживают.
+ */
+std::string fsverity_measure(const std::string& filepath);
+
+/**
+ * @brief Дайджест fs-verity: измерение ядра, если оно доступно, иначе
+ *        вычисление fsverity_compute().
+ *
+ * @param measured Если не nullptr — true, когда ответ получен от ядра.
+ * @return Дайджест в hex или пустая строка при ошибке чтения.
+ */
+std::string fsverity_digest(const std::string& filepath, unsigned threads = 0, bool* measured = nullptr);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef FUZZY_H
+#define FUZZY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Нечёткий хеш CTPH (context triggered piecewise hash), совместимый с ssdeep.
+ *
+ * Скользящий хеш по окну 7 байт задаёт границы кусков; на каждой границе
+ * в подпись дописывается символ base64 от FNV‑хеша куска. Подписи
+ * строятся сразу для всех размеров блока 3·2ⁱ, в итог выбирается
+ * наименьший, дающий не меньше 32 символов. Результат:
+ * "размер_блока:подпись:подпись_для_удвоенного_блока".
+ */
+class FuzzyHasher {
+public:
+    FuzzyHasher();
+
+    /// Добавляет данные.
+    void update(const uint8_t* data, size_t size);
+
+    /// Текущая подпись; вычисление можно продолжать.
+    std::string digest() const;
+
+private:
+    static constexpr unsigned SPAMSUM_LENGTH = 64;
+    static constexpr unsigned NUM_BLOCKHASHES = 31;
+    static constexpr unsigned ROLLING_WINDOW = 7;
+
+    struct BlockHash {
+        uint8_t h;
+        uint8_t halfh;
+        char digest[SPAMSUM_LENGTH];
+        char halfdigest;
+        unsigned dlen;
+    };
+
+    void step(uint8_t c);
+    void try_fork();
+    void try_reduce();
+
+    BlockHash bh_[NUM_BLOCKHASHES];
+    unsigned bhstart_ = 0;
+    unsigned bhend_ = 1;
+    uint64_t total_size_ = 0;
+
+    uint8_t window_[ROLLING_WINDOW] = {};
+    uint32_t h1_ = 0, h2_ = 0, h3_ = 0;
+    unsigned n_ = 0;
+};
+
+/**
+ * @brief Оценка сходства двух подписей ssdeep, 0–100 (как ssdeep -d).
+ *
+ * Сравниваются подписи одинакового или соседнего (вдвое) размера блока;
+ * допускается хвост ",\"имя файла\"" из вывода ssdeep.
+ *
+ * @return 0–100 или −1, если строка не является подписью.
+ */
+int fuzzy_compare(const std::string& a, const std::string& b);
+
+/**
+ * @brief Вычисляет криптографические хеши и нечёткий хеш файла за одно чтение.
+ *
+ * Каждая порция из пула буферов передаётся всем потребителям, каждый на
+ * своём потоке, поэтому файл не перечитывается, а медленный побайтовый
+ * CTPH идёт параллельно с MD5/SHA.
+ *
+ * @param algos   Алгоритмы (см. make_hasher()).
+ * @param digests Хеши в hex в порядке algos.
+ * @param fuzzy   Подпись ssdeep.
+ * @return false при ошибке чтения или неизвестном алгоритме.
+ */
+bool fuzzy_hash_file(const std::string& filepath, const std::vector<std::string>& algos,
+                     std::vector<std::string>& digests, std::string& fuzzy);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef GIT_HASH_H
+#define GIT_HASH_H
+
+#include <string>
+
+/**
+ * @brief Вычисляет идентификатор git‑объекта blob для файла.
+ *
+ * Хеш от "blob <размер>\0" и содержимого файла — то же, что выдаёт
+ * `git hash-object` (без фильтров .gitattributes).
+ *
+ * @param algo "sha1" (обычные репозитории) или "sha256" (object-format=sha256).
+ * @return Идентификатор в hex или пустая строка при ошибке.
+ */
+std::string git_blob_id(const std::string& filepath, const std::string& algo = "sha1");
+
+/**
+ * @brief Вычисляет идентификатор git‑объекта tree для каталога.
+ *
+ * Совпадает с `git write-tree` после `git add -A` для этого каталога:
+ * записи сортируются как в git (имя каталога сравнивается с "/" на конце),
+ * режимы 100644, 100755 (исполняемый файл), 120000 (символьная ссылка,
+ * blob от её цели) и 40000 (каталог), пустые каталоги и каталог .git
+ * пропускаются. Файлы .gitignore не учитываются.
+ *
+ * Все blob хешируются параллельно, затем деревья строятся снизу вверх,
+ * уровень за уровнем, тоже параллельно.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Идентификатор в hex или пустая строка при ошибке.
+ */
+std::string git_tree_id(const std::string& dirpath, const std::string& algo = "sha1", unsigned threads = 0);
+
+#endif
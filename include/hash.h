@@ -14,11 +14,15 @@
 bool verify_md5(const std::string& filepath, const std::string& hash);
 bool verify_sha1(const std::string& filepath, const std::string& hash);
 bool verify_sha256(const std::string& filepath, const std::string& hash);
+bool verify_sha384(const std::string& filepath, const std::string& hash);
+bool verify_sha512(const std::string& filepath, const std::string& hash);
+bool verify_sha512_256(const std::string& filepath, const std::string& hash);
 
 /**
  * @brief Вычисляет MD5‑хеш указанного файла.
  *
- * Файл читается в бинарном режиме и дополняется согласно спецификации MD5.
+ * Файл читается в бинарном режиме порциями из общего пула буферов
+ * (см. buffer_pool.h), поэтому расход памяти не зависит от размера файла.
  * При невозможности открыть файл функция возвращает пустую строку.
  *
  * @param filepath Полный или относительный путь к файлу.
@@ -46,12 +50,161 @@ std::string sha1_file(const std::string& filepath);
  */
 std::string sha256_file(const std::string& filepath);
 
+/**
+ * @brief Вычисляет SHA‑512‑хеш указанного файла.
+ *
+ * Семейство SHA‑512 работает с 64‑битными словами и 128‑байтными блоками,
+ * поэтому на 64‑битных процессорах обычно быстрее SHA‑256 на байт.
+ *
+ * @return 128‑символьная строка в нижнем регистре.
+ */
+std::string sha512_file(const std::string& filepath);
+
+/**
+ * @brief Вычисляет SHA‑384‑хеш (SHA‑512 с другим IV, усечён до 48 байт).
+ *
+ * @return 96‑символьная строка в нижнем регистре.
+ */
+std::string sha384_file(const std::string& filepath);
+
+/**
+ * @brief Вычисляет SHA‑512/256‑хеш (SHA‑512 с другим IV, усечён до 32 байт).
+ *
+ * @return 64‑символьная строка в нижнем регистре.
+ */
+std::string sha512_256_file(const std::string& filepath);
+
+/**
+ * @brief Переводит байты дайджеста в hex‑строку в нижнем регистре.
+ *
+ * @param digest Указатель на байты дайджеста.
+ * @param size   Количество байт.
+ * @return Строка длиной 2 * size.
+ */
+std::string to_hex(const uint8_t* digest, size_t size);
+
+/**
+ * @brief Состояние потокового вычисления MD5.
+ *
+ * Данные подаются порциями через md5_update(), неполный 64‑байтный блок
+ * накапливается в block. Весь файл в память не загружается.
+ */
+struct Md5Context {
+    std::array<uint32_t, 4> H;
+    uint64_t length;               ///< Всего обработано байт.
+    std::array<uint8_t, 64> block; ///< Неполный блок.
+    size_t used;                   ///< Заполнено байт в block.
+};
+
+/**
+ * @brief Состояние потокового вычисления SHA‑1.
+ */
+struct Sha1Context {
+    std::array<uint32_t, 5> H;
+    uint64_t length;
+    std::array<uint8_t, 64> block;
+    size_t used;
+};
+
+/**
+ * @brief Состояние потокового вычисления SHA‑256.
+ */
+struct Sha256Context {
+    std::array<uint32_t, 8> H;
+    uint64_t length;
+    std::array<uint8_t, 64> block;
+    size_t used;
+};
+
+/**
+ * @brief Состояние потокового вычисления SHA‑512, SHA‑384 и SHA‑512/256.
+ *
+ * Варианты отличаются только начальным значением H и длиной дайджеста.
+ */
+struct Sha512Context {
+    std::array<uint64_t, 8> H;
+    uint64_t length;
+    std::array<uint8_t, 128> block;
+    size_t used;
+};
+
+void md5_init(Md5Context& ctx);
+void md5_update(Md5Context& ctx, const uint8_t* data, size_t size);
+/**
+ * @brief Завершает вычисление MD5: дополнение и запись 16 байт дайджеста.
+ */
+void md5_final(Md5Context& ctx, uint8_t digest[16]);
+
+void sha1_init(Sha1Context& ctx);
+void sha1_update(Sha1Context& ctx, const uint8_t* data, size_t size);
+/**
+ * @brief Завершает вычисление SHA‑1 и записывает 20 байт дайджеста.
+ */
+void sha1_final(Sha1Context& ctx, uint8_t digest[20]);
+
+void sha256_init(Sha256Context& ctx);
+void sha256_update(Sha256Context& ctx, const uint8_t* data, size_t size);
+/**
+ * @brief Завершает вычисление SHA‑256 и записывает 32 байта дайджеста.
+ */
+void sha256_final(Sha256Context& ctx, uint8_t digest[32]);
+
+void sha512_init(Sha512Context& ctx);
+void sha384_init(Sha512Context& ctx);
+void sha512_256_init(Sha512Context& ctx);
+void sha512_update(Sha512Context& ctx, const uint8_t* data, size_t size);
+/**
+ * @brief Продвигает четыре независимых контекста на size байт каждый (multi‑buffer).
+ *
+ * Если все контексты на границе блока, целые блоки четырёх потоков
+ * обрабатываются вместе 4‑дорожечным ядром AVX2; остаток и невыровненные
+ * контексты — обычным sha512_update().
+ */
+void sha512_update_x4(Sha512Context* const ctx[4], const uint8_t* const data[4], size_t size);
+/**
+ * @brief Завершает вычисление SHA‑512 и записывает 64 байта дайджеста.
+ */
+void sha512_final(Sha512Context& ctx, uint8_t digest[64]);
+/**
+ * @brief Завершает вычисление SHA‑384 и записывает 48 байт дайджеста.
+ */
+void sha384_final(Sha512Context& ctx, uint8_t digest[48]);
+/**
+ * @brief Завершает вычисление SHA‑512/256 и записывает 32 байта дайджеста.
+ */
+void sha512_256_final(Sha512Context& ctx, uint8_t digest[32]);
+
 namespace md5_internal {
     extern const std::array<uint32_t, 64> K;
     extern const std::array<uint32_t, 64> S;
 
     uint32_t left_rotate(uint32_t x, uint32_t c);
     void md5_transform(std::array<uint32_t, 4>& H, const std::array<uint8_t, 64>& block);
+    void md5_transform(std::array<uint32_t, 4>& H, const uint8_t* block);
+    /// blocks блоков каждого из шестнадцати потоков; AVX‑512 при наличии, иначе по очереди.
+    void md5_transform_x16(std::array<uint32_t, 4>* const H[16], const uint8_t* const data[16], size_t blocks);
+}
+
+namespace sha1_internal {
+    void sha1_transform(std::array<uint32_t, 5>& H, const uint8_t* block);
+}
+
+namespace sha256_internal {
+    extern const std::array<uint32_t, 64> K;
+
+    void sha256_transform(std::array<uint32_t, 8>& H, const uint8_t* block);
+    /// blocks блоков подряд; AVX2 (по два блока за проход расписания) при наличии.
+    void sha256_transform_blocks(std::array<uint32_t, 8>& H, const uint8_t* data, size_t blocks);
+    /// blocks блоков каждого из шестнадцати потоков; AVX‑512 при наличии, иначе по очереди.
+    void sha256_transform_x16(std::array<uint32_t, 8>* const H[16], const uint8_t* const data[16], size_t blocks);
+}
+
+namespace sha512_internal {
+    extern const std::array<uint64_t, 80> K;
+
+    void sha512_transform(std::array<uint64_t, 8>& H, const uint8_t* block);
+    /// blocks блоков каждого из четырёх потоков; AVX2 при наличии, иначе по очереди.
+    void sha512_transform_x4(std::array<uint64_t, 8>* const H[4], const uint8_t* const data[4], size_t blocks);
 }
 
 #endif
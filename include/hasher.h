@@ -0,0 +1,187 @@
+#ifndef HASHER_H
+#define HASHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class RandomAccessFile;
+
+/**
+ * @brief Потоковый хешер с общим интерфейсом для всех алгоритмов.
+ *
+ * Позволяет режимам, которые не зависят от конкретного алгоритма
+ * (инкрементальное хеширование, диапазоны и т.п.), работать с любым
+ * алгоритмом по его имени.
+ */
+class Hasher {
+public:
+    virtual ~Hasher() = default;
+
+    /// Добавляет очередную порцию данных.
+    virtual void update(const uint8_t* data, size_t size) = 0;
+
+    /// Возвращает хешер в начальное состояние, как после make_hasher().
+    virtual void reset() = 0;
+
+    /**
+     * @brief Завершает вычисление.
+     * @return Дайджест в бинарном виде (digest_size() байт).
+     */
+    virtual std::string digest() = 0;
+
+    /// Размер дайджеста в байтах.
+    virtual size_t digest_size() const = 0;
+
+    /// Размер блока сжатия в байтах.
+    virtual size_t block_size() const = 0;
+
+    /// Имя алгоритма, под которым он создаётся make_hasher().
+    virtual std::string name() const = 0;
+
+    /**
+     * @brief Стойкий ли алгоритм к намеренно подобранным коллизиям.
+     *
+     * false у быстрых некриптографических хешей (XXH3): они годятся для
+     * обнаружения изменений, но не для защиты от подмены данных.
+     */
+    virtual bool cryptographic() const;
+
+    /**
+     * @brief Возвращает промежуточное состояние Merkle–Damgård (midstate).
+     *
+     * Доступно только на границе блока, то есть когда обработано
+     * кратное block_size() число байт.
+     *
+     * @param state  Цепочечные значения H.
+     * @param length Число обработанных байт.
+     * @return false, если алгоритм не поддерживает midstate или
+     *         состояние не на границе блока.
+     */
+    virtual bool export_midstate(std::vector<uint32_t>& state, uint64_t& length) const;
+
+    /**
+     * @brief Восстанавливает состояние, сохранённое export_midstate().
+     * @return false, если состояние не подходит для этого алгоритма.
+     */
+    virtual bool import_midstate(const std::vector<uint32_t>& state, uint64_t length);
+
+    /**
+     * @brief Сериализует полное состояние в компактный бинарный блоб.
+     *
+     * В отличие от midstate сохраняется и неполный блок, поэтому снимок
+     * можно сделать в любой момент. Формат:
+     * "HS", версия (1 байт), длина имени (1 байт), имя алгоритма,
+     * затем тело, специфичное для алгоритма (все числа little endian).
+     *
+     * @return Пустая строка, если алгоритм не поддерживает сериализацию.
+     */
+    std::string save_state() const;
+
+    /**
+     * @brief Восстанавливает состояние из блоба save_state().
+     * @return false, если блоб повреждён, другой версии или другого алгоритма.
+     */
+    bool load_state(const std::string& blob);
+
+    /// Текущая версия формата save_state().
+    static constexpr uint8_t STATE_VERSION = 1;
+
+protected:
+    /// Дописывает тело состояния в out; false — сериализация не поддерживается.
+    virtual bool save_body(std::string& out) const;
+    /// Читает тело состояния; false — данные некорректны.
+    virtual bool load_body(const uint8_t* data, size_t size);
+};
+
+/**
+ * @brief Создаёт хешер по имени алгоритма.
+ *
+ * @param algo "md5", "sha1", "sha256", "sha384", "sha512", "sha512_256",
+ *             "blake2b", "blake2s", "blake3", "sha3_224", "sha3_256", "sha3_384",
+ *             "sha3_512", "shake128" (32 байта), "shake256" (64 байта), "k12",
+ *             а также некриптографические "xxh3", "xxh128", "crc32" и "crc32c".
+ * @return nullptr для неизвестного алгоритма.
+ */
+std::unique_ptr<Hasher> make_hasher(const std::string& algo);
+
+/**
+ * @brief Вычисляет хеш файла указанным алгоритмом.
+ *
+ * @return Хеш в hex или пустая строка при ошибке чтения либо неизвестном алгоритме.
+ */
+std::string hash_file(const std::string& algo, const std::string& filepath);
+
+/**
+ * @brief Вычисляет хеши набора файлов.
+ *
+ * Алгоритмы Merkle–Damgård идут через MdEngine::files(): если у алгоритма
+ * есть многодорожечное ядро, выгодное на этом процессоре (MD5 и SHA‑256 —
+ * шестнадцать дорожек на AVX‑512, семейство SHA‑512 — четыре на AVX2),
+ * каждая дорожка ведёт свой файл и сразу получает следующий, когда её
+ * файл кончился, так что порядок и размеры файлов не важны. Остальные
+ * алгоритмы хешируют файлы по одному, распределяя их по потокам.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Хеши в hex по порядку paths; пустая строка — ошибка чтения.
+ */
+std::vector<std::string> hash_files(const std::string& algo, const std::vector<std::string>& paths,
+                                    unsigned threads = 0);
+
+/**
+ * @brief Диапазон байт файла [offset, offset + length).
+ */
+struct ByteRange {
+    uint64_t offset;
+    uint64_t length;
+};
+
+/**
+ * @brief Вычисляет дайджест диапазона уже открытого файла.
+ *
+ * Читает через RandomAccessFile::read_range(), поэтому безопасна для
+ * одновременного вызова из нескольких потоков на одном файле.
+ *
+ * @param digest Бинарный дайджест (см. Hasher::digest()).
+ * @return false при ошибке чтения, выходе за конец файла или неизвестном алгоритме.
+ */
+bool digest_range(const std::string& algo, const RandomAccessFile& file,
+                  uint64_t offset, uint64_t length, std::string& digest);
+
+/**
+ * @brief Вычисляет дайджесты последовательных частей файла параллельно.
+ *
+ * Файл делится на части по chunk_size байт (последняя может быть короче);
+ * у пустого файла одна пустая часть.
+ *
+ * @param digests Бинарные дайджесты частей по порядку.
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return false при ошибке чтения или неизвестном алгоритме.
+ */
+bool digest_chunks(const std::string& algo, const RandomAccessFile& file, uint64_t chunk_size,
+                   std::vector<std::string>& digests, unsigned threads = 0);
+
+/**
+ * @brief Вычисляет хеш байтов [offset, offset + length) файла.
+ *
+ * @return Хеш в hex или пустая строка, если диапазон выходит за конец файла
+ *         либо файл не удалось прочитать.
+ */
+std::string hash_file_range(const std::string& algo, const std::string& filepath,
+                            uint64_t offset, uint64_t length);
+
+/**
+ * @brief Хеширует несколько диапазонов одного файла параллельно.
+ *
+ * Файл открывается один раз, диапазоны читаются позиционно (pread)
+ * из разных потоков без копирования файла.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Хеши в hex в порядке ranges; пустая строка для неудачного диапазона.
+ */
+std::vector<std::string> hash_file_ranges(const std::string& algo, const std::string& filepath,
+                                          const std::vector<ByteRange>& ranges, unsigned threads = 0);
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef KECCAK_H
+#define KECCAK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Губка на перестановке Keccak‑p[1600] (SHA‑3, SHAKE, TurboSHAKE).
+ *
+ * Данные копятся в block до полного блока длины rate и добавляются к
+ * состоянию через XOR, после чего выполняется перестановка. Число раундов —
+ * 24 для SHA‑3/SHAKE и 12 для KangarooTwelve.
+ */
+struct KeccakContext {
+    std::array<uint64_t, 25> a;
+    std::array<uint8_t, 168> block;     ///< 168 — наибольший rate (SHAKE128).
+    size_t rate;                        ///< Байт на блок.
+    size_t used;
+    size_t out_len;                     ///< Длина результата keccak_final().
+    unsigned rounds;
+    uint8_t suffix;                     ///< Доменные биты вместе с первым битом дополнения.
+};
+
+/**
+ * @brief Начинает вычисление SHA3‑224/256/384/512.
+ * @return false, если bits не из {224, 256, 384, 512}.
+ */
+bool sha3_init(KeccakContext& ctx, size_t bits);
+
+/**
+ * @brief Начинает вычисление SHAKE128 или SHAKE256 (XOF).
+ *
+ * @param bits    128 или 256.
+ * @param out_len Сколько байт выдаст keccak_final(); 1 и больше.
+ * @return false при недопустимых параметрах.
+ */
+bool shake_init(KeccakContext& ctx, size_t bits, size_t out_len);
+
+void keccak_update(KeccakContext& ctx, const uint8_t* data, size_t size);
+
+/**
+ * @brief Завершает вычисление и записывает ctx.out_len байт.
+ */
+void keccak_final(KeccakContext& ctx, uint8_t* out);
+
+/// Длина куска KangarooTwelve.
+constexpr size_t K12_CHUNK_LEN = 8192;
+
+/**
+ * @brief Потоковый контекст KangarooTwelve (без строки персонализации).
+ *
+ * Первые 8 КиБ поглощаются финальным узлом; следующие куски хешируются
+ * как листья TurboSHAKE128 (по четыре сразу, если есть AVX2), и их
+ * 32‑байтные CV поглощаются финальным узлом.
+ */
+struct K12Context {
+    KeccakContext node;
+    std::array<uint8_t, 4 * K12_CHUNK_LEN> pending;     ///< Неполная группа листьев.
+    size_t pending_len;
+    uint64_t total;                     ///< Байт сообщения.
+    uint64_t leaves;                    ///< Листьев, поглощённых узлом.
+    bool tree;                          ///< Заголовок дерева уже поглощён.
+};
+
+void k12_init(K12Context& ctx);
+void k12_update(K12Context& ctx, const uint8_t* data, size_t size);
+
+/**
+ * @brief Завершает KangarooTwelve и выдаёт size байт (XOF; обычно 32).
+ */
+void k12_final(K12Context& ctx, uint8_t* out, size_t size = 32);
+
+/// Вычисляет SHA3‑224 файла; hex или пустая строка при ошибке чтения.
+std::string sha3_224_file(const std::string& filepath);
+
+/// Вычисляет SHA3‑256 файла; hex или пустая строка при ошибке чтения.
+std::string sha3_256_file(const std::string& filepath);
+
+/// Вычисляет SHA3‑384 файла; hex или пустая строка при ошибке чтения.
+std::string sha3_384_file(const std::string& filepath);
+
+/// Вычисляет SHA3‑512 файла; hex или пустая строка при ошибке чтения.
+std::string sha3_512_file(const std::string& filepath);
+
+/**
+ * @brief Вычисляет SHAKE128 файла.
+ *
+ * @param out_len Длина результата; по умолчанию 32 байта (128 бит стойкости
+ *                к коллизиям — предел SHAKE128).
+ * @return Хеш в hex или пустая строка при ошибке чтения.
+ */
+std::string shake128_file(const std::string& filepath, size_t out_len = 32);
+
+/**
+ * @brief Вычисляет SHAKE256 файла (по умолчанию 64 байта).
+ */
+std::string shake256_file(const std::string& filepath, size_t out_len = 64);
+
+/**
+ * @brief Вычисляет KangarooTwelve файла.
+ *
+ * Первый кусок и хвост читаются потоково, а полные листья между ними —
+ * сегментами размером с буфер пула параллельно; CV сводятся по порядку.
+ *
+ * @param out_len Длина результата в байтах.
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Хеш в hex или пустая строка при ошибке чтения.
+ */
+std::string k12_file(const std::string& filepath, size_t out_len = 32, unsigned threads = 0);
+
+#endif
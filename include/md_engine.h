@@ -0,0 +1,404 @@
+#ifndef MD_ENGINE_H
+#define MD_ENGINE_H
+
+#include "hash.h"
+#include "file_io.h"
+#include "byte_order.h"
+#include "buffer_pool.h"
+#include "parallel.h"
+#include "cpu_features.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Конструкция Merkle–Damgård, собранная из политики сжатия.
+ *
+ * Политика описывает алгоритм целиком на этапе компиляции:
+ *  - Context — структура с полями H, length, block и used (Md5Context и т. п.);
+ *    размер блока и ширина слов состояния берутся из её полей;
+ *  - IV — начальное значение H, DIGEST — длина дайджеста в байтах
+ *    (меньше размера H для усечённых вариантов);
+ *  - BIG_ENDIAN_ORDER — порядок байт длины в дополнении и слов дайджеста;
+ *  - compress(H, data, blocks) — сжатие blocks блоков подряд;
+ *  - LANES и compress_lanes(H, data, blocks) — ядро, сжимающее сразу LANES
+ *    независимых потоков (multi‑buffer), и lanes_fast() — выгодно ли оно на
+ *    этом процессоре. При LANES == 0 многодорожечные функции не используются.
+ *
+ * Все функции статические и вызывают политику напрямую, поэтому обёртки
+ * md5_update() и т. п. компилируются в тот же код, что и написанные вручную.
+ */
+template <typename Policy>
+struct MdEngine {
+    using Context = typename Policy::Context;
+    using State = decltype(Context::H);
+    using Word = typename State::value_type;
+
+    static constexpr size_t BLOCK = std::tuple_size<decltype(Context::block)>::value;
+    static constexpr size_t DIGEST = Policy::DIGEST;
+    static constexpr size_t LANES = Policy::LANES;
+
+    /// Меньше стольких занятых дорожек при пустой очереди широкое ядро медленнее потокового.
+    static constexpr size_t MIN_ACTIVE_LANES = 2;
+
+    static void init(Context& ctx) {
+        ctx.H = Policy::IV;
+        ctx.length = 0;
+        ctx.used = 0;
+    }
+
+    /**
+     * @brief Добавляет данные: неполный блок копится в ctx.block, целые
+     *        блоки из data сжимаются одним вызовом compress без копирования.
+     */
+    static void update(Context& ctx, const uint8_t* data, size_t size) {
+        ctx.length += size;
+        if (ctx.used) {
+            size_t take = std::min(size, BLOCK - ctx.used);
+            std::copy(data, data + take, ctx.block.begin() + ctx.used);
+            ctx.used += take; data += take; size -= take;
+            if (ctx.used < BLOCK) return;
+            Policy::compress(ctx.H, ctx.block.data(), 1);
+            ctx.used = 0;
+        }
+        const size_t blocks = size / BLOCK;
+        if (blocks) Policy::compress(ctx.H, data, blocks);
+        data += blocks * BLOCK;
+        size -= blocks * BLOCK;
+        std::copy(data, data + size, ctx.block.begin());
+        ctx.used = size;
+    }
+
+    /**
+     * @brief Дополнение 0x80 || 0x00... || длина в битах и запись DIGEST байт.
+     *
+     * Поле длины занимает 1/8 блока: 8 байт для 64‑байтных блоков,
+     * 16 байт (128‑битная длина) для 128‑байтных блоков SHA‑512.
+     */
+    static void final(Context& ctx, uint8_t* digest) {
+        constexpr size_t field = BLOCK / 8;
+        ctx.block[ctx.used++] = 0x80;
+        if (ctx.used > BLOCK - field) {
+            std::fill(ctx.block.begin() + ctx.used, ctx.block.end(), 0);
+            Policy::compress(ctx.H, ctx.block.data(), 1);
+            ctx.used = 0;
+        }
+        std::fill(ctx.block.begin() + ctx.used, ctx.block.begin() + (BLOCK - 8), 0);
+        uint8_t* length = ctx.block.data() + BLOCK - 8;
+        if constexpr (Policy::BIG_ENDIAN_ORDER) {
+            if constexpr (field == 16) store_be64(length - 8, ctx.length >> 61);
+            store_be64(length, ctx.length * 8);
+        } else {
+            store_le64(length, ctx.length * 8);
+        }
+        Policy::compress(ctx.H, ctx.block.data(), 1);
+        ctx.used = 0;
+
+        uint8_t full[sizeof(State)];
+        for (size_t j = 0; j < ctx.H.size(); ++j) {
+            if constexpr (sizeof(Word) == 8) {
+                if constexpr (Policy::BIG_ENDIAN_ORDER) store_be64(full + 8*j, ctx.H[j]);
+                else store_le64(full + 8*j, ctx.H[j]);
+            } else {
+                if constexpr (Policy::BIG_ENDIAN_ORDER) store_be32(full + 4*j, ctx.H[j]);
+                else store_le32(full + 4*j, ctx.H[j]);
+            }
+        }
+        std::copy(full, full + DIGEST, digest);
+    }
+
+    /// Дайджест буфера целиком.
+    static void digest(const uint8_t* data, size_t size, uint8_t* out) {
+        Context ctx;
+        init(ctx);
+        update(ctx, data, size);
+        final(ctx, out);
+    }
+
+    /// Хеш файла в hex или пустая строка при ошибке чтения.
+    static std::string file(const std::string& filepath) {
+        Context ctx;
+        init(ctx);
+        if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { update(ctx, data, size); }))
+            return "";
+        uint8_t out[DIGEST];
+        final(ctx, out);
+        return to_hex(out, DIGEST);
+    }
+
+    /**
+     * @brief Дайджест байтов [offset, offset + length) открытого файла.
+     * @return false при ошибке чтения или выходе за конец файла.
+     */
+    static bool range(const RandomAccessFile& file, uint64_t offset, uint64_t length, uint8_t* out) {
+        Context ctx;
+        init(ctx);
+        if (!file.read_range(offset, length, [&](const uint8_t* data, size_t size) { update(ctx, data, size); }))
+            return false;
+        final(ctx, out);
+        return true;
+    }
+
+    /**
+     * @brief Продвигает LANES независимых контекстов на size байт каждый.
+     *
+     * Если все контексты на границе блока, целые блоки идут в
+     * compress_lanes; остаток и невыровненные контексты — в update().
+     *
+     * @param ctx  LANES указателей на контексты.
+     * @param data LANES указателей на данные по size байт.
+     */
+    static void update_lanes(Context* const* ctx, const uint8_t* const* data, size_t size) {
+        bool aligned = true;
+        for (size_t l = 0; l < LANES; ++l) aligned = aligned && ctx[l]->used == 0;
+        size_t done = 0;
+        if (aligned && size >= BLOCK) {
+            State* H[LANES];
+            for (size_t l = 0; l < LANES; ++l) H[l] = &ctx[l]->H;
+            Policy::compress_lanes(H, data, size / BLOCK);
+            done = size / BLOCK * BLOCK;
+            for (size_t l = 0; l < LANES; ++l) ctx[l]->length += done;
+        }
+        for (size_t l = 0; l < LANES; ++l) update(*ctx[l], data[l] + done, size - done);
+    }
+
+    /**
+     * @brief Хеши набора файлов в hex по порядку paths (пустая строка —
+     *        ошибка чтения).
+     *
+     * Если у политики есть выгодное на этом процессоре многодорожечное ядро,
+     * каждый поток ведёт свой планировщик дорожек (см. hash_lanes()), иначе
+     * файлы хешируются по одному и распределяются по потокам.
+     *
+     * @param threads Число потоков; 0 — по числу ядер.
+     */
+    static std::vector<std::string> files(const std::vector<std::string>& paths, unsigned threads) {
+        std::vector<std::string> result(paths.size());
+        if constexpr (LANES > 0) {
+            if (Policy::lanes_fast()) {
+                const size_t schedulers = std::max<size_t>(1, std::min<size_t>(threads ? threads : worker_count(),
+                                                                                (paths.size() + LANES - 1) / LANES));
+                parallel_for(schedulers, [&](size_t s) {
+                    std::vector<size_t> queue;
+                    for (size_t i = s; i < paths.size(); i += schedulers) queue.push_back(i);
+                    hash_lanes(paths, queue, result);
+                }, threads);
+                return result;
+            }
+        }
+        parallel_for(paths.size(), [&](size_t i) { result[i] = file(paths[i]); }, threads);
+        return result;
+    }
+
+private:
+    /**
+     * @brief Планировщик LANES дорожек: каждая дорожка ведёт свой файл,
+     *        а освободившаяся сразу получает следующий из очереди.
+     *
+     * На каждом шаге все занятые дорожки читают одинаковое число целых
+     * блоков (не больше своей доли буфера пула и остатка самого короткого
+     * файла) и сжимаются одним вызовом compress_lanes. Файл, в котором
+     * не осталось целых блоков, дочитывается и завершается скалярно, и его
+     * дорожка тут же занимается, поэтому файлы разной длины не оставляют
+     * дорожки пустыми. Когда очередь кончилась и занятых дорожек стало
+     * меньше MIN_ACTIVE_LANES, широкое ядро уже невыгодно и оставшиеся
+     * файлы дохешируются потоково.
+     *
+     * Хвосты и дохеширование читаются через тот же буфер пула, что и
+     * дорожки: второй буфер при уже взятом привёл бы к взаимной блокировке
+     * при лимите памяти в один буфер.
+     */
+    static void hash_lanes(const std::vector<std::string>& paths, const std::vector<size_t>& queue,
+                           std::vector<std::string>& result) {
+        struct Lane {
+            std::unique_ptr<RandomAccessFile> file;
+            Context ctx;
+            size_t index = 0;
+            uint64_t pos = 0;
+            uint64_t blocks = 0;        ///< Целых блоков осталось.
+            bool active = false;
+        };
+        Lane lanes[LANES];
+        size_t next = 0;
+
+        // Единственный буфер планировщика: при сжатии он поделён на LANES
+        // долей, между сжатиями целиком служит finish().
+        buffer_pool::Buffer buffer = buffer_pool::acquire();
+        const size_t slice = buffer.size() / LANES / BLOCK * BLOCK;
+
+        // Вызывается только между сжатиями, когда весь буфер свободен.
+        auto finish = [&](Lane& lane) {
+            lane.active = false;
+            const uint64_t size = lane.file->size();
+            while (lane.pos < size) {
+                const size_t n = static_cast<size_t>(std::min<uint64_t>(buffer.size(), size - lane.pos));
+                if (lane.file->read_at(lane.pos, buffer.data(), n) != static_cast<int64_t>(n)) return;
+                update(lane.ctx, buffer.data(), n);
+                lane.pos += n;
+            }
+            uint8_t out[DIGEST];
+            final(lane.ctx, out);
+            result[lane.index] = to_hex(out, DIGEST);
+        };
+        auto refill = [&](Lane& lane) {
+            lane.active = false;
+            while (next < queue.size()) {
+                lane.index = queue[next++];
+                lane.file = std::make_unique<RandomAccessFile>(paths[lane.index]);
+                if (!lane.file->is_open()) continue;
+                init(lane.ctx);
+                lane.pos = 0;
+                lane.blocks = lane.file->size() / BLOCK;
+                lane.active = true;
+                if (lane.blocks > 0) return;
+                finish(lane);
+            }
+        };
+        for (Lane& lane : lanes) refill(lane);
+
+        State idle_state{};
+        while (true) {
+            size_t active = 0;
+            uint64_t step = slice / BLOCK;
+            for (const Lane& lane : lanes) {
+                if (!lane.active) continue;
+                ++active;
+                step = std::min(step, lane.blocks);
+            }
+            if (active == 0) break;
+            if (next == queue.size() && active < MIN_ACTIVE_LANES) {
+                for (Lane& lane : lanes)
+                    if (lane.active) finish(lane);
+                break;
+            }
+
+            State* H[LANES];
+            const uint8_t* data[LANES];
+            bool read = true;
+            for (size_t l = 0; l < LANES; ++l) {
+                Lane& lane = lanes[l];
+                uint8_t* slot = buffer.data() + l * slice;
+                data[l] = slot;
+                H[l] = lane.active ? &lane.ctx.H : &idle_state;
+                const size_t bytes = static_cast<size_t>(step * BLOCK);
+                if (lane.active && lane.file->read_at(lane.pos, slot, bytes) != static_cast<int64_t>(bytes)) {
+                    refill(lane);       // ошибка чтения: хеш остаётся пустым
+                    read = false;
+                }
+            }
+            if (!read) continue;
+
+            Policy::compress_lanes(H, data, static_cast<size_t>(step));
+            for (Lane& lane : lanes) {
+                if (!lane.active) continue;
+                lane.pos += step * BLOCK;
+                lane.ctx.length += step * BLOCK;
+                lane.blocks -= step;
+                if (lane.blocks == 0) {
+                    finish(lane);
+                    refill(lane);
+                }
+            }
+        }
+    }
+};
+
+/// MD5: 64‑байтные блоки, длина и слова дайджеста в little endian; 16 дорожек на AVX‑512.
+struct Md5Policy {
+    using Context = Md5Context;
+    static constexpr std::array<uint32_t, 4> IV = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+    static constexpr size_t DIGEST = 16;
+    static constexpr bool BIG_ENDIAN_ORDER = false;
+    static constexpr size_t LANES = 16;
+
+    static void compress(std::array<uint32_t, 4>& H, const uint8_t* data, size_t blocks) {
+        for (size_t i = 0; i < blocks; ++i) md5_internal::md5_transform(H, data + 64 * i);
+    }
+    static void compress_lanes(std::array<uint32_t, 4>* const H[16], const uint8_t* const data[16], size_t blocks) {
+        md5_internal::md5_transform_x16(H, data, blocks);
+    }
+    static bool lanes_fast() { return cpu_has_avx512f(); }
+};
+
+/// SHA‑1: многодорожечного ядра нет.
+struct Sha1Policy {
+    using Context = Sha1Context;
+    static constexpr std::array<uint32_t, 5> IV = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    static constexpr size_t DIGEST = 20;
+    static constexpr bool BIG_ENDIAN_ORDER = true;
+    static constexpr size_t LANES = 0;
+
+    static void compress(std::array<uint32_t, 5>& H, const uint8_t* data, size_t blocks) {
+        for (size_t i = 0; i < blocks; ++i) sha1_internal::sha1_transform(H, data + 64 * i);
+    }
+};
+
+/// SHA‑256: поток блоков на AVX2, 16 дорожек на AVX‑512.
+struct Sha256Policy {
+    using Context = Sha256Context;
+    static constexpr std::array<uint32_t, 8> IV = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    static constexpr size_t DIGEST = 32;
+    static constexpr bool BIG_ENDIAN_ORDER = true;
+    static constexpr size_t LANES = 16;
+
+    static void compress(std::array<uint32_t, 8>& H, const uint8_t* data, size_t blocks) {
+        sha256_internal::sha256_transform_blocks(H, data, blocks);
+    }
+    static void compress_lanes(std::array<uint32_t, 8>* const H[16], const uint8_t* const data[16], size_t blocks) {
+        sha256_internal::sha256_transform_x16(H, data, blocks);
+    }
+    static bool lanes_fast() { return cpu_has_avx512f(); }
+};
+
+/// SHA‑512: 128‑байтные блоки, 4 дорожки на AVX2. SHA‑384 и SHA‑512/256 отличаются IV и DIGEST.
+struct Sha512Policy {
+    using Context = Sha512Context;
+    static constexpr std::array<uint64_t, 8> IV = {
+        0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+        0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull
+    };
+    static constexpr size_t DIGEST = 64;
+    static constexpr bool BIG_ENDIAN_ORDER = true;
+    static constexpr size_t LANES = 4;
+
+    static void compress(std::array<uint64_t, 8>& H, const uint8_t* data, size_t blocks) {
+        for (size_t i = 0; i < blocks; ++i) sha512_internal::sha512_transform(H, data + 128 * i);
+    }
+    static void compress_lanes(std::array<uint64_t, 8>* const H[4], const uint8_t* const data[4], size_t blocks) {
+        sha512_internal::sha512_transform_x4(H, data, blocks);
+    }
+    static bool lanes_fast() { return cpu_has_avx2(); }
+};
+
+struct Sha384Policy : Sha512Policy {
+    static constexpr std::array<uint64_t, 8> IV = {
+        0xcbbb9d5dc1059ed8ull, 0x629a292a367cd507ull, 0x9159015a3070dd17ull, 0x152fecd8f70e5939ull,
+        0x67332667ffc00b31ull, 0x8eb44a8768581511ull, 0xdb0c2e0d64f98fa7ull, 0x47b5481dbefa4fa4ull
+    };
+    static constexpr size_t DIGEST = 48;
+};
+
+struct Sha512_256Policy : Sha512Policy {
+    static constexpr std::array<uint64_t, 8> IV = {
+        0x22312194fc2bf72cull, 0x9f555fa3c84c64c2ull, 0x2393b86b6f53b151ull, 0x963877195940eabdull,
+        0x96283ee2a88effe3ull, 0xbe5e1e2553863992ull, 0x2b0199fc2c85b8aaull, 0x0eb72ddc81c52ca2ull
+    };
+    static constexpr size_t DIGEST = 32;
+};
+
+using Md5Engine = MdEngine<Md5Policy>;
+using Sha1Engine = MdEngine<Sha1Policy>;
+using Sha256Engine = MdEngine<Sha256Policy>;
+using Sha512Engine = MdEngine<Sha512Policy>;
+using Sha384Engine = MdEngine<Sha384Policy>;
+using Sha512_256Engine = MdEngine<Sha512_256Policy>;
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef MERKLE_H
+#define MERKLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Размер листа дерева по умолчанию.
+constexpr uint64_t MERKLE_DEFAULT_LEAF_SIZE = 4ull << 20;
+
+/**
+ * @brief Путь к индексу по умолчанию: "<filepath>.merkle".
+ */
+std::string merkle_path(const std::string& filepath);
+
+/**
+ * @brief Строит дерево Меркла SHA‑256 над листами фиксированного размера
+ *        и сохраняет его в файл‑спутник.
+ *
+ * Лист — SHA‑256(0x00 || данные листа), внутренний узел —
+ * SHA‑256(0x01 || левый || правый); непарный последний узел уровня
+ * переносится на следующий уровень без изменений. Пустой файл — один
+ * пустой лист. Листья хешируются параллельно.
+ *
+ * Формат индекса (little endian): "HMRK", версия (1 байт), 3 байта
+ * нулей, размер листа (8), размер файла (8), число листьев (8), затем
+ * узлы всех уровней от листьев к корню по 32 байта. Положение любого
+ * узла вычисляется по заголовку, поэтому проверка читает только нужные узлы.
+ *
+ * @param filepath  Путь к файлу.
+ * @param index     Путь к индексу; пустой — merkle_path().
+ * @param leaf_size Размер листа в байтах (> 0).
+ * @param root      Корень дерева в hex.
+ * @param threads   Число потоков; 0 — по числу ядер.
+ * @return false при ошибке чтения файла или записи индекса; прежний
+ *         индекс при этом не портится.
+ */
+bool merkle_build(const std::string& filepath, const std::string& index, uint64_t leaf_size,
+                  std::string& root, unsigned threads = 0);
+
+/**
+ * @brief Проверяет диапазон байт файла по сохранённому индексу.
+ *
+ * Хешируются только листья, пересекающиеся с [offset, offset + length);
+ * для каждого из них корень пересчитывается по O(log n) соседним узлам
+ * из индекса и сравнивается с сохранённым корнем. Пустой диапазон
+ * (length == 0) не задевает листьев и проверку проходит всегда.
+ *
+ * @param bad_leaves Номера листьев, не прошедших проверку.
+ * @return false, если индекс или файл не читаются, не соответствуют друг
+ *         другу по размеру или диапазон выходит за конец файла.
+ */
+bool merkle_verify_range(const std::string& filepath, const std::string& index,
+                         uint64_t offset, uint64_t length, std::vector<uint64_t>& bad_leaves);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef MIDSTATE_H
+#define MIDSTATE_H
+
+#include <cstdint>
+#include <string>
+
+/// Сколько байт в конце сохранённого префикса сверяется при tail‑проверке.
+constexpr uint64_t MIDSTATE_TAIL_SIZE = 4096;
+
+/**
+ * @brief Результат инкрементального хеширования.
+ */
+struct IncrementalResult {
+    std::string hash;     ///< Хеш в hex; пустая строка при ошибке.
+    uint64_t reused = 0;  ///< Байт префикса, взятых из сохранённого midstate.
+    uint64_t hashed = 0;  ///< Байт, прочитанных с диска в этот раз.
+};
+
+/**
+ * @brief Путь к файлу‑спутнику с midstate: "<filepath>.<algo>.midstate".
+ */
+std::string midstate_path(const std::string& filepath, const std::string& algo);
+
+/**
+ * @brief Хеширует дописываемый файл, продолжая с сохранённого midstate.
+ *
+ * После каждого запуска рядом с файлом сохраняется состояние H и длина
+ * после последнего целого блока. При следующем запуске, если префикс
+ * не изменился, читаются только дописанные байты, поэтому стоимость
+ * повторного хеширования пропорциональна приросту файла.
+ *
+ * Префикс считается неизменным, если файл не уменьшился, его mtime не
+ * стал старше сохранённого (при том же размере mtime должен совпадать),
+ * и — при tail_check — последние MIDSTATE_TAIL_SIZE байт префикса имеют
+ * тот же SHA‑256, что и при сохранении. Иначе файл хешируется целиком.
+ *
+ * @param algo       Имя алгоритма (см. make_hasher()).
+ * @param filepath   Путь к файлу.
+ * @param tail_check Сверять ли хвост сохранённого префикса.
+ */
+IncrementalResult hash_file_incremental(const std::string& algo, const std::string& filepath, bool tail_check = true);
+
+#endif
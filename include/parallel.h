@@ -0,0 +1,60 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Число рабочих потоков по умолчанию (по числу ядер, не меньше 1).
+ */
+unsigned worker_count();
+
+/**
+ * @brief Выполняет body(i) для всех i из [0, count) на нескольких потоках.
+ *
+ * Индексы раздаются потокам по одному через атомарный счётчик, поэтому
+ * задачи разной длительности распределяются равномерно. Функция
+ * возвращается, когда все задачи выполнены.
+ *
+ * @param count   Число задач.
+ * @param body    Тело задачи; вызывается конкурентно из разных потоков.
+ * @param threads Число потоков; 0 — worker_count().
+ */
+void parallel_for(size_t count, const std::function<void(size_t)>& body, unsigned threads = 0);
+
+/**
+ * @brief Исполнитель, выполняющий задачи строго по порядку на своём потоке.
+ *
+ * Нужен для конвейеров, где данные одного потока (например, последовательные
+ * порции окна) должны обрабатываться по порядку, а разные потоки — параллельно.
+ * Деструктор дожидается выполнения всех поставленных задач.
+ */
+class SerialExecutor {
+public:
+    SerialExecutor();
+    ~SerialExecutor();
+    SerialExecutor(const SerialExecutor&) = delete;
+    SerialExecutor& operator=(const SerialExecutor&) = delete;
+
+    /// Ставит задачу в очередь.
+    void submit(std::function<void()> task);
+
+    /// Ждёт, пока очередь опустеет и текущая задача завершится.
+    void wait();
+
+private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::function<void()>> tasks_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+#endif
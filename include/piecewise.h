@@ -0,0 +1,58 @@
+#ifndef PIECEWISE_H
+#define PIECEWISE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Результат поблочного (piecewise) хеширования.
+ */
+struct PiecewiseResult {
+    std::string algo;
+    uint64_t size = 0;                ///< Размер файла.
+    uint64_t window_size = 0;         ///< Размер окна.
+    std::string hash;                 ///< Хеш всего файла (hex); пусто при ошибке.
+    std::vector<std::string> windows; ///< Хеши окон (hex) по порядку.
+};
+
+/**
+ * @brief Вычисляет хеш каждого окна фиксированного размера и всего файла.
+ *
+ * Как hashwindow в dcfldd: файл читается один раз, каждая порция идёт
+ * и в хеш всего файла, и в хеш своего окна. Окна хешируются параллельно
+ * на нескольких потоках, хеш всего файла — на отдельном потоке; память
+ * ограничена пулом буферов.
+ *
+ * @param algo        Имя алгоритма (см. make_hasher()).
+ * @param filepath    Путь к файлу.
+ * @param window_size Размер окна в байтах (> 0).
+ * @param threads     Потоков для окон; 0 — по числу ядер.
+ */
+PiecewiseResult piecewise_hash(const std::string& algo, const std::string& filepath,
+                               uint64_t window_size, unsigned threads = 0);
+
+/**
+ * @brief Записывает таблицу окон в текстовом виде.
+ *
+ * @code
+ * # piecewise sha256 window=1048576 size=3000000
+ * 0 - 1048576: <hash>
+ * 1048576 - 2097152: <hash>
+ * 2097152 - 3000000: <hash>
+ * total: <hash>
+ * @endcode
+ */
+bool write_window_table(const std::string& path, const PiecewiseResult& result);
+
+/**
+ * @brief Читает таблицу, записанную write_window_table().
+ */
+bool read_window_table(const std::string& path, PiecewiseResult& result);
+
+/**
+ * @brief Номера окон, хеши которых различаются (или есть только в одной таблице).
+ */
+std::vector<size_t> changed_windows(const PiecewiseResult& expected, const PiecewiseResult& actual);
+
+#endif
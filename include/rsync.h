@@ -0,0 +1,100 @@
+#ifndef RSYNC_H
+#define RSYNC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Размер блока сигнатуры по умолчанию.
+constexpr uint64_t RSYNC_DEFAULT_BLOCK_SIZE = 2048;
+
+/**
+ * @brief Сигнатура файла в стиле rsync: слабая и сильная сумма каждого блока.
+ */
+struct RsyncSignature {
+    std::string algo;                 ///< Алгоритм сильной суммы (см. make_hasher()).
+    uint64_t block_size = 0;
+    uint64_t file_size = 0;
+    std::vector<uint32_t> weak;       ///< Слабые суммы блоков.
+    std::vector<std::string> strong;  ///< Сильные суммы блоков (бинарные).
+};
+
+/// Операция дельты: копия блоков старого файла или литерал из нового.
+struct DeltaOp {
+    static constexpr uint64_t LITERAL = ~0ull;
+
+    uint64_t block = LITERAL;  ///< Первый блок старого файла; LITERAL — данные нового файла.
+    uint64_t offset = 0;       ///< Смещение в новом файле.
+    uint64_t length = 0;
+};
+
+/// Дельта нового файла относительно сигнатуры старого.
+struct RsyncDelta {
+    std::vector<DeltaOp> ops;      ///< Соседние копии подряд идущих блоков и литералы слиты.
+    uint64_t matched_bytes = 0;
+    uint64_t literal_bytes = 0;    ///< Байт, которые нужно передать.
+};
+
+/**
+ * @brief Слабая сумма rsync: a = Σxᵢ, b = Σ(n − i)·xᵢ по модулю 2¹⁶, (b << 16) | a.
+ *
+ * Для длинных данных использует AVX2, если он доступен.
+ */
+uint32_t rsync_weak(const uint8_t* data, size_t size);
+
+/**
+ * @brief Слабые суммы всех окон длины window, начинающихся в [0, count).
+ *
+ * Первое окно считается rsync_weak(), остальные — прокаткой на байт, как
+ * в rsync. data должно содержать count + window − 1 байт.
+ */
+void rsync_weak_windows(const uint8_t* data, size_t window, size_t count, uint32_t* out);
+
+/**
+ * @brief Строит сигнатуру файла; блоки обрабатываются параллельно.
+ *
+ * @param algo    Алгоритм сильной суммы: "md5" (как в rsync) или "sha256".
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return false при неверных параметрах или ошибке чтения.
+ */
+bool rsync_signature(const std::string& filepath, const std::string& algo, uint64_t block_size,
+                     RsyncSignature& signature, unsigned threads = 0);
+
+/**
+ * @brief Сохраняет сигнатуру в текстовом виде.
+ *
+ * @code
+ * # rsync-signature md5 block=2048 size=1000000
+ * <weak, 8 hex> <strong hex>
+ * ...
+ * @endcode
+ */
+bool write_signature(const std::string& path, const RsyncSignature& signature);
+
+/**
+ * @brief Читает сигнатуру, записанную write_signature().
+ */
+bool read_signature(const std::string& path, RsyncSignature& signature);
+
+/**
+ * @brief Находит блоки старого файла в новом файле.
+ *
+ * Слабая сумма скользит по новому файлу с шагом в байт; кандидаты ищутся
+ * в хеш‑таблице (с предварительным отсевом по 16‑битной метке, как в rsync)
+ * и подтверждаются сильной суммой. При нескольких кандидатах
+ * предпочитается блок, следующий за последним совпавшим. Короткий
+ * последний блок старого файла сопоставляется только с концом нового.
+ * Новый файл читается через буфер пула; только для блока длиннее буфера
+ * выделяется отдельное окно размером около блока.
+ *
+ * @return false при ошибке чтения или неверной сигнатуре.
+ */
+bool rsync_delta(const std::string& filepath, const RsyncSignature& signature, RsyncDelta& delta);
+
+/**
+ * @brief Сохраняет дельту: строки "copy <block> <offset> <length>" и
+ *        "literal <offset> <length>".
+ */
+bool write_delta(const std::string& path, const RsyncDelta& delta);
+
+#endif
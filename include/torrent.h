@@ -0,0 +1,91 @@
+#ifndef TORRENT_H
+#define TORRENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Размер блока дерева BitTorrent v2.
+constexpr uint64_t TORRENT_V2_BLOCK_SIZE = 16 << 10;
+
+/**
+ * @brief Хеши BitTorrent v2 одного файла.
+ */
+struct TorrentV2File {
+    std::string path;
+    uint64_t size = 0;
+    std::string root;               ///< pieces root (32 байта); пусто у пустого файла.
+    std::vector<std::string> layer; ///< piece layer; только у файлов больше куска.
+};
+
+/**
+ * @brief Собирает набор файлов раздачи.
+ *
+ * Для каталога — все обычные файлы рекурсивно, отсортированные по пути
+ * (как это делают клиенты при создании раздачи); для файла — он сам.
+ *
+ * @return false, если путь не существует или не читается.
+ */
+bool torrent_file_list(const std::string& path, std::vector<std::string>& files);
+
+/**
+ * @brief Хеши кусков BitTorrent v1: SHA‑1 каждого куска общего потока.
+ *
+ * Файлы идут подряд как один логический поток, поэтому кусок может
+ * захватывать конец одного файла и начало следующего. Куски хешируются
+ * параллельно.
+ *
+ * @param pieces  Бинарные SHA‑1 кусков (по 20 байт).
+ * @param threads Число потоков; 0 — по числу ядер.
+ */
+bool torrent_v1_pieces(const std::vector<std::string>& files, uint64_t piece_length,
+                       std::vector<std::string>& pieces, unsigned threads = 0);
+
+/**
+ * @brief Хеши BitTorrent v2 (BEP 52) для каждого файла.
+ *
+ * Дерево Меркла SHA‑256 над блоками по 16 КиБ, дополненное нулевыми
+ * листьями до степени двойки. piece_length должен быть степенью двойки
+ * не меньше 16 КиБ. Поддеревья кусков всех файлов считаются параллельно.
+ */
+bool torrent_v2_hashes(const std::vector<std::string>& files, uint64_t piece_length,
+                       std::vector<TorrentV2File>& result, unsigned threads = 0);
+
+/**
+ * @brief Сохраняет хеши кусков в текстовом виде (hex по строке на кусок).
+ *
+ * @code
+ * # bittorrent v1 piece=262144
+ * <sha1 куска 0>
+ * ...
+ * # bittorrent v2 piece=262144
+ * file <размер> <путь>
+ * root <pieces root>
+ * <хеш piece layer 0>
+ * ...
+ * @endcode
+ */
+bool write_torrent_v1(const std::string& path, uint64_t piece_length, const std::vector<std::string>& pieces);
+bool write_torrent_v2(const std::string& path, uint64_t piece_length, const std::vector<TorrentV2File>& files);
+
+/**
+ * @brief Читает файл, записанный write_torrent_v1()/write_torrent_v2().
+ *
+ * @param version 1 или 2 — какой формат прочитан.
+ */
+bool read_torrent_hashes(const std::string& path, int& version, uint64_t& piece_length,
+                         std::vector<std::string>& pieces, std::vector<TorrentV2File>& files);
+
+/**
+ * @brief Проверяет набор файлов по сохранённым хешам кусков.
+ *
+ * Версия и размер куска берутся из файла хешей.
+ *
+ * @param path      Каталог или файл раздачи.
+ * @param hashfile  Файл, записанный write_torrent_v1()/write_torrent_v2().
+ * @param bad       Описания несовпавших кусков ("piece 12", "a/b.bin piece 3").
+ * @return false, если файлы или файл хешей не читаются либо набор файлов отличается.
+ */
+bool torrent_verify(const std::string& path, const std::string& hashfile, std::vector<std::string>& bad);
+
+#endif
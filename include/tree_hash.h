@@ -0,0 +1,34 @@
+#ifndef TREE_HASH_H
+#define TREE_HASH_H
+
+#include <cstdint>
+#include <string>
+
+/// Размер части дерева Glacier.
+constexpr uint64_t GLACIER_CHUNK_SIZE = 1ull << 20;
+/// Размер блока content_hash Dropbox.
+constexpr uint64_t DROPBOX_BLOCK_SIZE = 4ull << 20;
+
+/**
+ * @brief Вычисляет tree hash Amazon Glacier.
+ *
+ * SHA‑256 каждой части по 1 МиБ, затем попарно SHA‑256(левый || правый)
+ * до одного узла; непарный узел переходит на следующий уровень как есть.
+ * Части хешируются параллельно.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Хеш в hex или пустая строка при ошибке чтения.
+ */
+std::string glacier_tree_hash(const std::string& filepath, unsigned threads = 0);
+
+/**
+ * @brief Вычисляет content_hash Dropbox.
+ *
+ * SHA‑256 от склеенных SHA‑256 блоков по 4 МиБ. Блоки хешируются параллельно.
+ *
+ * @param threads Число потоков; 0 — по числу ядер.
+ * @return Хеш в hex или пустая строка при ошибке чтения.
+ */
+std::string dropbox_content_hash(const std::string& filepath, unsigned threads = 0);
+
+#endif
@@ -40,4 +40,58 @@ bool verify_sha1(const std::string& path, const std::string& expected);
  */
 bool verify_sha256(const std::string& path, const std::string& expected);
 
+/**
+ * @brief Проверяет соответствие SHA-384-хеша файла ожидаемому значению.
+ */
+bool verify_sha384(const std::string& path, const std::string& expected);
+
+/**
+ * @brief Проверяет соответствие SHA-512-хеша файла ожидаемому значению.
+ */
+bool verify_sha512(const std::string& path, const std::string& expected);
+
+/**
+ * @brief Проверяет соответствие SHA-512/256-хеша файла ожидаемому значению.
+ */
+bool verify_sha512_256(const std::string& path, const std::string& expected);
+
+/**
+ * @brief Проверяет соответствие BLAKE2b-хеша файла ожидаемому значению.
+ *
+ * @param key Ключ для режима MAC; пустой — обычный хеш (как у b2sum).
+ */
+bool verify_blake2b(const std::string& path, const std::string& expected, const std::string& key = "");
+
+/**
+ * @brief Проверяет соответствие BLAKE2s-хеша файла ожидаемому значению.
+ *
+ * @param key Ключ для режима MAC; пустой — обычный хеш.
+ */
+bool verify_blake2s(const std::string& path, const std::string& expected, const std::string& key = "");
+
+/**
+ * @brief Проверяет соответствие BLAKE3-хеша файла ожидаемому значению.
+ */
+bool verify_blake3(const std::string& path, const std::string& expected);
+
+/**
+ * @brief Проверяет соответствие SHA3-256-хеша файла ожидаемому значению.
+ */
+bool verify_sha3_256(const std::string& path, const std::string& expected);
+
+/**
+ * @brief Проверяет соответствие XXH3-64-хеша файла ожидаемому значению.
+ *
+ * XXH3 не криптографический: годится для обнаружения изменений, но не
+ * для защиты от намеренной подмены файла.
+ */
+bool verify_xxh3(const std::string& path, const std::string& expected);
+
+/**
+ * @brief Проверяет соответствие XXH128-хеша файла ожидаемому значению.
+ *
+ * Как и verify_xxh3(), не защищает от намеренной подмены.
+ */
+bool verify_xxh128(const std::string& path, const std::string& expected);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef XXH3_H
+#define XXH3_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Потоковое состояние XXH3 (общее для XXH3‑64 и XXH128).
+ *
+ * ВНИМАНИЕ: XXH3 — некриптографическая хеш‑функция. Она годится для
+ * обнаружения изменений и случайных повреждений, но не защищает от
+ * намеренно подобранных коллизий; для проверки целостности против
+ * злоумышленника нужны SHA‑2/BLAKE.
+ *
+ * Данные копятся в буфере по 256 байт (4 полосы по 64 байта) и
+ * добавляются в восемь 64‑битных аккумуляторов; после каждых 16 полос
+ * (блок 1 КиБ) аккумуляторы перемешиваются. Входы до 240 байт хешируются
+ * отдельными короткими ветками прямо из буфера.
+ */
+struct Xxh3State {
+    std::array<uint64_t, 8> acc;
+    std::array<uint8_t, 256> buffer;
+    size_t buffered;            ///< Байт в buffer.
+    size_t stripes;             ///< Полос, добавленных в текущем блоке.
+    uint64_t total;             ///< Всего байт.
+};
+
+/**
+ * @brief 128‑битный результат XXH128.
+ */
+struct Xxh128Hash {
+    uint64_t low;
+    uint64_t high;
+};
+
+void xxh3_init(Xxh3State& state);
+void xxh3_update(Xxh3State& state, const uint8_t* data, size_t size);
+
+/**
+ * @brief XXH3‑64 всех добавленных данных; состояние не меняется.
+ */
+uint64_t xxh3_64_digest(const Xxh3State& state);
+
+/**
+ * @brief XXH128 всех добавленных данных; состояние не меняется.
+ */
+Xxh128Hash xxh3_128_digest(const Xxh3State& state);
+
+/// XXH3‑64 буфера (seed 0, стандартный секрет).
+uint64_t xxh3_64(const uint8_t* data, size_t size);
+
+/// XXH128 буфера (seed 0, стандартный секрет).
+Xxh128Hash xxh3_128(const uint8_t* data, size_t size);
+
+/**
+ * @brief Вычисляет XXH3‑64 файла (некриптографический, см. Xxh3State).
+ *
+ * @return 16 hex‑символов в каноническом порядке (big endian, как у xxhsum)
+ *         или пустая строка при ошибке чтения.
+ */
+std::string xxh3_file(const std::string& filepath);
+
+/**
+ * @brief Вычисляет XXH128 файла (некриптографический, см. Xxh3State).
+ *
+ * @return 32 hex‑символа: старшая половина, затем младшая (как у xxhsum),
+ *         или пустая строка при ошибке чтения.
+ */
+std::string xxh128_file(const std::string& filepath);
+
+#endif
@@ -0,0 +1,405 @@
+/**
+ * @file blake2.cpp
+ * @brief BLAKE2b и BLAKE2s: скалярные ядра, ядра SSE4.1/AVX2 и потоковый интерфейс.
+ */
+
+#include "../include/blake2.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/cpu_features.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    const uint64_t IV64[8] = {
+        0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+        0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull,
+    };
+
+    const uint32_t IV32[8] = {
+        0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+    };
+
+    /// Перестановки слов сообщения; раунды 10 и 11 BLAKE2b повторяют 0 и 1.
+    const uint8_t SIGMA[10][16] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+        { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+        { 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+        { 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+        { 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+        { 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+        { 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+        { 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+        { 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+        { 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+    };
+
+    constexpr int ROUNDS_B = 12;
+    constexpr int ROUNDS_S = 10;
+
+    /**
+     * @brief Функция G: сдвиги R1–R4 равны 32, 24, 16, 63 для BLAKE2b
+     * и 16, 12, 8, 7 для BLAKE2s.
+     */
+    template <typename Word, int R1, int R2, int R3, int R4>
+    inline void g(Word* v, int a, int b, int c, int d, Word x, Word y) {
+        constexpr int BITS = 8 * sizeof(Word);
+        auto rotr = [](Word w, int n) { return static_cast<Word>((w >> n) | (w << (BITS - n))); };
+        v[a] = v[a] + v[b] + x;
+        v[d] = rotr(v[d] ^ v[a], R1);
+        v[c] = v[c] + v[d];
+        v[b] = rotr(v[b] ^ v[c], R2);
+        v[a] = v[a] + v[b] + y;
+        v[d] = rotr(v[d] ^ v[a], R3);
+        v[c] = v[c] + v[d];
+        v[b] = rotr(v[b] ^ v[c], R4);
+    }
+
+    /**
+     * @brief Скалярное сжатие блока, общее для обоих вариантов.
+     *
+     * @param h    Цепочечное значение.
+     * @param m    16 слов блока.
+     * @param t    Счётчик байт.
+     * @param last Последний блок (флаг f0).
+     */
+    template <typename Word, int Rounds, int R1, int R2, int R3, int R4>
+    void compress_portable(Word h[8], const Word m[16], const Word t[2], bool last, const Word iv[8]) {
+        Word v[16];
+        for (int i = 0; i < 8; ++i) {
+            v[i] = h[i];
+            v[i + 8] = iv[i];
+        }
+        v[12] ^= t[0];
+        v[13] ^= t[1];
+        if (last) v[14] = ~v[14];
+        for (int r = 0; r < Rounds; ++r) {
+            const uint8_t* s = SIGMA[r % 10];
+            g<Word, R1, R2, R3, R4>(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            g<Word, R1, R2, R3, R4>(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            g<Word, R1, R2, R3, R4>(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            g<Word, R1, R2, R3, R4>(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            g<Word, R1, R2, R3, R4>(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            g<Word, R1, R2, R3, R4>(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            g<Word, R1, R2, R3, R4>(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            g<Word, R1, R2, R3, R4>(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i) h[i] ^= v[i] ^ v[i + 8];
+    }
+
+#ifdef HASH_X86_SIMD
+    // ---------- BLAKE2b, AVX2: строка состояния из четырёх 64‑битных слов в одном регистре ----------
+
+    __attribute__((target("avx2")))
+    inline void g_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y) {
+        const __m256i rot24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                               3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+        const __m256i rot16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                               2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+        d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), 0xB1);
+        c = _mm256_add_epi64(c, d);
+        b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rot24);
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+        d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);
+        c = _mm256_add_epi64(c, d);
+        b = _mm256_xor_si256(b, c);
+        b = _mm256_xor_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i words4_avx2(const uint64_t* m, const uint8_t* s, int first) {
+        return _mm256_setr_epi64x(static_cast<long long>(m[s[first]]), static_cast<long long>(m[s[first + 2]]),
+                                  static_cast<long long>(m[s[first + 4]]), static_cast<long long>(m[s[first + 6]]));
+    }
+
+    /**
+     * @brief Сжатие BLAKE2b на AVX2.
+     *
+     * Столбцовый шаг G выполняется сразу для четырёх столбцов; для
+     * диагонального строки 2–4 поворачиваются vpermq и потом возвращаются.
+     */
+    __attribute__((target("avx2")))
+    void compress_b_avx2(uint64_t h[8], const uint64_t m[16], const uint64_t t[2], bool last) {
+        __m256i row1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h));
+        __m256i row2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + 4));
+        __m256i row3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(IV64));
+        __m256i row4 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(IV64 + 4)),
+                                        _mm256_setr_epi64x(static_cast<long long>(t[0]), static_cast<long long>(t[1]),
+                                                           last ? -1 : 0, 0));
+        const __m256i h1 = row1, h2 = row2;
+        for (int r = 0; r < ROUNDS_B; ++r) {
+            const uint8_t* s = SIGMA[r % 10];
+            g_avx2(row1, row2, row3, row4, words4_avx2(m, s, 0), words4_avx2(m, s, 1));
+            row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(0, 3, 2, 1));
+            row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1, 0, 3, 2));
+            row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(2, 1, 0, 3));
+            g_avx2(row1, row2, row3, row4, words4_avx2(m, s, 8), words4_avx2(m, s, 9));
+            row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(2, 1, 0, 3));
+            row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1, 0, 3, 2));
+            row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(h), _mm256_xor_si256(h1, _mm256_xor_si256(row1, row3)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(h + 4), _mm256_xor_si256(h2, _mm256_xor_si256(row2, row4)));
+    }
+
+    // ---------- BLAKE2b, SSE4.1: строка — пара регистров (l — слова 0–1, h — слова 2–3) ----------
+
+    __attribute__((target("sse4.1")))
+    inline void g_half_sse41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x, __m128i y) {
+        const __m128i rot24 = _mm_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+        const __m128i rot16 = _mm_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+        a = _mm_add_epi64(_mm_add_epi64(a, b), x);
+        d = _mm_shuffle_epi32(_mm_xor_si128(d, a), 0xB1);
+        c = _mm_add_epi64(c, d);
+        b = _mm_shuffle_epi8(_mm_xor_si128(b, c), rot24);
+        a = _mm_add_epi64(_mm_add_epi64(a, b), y);
+        d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot16);
+        c = _mm_add_epi64(c, d);
+        b = _mm_xor_si128(b, c);
+        b = _mm_xor_si128(_mm_srli_epi64(b, 63), _mm_add_epi64(b, b));
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i words2_sse41(const uint64_t* m, const uint8_t* s, int first) {
+        return _mm_set_epi64x(static_cast<long long>(m[s[first + 2]]), static_cast<long long>(m[s[first]]));
+    }
+
+    /**
+     * @brief Сжатие BLAKE2b на SSE4.1; диагонализация собирается из palignr.
+     */
+    __attribute__((target("sse4.1")))
+    void compress_b_sse41(uint64_t h[8], const uint64_t m[16], const uint64_t t[2], bool last) {
+        auto load = [](const uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+        __m128i row1l = load(h), row1h = load(h + 2), row2l = load(h + 4), row2h = load(h + 6);
+        __m128i row3l = load(IV64), row3h = load(IV64 + 2);
+        __m128i row4l = _mm_xor_si128(load(IV64 + 4),
+                                      _mm_set_epi64x(static_cast<long long>(t[1]), static_cast<long long>(t[0])));
+        __m128i row4h = _mm_xor_si128(load(IV64 + 6), _mm_set_epi64x(0, last ? -1 : 0));
+        for (int r = 0; r < ROUNDS_B; ++r) {
+            const uint8_t* s = SIGMA[r % 10];
+            g_half_sse41(row1l, row2l, row3l, row4l, words2_sse41(m, s, 0), words2_sse41(m, s, 1));
+            g_half_sse41(row1h, row2h, row3h, row4h, words2_sse41(m, s, 4), words2_sse41(m, s, 5));
+            // Строка 2 → (v5, v6 | v7, v4), 3 → (v10, v11 | v8, v9), 4 → (v15, v12 | v13, v14).
+            __m128i t0 = _mm_alignr_epi8(row2h, row2l, 8), t1 = _mm_alignr_epi8(row2l, row2h, 8);
+            row2l = t0; row2h = t1;
+            std::swap(row3l, row3h);
+            t0 = _mm_alignr_epi8(row4l, row4h, 8); t1 = _mm_alignr_epi8(row4h, row4l, 8);
+            row4l = t0; row4h = t1;
+            g_half_sse41(row1l, row2l, row3l, row4l, words2_sse41(m, s, 8), words2_sse41(m, s, 9));
+            g_half_sse41(row1h, row2h, row3h, row4h, words2_sse41(m, s, 12), words2_sse41(m, s, 13));
+            t0 = _mm_alignr_epi8(row2l, row2h, 8); t1 = _mm_alignr_epi8(row2h, row2l, 8);
+            row2l = t0; row2h = t1;
+            std::swap(row3l, row3h);
+            t0 = _mm_alignr_epi8(row4h, row4l, 8); t1 = _mm_alignr_epi8(row4l, row4h, 8);
+            row4l = t0; row4h = t1;
+        }
+        auto store = [](uint64_t* p, __m128i old, __m128i a, __m128i b) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_xor_si128(old, _mm_xor_si128(a, b)));
+        };
+        store(h, load(h), row1l, row3l);
+        store(h + 2, load(h + 2), row1h, row3h);
+        store(h + 4, load(h + 4), row2l, row4l);
+        store(h + 6, load(h + 6), row2h, row4h);
+    }
+
+    // ---------- BLAKE2s, SSE4.1: строка из четырёх 32‑битных слов ----------
+
+    __attribute__((target("sse4.1")))
+    inline void g_s_sse41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x, __m128i y) {
+        a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+        d = _mm_shuffle_epi8(_mm_xor_si128(d, a), _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+        c = _mm_add_epi32(c, d);
+        b = _mm_xor_si128(b, c);
+        b = _mm_or_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+        a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+        d = _mm_shuffle_epi8(_mm_xor_si128(d, a), _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12));
+        c = _mm_add_epi32(c, d);
+        b = _mm_xor_si128(b, c);
+        b = _mm_or_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i words4_sse41(const uint32_t* m, const uint8_t* s, int first) {
+        return _mm_setr_epi32(static_cast<int>(m[s[first]]), static_cast<int>(m[s[first + 2]]),
+                              static_cast<int>(m[s[first + 4]]), static_cast<int>(m[s[first + 6]]));
+    }
+
+    /**
+     * @brief Сжатие BLAKE2s на SSE4.1; диагонализация — pshufd строк 2–4.
+     */
+    __attribute__((target("sse4.1")))
+    void compress_s_sse41(uint32_t h[8], const uint32_t m[16], const uint32_t t[2], bool last) {
+        const __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h));
+        const __m128i h2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 4));
+        __m128i row1 = h1, row2 = h2;
+        __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(IV32));
+        __m128i row4 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(IV32 + 4)),
+                                     _mm_setr_epi32(static_cast<int>(t[0]), static_cast<int>(t[1]), last ? -1 : 0, 0));
+        for (int r = 0; r < ROUNDS_S; ++r) {
+            const uint8_t* s = SIGMA[r];
+            g_s_sse41(row1, row2, row3, row4, words4_sse41(m, s, 0), words4_sse41(m, s, 1));
+            row2 = _mm_shuffle_epi32(row2, 0x39);
+            row3 = _mm_shuffle_epi32(row3, 0x4E);
+            row4 = _mm_shuffle_epi32(row4, 0x93);
+            g_s_sse41(row1, row2, row3, row4, words4_sse41(m, s, 8), words4_sse41(m, s, 9));
+            row2 = _mm_shuffle_epi32(row2, 0x93);
+            row3 = _mm_shuffle_epi32(row3, 0x4E);
+            row4 = _mm_shuffle_epi32(row4, 0x39);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(h), _mm_xor_si128(h1, _mm_xor_si128(row1, row3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 4), _mm_xor_si128(h2, _mm_xor_si128(row2, row4)));
+    }
+#endif
+
+    void compress_b(Blake2bContext& ctx, const uint8_t* block, bool last) {
+        uint64_t m[16];
+        for (int i = 0; i < 16; ++i) m[i] = load_le64(block + 8 * i);
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx2()) {
+            compress_b_avx2(ctx.h.data(), m, ctx.t.data(), last);
+            return;
+        }
+        if (cpu_has_sse41()) {
+            compress_b_sse41(ctx.h.data(), m, ctx.t.data(), last);
+            return;
+        }
+#endif
+        compress_portable<uint64_t, ROUNDS_B, 32, 24, 16, 63>(ctx.h.data(), m, ctx.t.data(), last, IV64);
+    }
+
+    void compress_s(Blake2sContext& ctx, const uint8_t* block, bool last) {
+        uint32_t m[16];
+        for (int i = 0; i < 16; ++i) m[i] = load_le32(block + 4 * i);
+#ifdef HASH_X86_SIMD
+        if (cpu_has_sse41()) {
+            compress_s_sse41(ctx.h.data(), m, ctx.t.data(), last);
+            return;
+        }
+#endif
+        compress_portable<uint32_t, ROUNDS_S, 16, 12, 8, 7>(ctx.h.data(), m, ctx.t.data(), last, IV32);
+    }
+
+    template <typename Context>
+    void increment_counter(Context& ctx, size_t n) {
+        using Word = typename decltype(Context::t)::value_type;
+        ctx.t[0] += static_cast<Word>(n);
+        if (ctx.t[0] < n) ++ctx.t[1];
+    }
+
+    /**
+     * @brief Параметрический блок: в первом слове длины дайджеста и ключа,
+     * fanout = depth = 1 (последовательный режим), остальное — нули.
+     */
+    template <typename Context, typename Word>
+    bool blake2_init(Context& ctx, size_t out_len, const uint8_t* key, size_t key_len, const Word* iv) {
+        const size_t max = ctx.h.size() * sizeof(Word);
+        if (out_len == 0 || out_len > max || key_len > max || (key_len > 0 && !key)) return false;
+        std::copy(iv, iv + 8, ctx.h.begin());
+        ctx.h[0] ^= static_cast<Word>(0x01010000u ^ (key_len << 8) ^ out_len);
+        ctx.t = {};
+        ctx.block.fill(0);
+        ctx.used = 0;
+        ctx.out_len = out_len;
+        if (key_len > 0) {
+            // Ключ дополняется нулями до целого блока и идёт первым блоком.
+            std::copy(key, key + key_len, ctx.block.begin());
+            ctx.used = ctx.block.size();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Общая часть *_update: заполненный блок сжимается только когда
+     * известно, что за ним есть данные; целые блоки из середины входа
+     * сжимаются без копирования.
+     */
+    template <typename Context, typename Compress>
+    void blake2_update(Context& ctx, const uint8_t* data, size_t size, Compress compress) {
+        const size_t B = ctx.block.size();
+        while (size > 0) {
+            if (ctx.used == B) {
+                increment_counter(ctx, B);
+                compress(ctx, ctx.block.data(), false);
+                ctx.used = 0;
+            }
+            if (ctx.used == 0) {
+                for (; size > B; data += B, size -= B) {
+                    increment_counter(ctx, B);
+                    compress(ctx, data, false);
+                }
+            }
+            const size_t take = std::min(B - ctx.used, size);
+            std::memcpy(ctx.block.data() + ctx.used, data, take);
+            ctx.used += take;
+            data += take;
+            size -= take;
+        }
+    }
+
+    template <typename Context, typename Compress>
+    void blake2_final(Context& ctx, uint8_t* digest, Compress compress) {
+        using Word = typename decltype(Context::h)::value_type;
+        increment_counter(ctx, ctx.used);
+        std::fill(ctx.block.begin() + ctx.used, ctx.block.end(), 0);
+        compress(ctx, ctx.block.data(), true);
+        uint8_t out[sizeof(Word) * 8];
+        for (size_t i = 0; i < 8; ++i) {
+            if (sizeof(Word) == 8) store_le64(out + 8 * i, ctx.h[i]);
+            else store_le32(out + 4 * i, static_cast<uint32_t>(ctx.h[i]));
+        }
+        std::copy(out, out + ctx.out_len, digest);
+    }
+
+    template <typename Context, typename Init, typename Update, typename Final>
+    std::string blake2_file(const std::string& filepath, const std::string& key, size_t out_len,
+                            Init init, Update update, Final final) {
+        Context ctx;
+        if (!init(ctx, out_len, reinterpret_cast<const uint8_t*>(key.data()), key.size())) return "";
+        if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { update(ctx, data, size); }))
+            return "";
+        uint8_t digest[64];
+        final(ctx, digest);
+        return to_hex(digest, out_len);
+    }
+}
+
+// ======================= BLAKE2b =======================
+bool blake2b_init(Blake2bContext& ctx, size_t out_len, const uint8_t* key, size_t key_len) {
+    return blake2_init(ctx, out_len, key, key_len, IV64);
+}
+
+void blake2b_update(Blake2bContext& ctx, const uint8_t* data, size_t size) {
+    blake2_update(ctx, data, size, compress_b);
+}
+
+void blake2b_final(Blake2bContext& ctx, uint8_t* digest) {
+    blake2_final(ctx, digest, compress_b);
+}
+
+std::string blake2b_file(const std::string& filepath, const std::string& key, size_t out_len) {
+    return blake2_file<Blake2bContext>(filepath, key, out_len, blake2b_init, blake2b_update, blake2b_final);
+}
+
+// ======================= BLAKE2s =======================
+bool blake2s_init(Blake2sContext& ctx, size_t out_len, const uint8_t* key, size_t key_len) {
+    return blake2_init(ctx, out_len, key, key_len, IV32);
+}
+
+void blake2s_update(Blake2sContext& ctx, const uint8_t* data, size_t size) {
+    blake2_update(ctx, data, size, compress_s);
+}
+
+void blake2s_final(Blake2sContext& ctx, uint8_t* digest) {
+    blake2_final(ctx, digest, compress_s);
+}
+
+std::string blake2s_file(const std::string& filepath, const std::string& key, size_t out_len) {
+    return blake2_file<Blake2sContext>(filepath, key, out_len, blake2s_init, blake2s_update, blake2s_final);
+}
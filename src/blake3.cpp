@@ -0,0 +1,623 @@
+/**
+ * @file blake3.cpp
+ * @brief BLAKE3: ядра сжатия (скалярное, SSE4.1, AVX2, AVX‑512), дерево кусков
+ *        и многопоточное хеширование файла.
+ */
+
+#include "../include/blake3.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+#include "../include/byte_order.h"
+#include "../include/cpu_features.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    const uint32_t IV[8] = {
+        0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+    };
+
+    enum : uint8_t {
+        CHUNK_START = 1 << 0,
+        CHUNK_END = 1 << 1,
+        PARENT = 1 << 2,
+        ROOT = 1 << 3,
+    };
+
+    /// Порядок слов сообщения в каждом из 7 раундов (перестановка применяется накопительно).
+    const uint8_t MSG_SCHEDULE[7][16] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+        { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+        { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+        { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+        { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+        { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+        { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 },
+    };
+
+    /// Сколько кусков blake3_update() сжимает одной пачкой.
+    constexpr size_t BATCH_CHUNKS = 64;
+
+    inline uint32_t rotr32(uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    inline void g(uint32_t* v, int a, int b, int c, int d, uint32_t x, uint32_t y) {
+        v[a] = v[a] + v[b] + x;
+        v[d] = rotr32(v[d] ^ v[a], 16);
+        v[c] = v[c] + v[d];
+        v[b] = rotr32(v[b] ^ v[c], 12);
+        v[a] = v[a] + v[b] + y;
+        v[d] = rotr32(v[d] ^ v[a], 8);
+        v[c] = v[c] + v[d];
+        v[b] = rotr32(v[b] ^ v[c], 7);
+    }
+
+    /**
+     * @brief Скалярное сжатие одного блока.
+     *
+     * @param out 16 слов: первые 8 — новое цепочечное значение, все 16 — блок
+     *            расширенного выхода корня.
+     */
+    void compress_portable(const uint32_t cv[8], const uint8_t block[64], uint8_t block_len,
+                           uint64_t counter, uint8_t flags, uint32_t out[16]) {
+        uint32_t m[16];
+        for (int i = 0; i < 16; ++i) m[i] = load_le32(block + 4 * i);
+        uint32_t v[16] = {
+            cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+            IV[0], IV[1], IV[2], IV[3],
+            static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), block_len, flags,
+        };
+        for (const uint8_t* s : MSG_SCHEDULE) {
+            g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i) {
+            out[i] = v[i] ^ v[i + 8];
+            out[i + 8] = v[i + 8] ^ cv[i];
+        }
+    }
+
+    /**
+     * @brief Пачка независимых входов одинаковой длины для ядер hash_many().
+     *
+     * Куски идут подряд с шагом 1024 байта и последовательными счётчиками,
+     * родительские узлы — с шагом 64 байта и нулевым счётчиком.
+     */
+    struct Batch {
+        const uint8_t* input;   ///< i‑й вход начинается с input + i·stride.
+        size_t stride;
+        size_t blocks;          ///< Блоков по 64 байта в каждом входе.
+        const uint32_t* key;
+        uint64_t counter;       ///< Счётчик первого входа.
+        bool increment;         ///< Счётчик i‑го входа — counter + i.
+        uint8_t flags;          ///< Флаги всех блоков.
+        uint8_t flags_start;    ///< Дополнительно у первого блока.
+        uint8_t flags_end;      ///< Дополнительно у последнего блока.
+    };
+
+    inline uint8_t block_flags(const Batch& b, size_t blk) {
+        uint8_t flags = b.flags;
+        if (blk == 0) flags |= b.flags_start;
+        if (blk + 1 == b.blocks) flags |= b.flags_end;
+        return flags;
+    }
+
+    inline uint64_t lane_counter(const Batch& b, size_t lane) {
+        return b.counter + (b.increment ? lane : 0);
+    }
+
+#ifdef HASH_X86_SIMD
+    __attribute__((target("sse4.1")))
+    inline __m128i rotr16_sse41(__m128i x) {
+        return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i rotr8_sse41(__m128i x) {
+        return _mm_shuffle_epi8(x, _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12));
+    }
+
+    __attribute__((target("sse4.1")))
+    inline void g_sse41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x, __m128i y) {
+        a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+        d = rotr16_sse41(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d);
+        b = _mm_xor_si128(b, c);
+        b = _mm_or_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+        a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+        d = rotr8_sse41(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d);
+        b = _mm_xor_si128(b, c);
+        b = _mm_or_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+    }
+
+    /**
+     * @brief Сжатие одного блока на SSE4.1: строки состояния в четырёх регистрах.
+     *
+     * Столбцовый шаг G идёт по всем четырём дорожкам сразу; для диагонального
+     * строки 1–3 поворачиваются pshufd и после шага возвращаются на место.
+     */
+    __attribute__((target("sse4.1")))
+    void compress_sse41(const uint32_t cv[8], const uint8_t block[64], uint8_t block_len,
+                        uint64_t counter, uint8_t flags, uint32_t out[16]) {
+        uint32_t m[16];
+        for (int i = 0; i < 16; ++i) m[i] = load_le32(block + 4 * i);
+        const __m128i cv0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cv));
+        const __m128i cv1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cv + 4));
+        __m128i r0 = cv0, r1 = cv1;
+        __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(IV));
+        __m128i r3 = _mm_setr_epi32(static_cast<int>(counter), static_cast<int>(counter >> 32), block_len, flags);
+        for (const uint8_t* s : MSG_SCHEDULE) {
+            g_sse41(r0, r1, r2, r3,
+                    _mm_setr_epi32(static_cast<int>(m[s[0]]), static_cast<int>(m[s[2]]),
+                                   static_cast<int>(m[s[4]]), static_cast<int>(m[s[6]])),
+                    _mm_setr_epi32(static_cast<int>(m[s[1]]), static_cast<int>(m[s[3]]),
+                                   static_cast<int>(m[s[5]]), static_cast<int>(m[s[7]])));
+            r1 = _mm_shuffle_epi32(r1, 0x39);
+            r2 = _mm_shuffle_epi32(r2, 0x4E);
+            r3 = _mm_shuffle_epi32(r3, 0x93);
+            g_sse41(r0, r1, r2, r3,
+                    _mm_setr_epi32(static_cast<int>(m[s[8]]), static_cast<int>(m[s[10]]),
+                                   static_cast<int>(m[s[12]]), static_cast<int>(m[s[14]])),
+                    _mm_setr_epi32(static_cast<int>(m[s[9]]), static_cast<int>(m[s[11]]),
+                                   static_cast<int>(m[s[13]]), static_cast<int>(m[s[15]])));
+            r1 = _mm_shuffle_epi32(r1, 0x93);
+            r2 = _mm_shuffle_epi32(r2, 0x4E);
+            r3 = _mm_shuffle_epi32(r3, 0x39);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(r0, r2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_xor_si128(r1, r3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_xor_si128(r2, cv0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_xor_si128(r3, cv1));
+    }
+
+    /**
+     * @brief Раунд для транспонированного состояния: v[i] держит слово i всех дорожек.
+     */
+    __attribute__((target("sse4.1")))
+    inline void round_x4_sse41(__m128i* v, const __m128i* m, const uint8_t* s) {
+        g_sse41(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        g_sse41(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        g_sse41(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        g_sse41(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        g_sse41(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        g_sse41(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        g_sse41(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        g_sse41(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+
+    /// Четыре входа пачки начиная с first, по одному в 32‑битной дорожке.
+    __attribute__((target("sse4.1")))
+    void hash4_sse41(const Batch& b, size_t first, uint8_t* out) {
+        __m128i h[8];
+        for (int i = 0; i < 8; ++i) h[i] = _mm_set1_epi32(static_cast<int>(b.key[i]));
+        alignas(16) uint32_t lo[4], hi[4];
+        for (size_t l = 0; l < 4; ++l) {
+            uint64_t counter = lane_counter(b, first + l);
+            lo[l] = static_cast<uint32_t>(counter);
+            hi[l] = static_cast<uint32_t>(counter >> 32);
+        }
+        const __m128i counter_lo = _mm_load_si128(reinterpret_cast<const __m128i*>(lo));
+        const __m128i counter_hi = _mm_load_si128(reinterpret_cast<const __m128i*>(hi));
+        const uint8_t* input = b.input + first * b.stride;
+
+        for (size_t blk = 0; blk < b.blocks; ++blk) {
+            __m128i m[16];
+            const uint8_t* p = input + 64 * blk;
+            for (int j = 0; j < 16; ++j) {
+                m[j] = _mm_setr_epi32(static_cast<int>(load_le32(p + 4 * j)),
+                                      static_cast<int>(load_le32(p + b.stride + 4 * j)),
+                                      static_cast<int>(load_le32(p + 2 * b.stride + 4 * j)),
+                                      static_cast<int>(load_le32(p + 3 * b.stride + 4 * j)));
+            }
+            __m128i v[16] = {
+                h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+                _mm_set1_epi32(static_cast<int>(IV[0])), _mm_set1_epi32(static_cast<int>(IV[1])),
+                _mm_set1_epi32(static_cast<int>(IV[2])), _mm_set1_epi32(static_cast<int>(IV[3])),
+                counter_lo, counter_hi, _mm_set1_epi32(64), _mm_set1_epi32(block_flags(b, blk)),
+            };
+            for (const uint8_t* s : MSG_SCHEDULE) round_x4_sse41(v, m, s);
+            for (int i = 0; i < 8; ++i) h[i] = _mm_xor_si128(v[i], v[i + 8]);
+        }
+
+        alignas(16) uint32_t words[8][4];
+        for (int i = 0; i < 8; ++i) _mm_store_si128(reinterpret_cast<__m128i*>(words[i]), h[i]);
+        for (size_t l = 0; l < 4; ++l)
+            for (int i = 0; i < 8; ++i) store_le32(out + 32 * (first + l) + 4 * i, words[i][l]);
+    }
+
+    __attribute__((target("avx2")))
+    inline void g_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y) {
+        const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                               2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+        const __m256i rot8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+                                              1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+        a = _mm256_add_epi32(_mm256_add_epi32(a, b), x);
+        d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);
+        c = _mm256_add_epi32(c, d);
+        b = _mm256_xor_si256(b, c);
+        b = _mm256_or_si256(_mm256_srli_epi32(b, 12), _mm256_slli_epi32(b, 20));
+        a = _mm256_add_epi32(_mm256_add_epi32(a, b), y);
+        d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);
+        c = _mm256_add_epi32(c, d);
+        b = _mm256_xor_si256(b, c);
+        b = _mm256_or_si256(_mm256_srli_epi32(b, 7), _mm256_slli_epi32(b, 25));
+    }
+
+    __attribute__((target("avx2")))
+    inline void round_x8_avx2(__m256i* v, const __m256i* m, const uint8_t* s) {
+        g_avx2(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        g_avx2(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        g_avx2(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        g_avx2(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        g_avx2(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        g_avx2(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        g_avx2(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        g_avx2(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+
+    /// Восемь входов пачки; слова сообщения собираются vpgatherdd с шагом stride.
+    __attribute__((target("avx2")))
+    void hash8_avx2(const Batch& b, size_t first, uint8_t* out) {
+        __m256i h[8];
+        for (int i = 0; i < 8; ++i) h[i] = _mm256_set1_epi32(static_cast<int>(b.key[i]));
+        alignas(32) uint32_t lo[8], hi[8];
+        for (size_t l = 0; l < 8; ++l) {
+            uint64_t counter = lane_counter(b, first + l);
+            lo[l] = static_cast<uint32_t>(counter);
+            hi[l] = static_cast<uint32_t>(counter >> 32);
+        }
+        const __m256i counter_lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(lo));
+        const __m256i counter_hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(hi));
+        const int stride = static_cast<int>(b.stride);
+        const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+        const uint8_t* input = b.input + first * b.stride;
+
+        for (size_t blk = 0; blk < b.blocks; ++blk) {
+            __m256i m[16];
+            const uint8_t* p = input + 64 * blk;
+            for (int j = 0; j < 16; ++j)
+                m[j] = _mm256_i32gather_epi32(reinterpret_cast<const int*>(p + 4 * j), index, 1);
+            __m256i v[16] = {
+                h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+                _mm256_set1_epi32(static_cast<int>(IV[0])), _mm256_set1_epi32(static_cast<int>(IV[1])),
+                _mm256_set1_epi32(static_cast<int>(IV[2])), _mm256_set1_epi32(static_cast<int>(IV[3])),
+                counter_lo, counter_hi, _mm256_set1_epi32(64), _mm256_set1_epi32(block_flags(b, blk)),
+            };
+            for (const uint8_t* s : MSG_SCHEDULE) round_x8_avx2(v, m, s);
+            for (int i = 0; i < 8; ++i) h[i] = _mm256_xor_si256(v[i], v[i + 8]);
+        }
+
+        alignas(32) uint32_t words[8][8];
+        for (int i = 0; i < 8; ++i) _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), h[i]);
+        for (size_t l = 0; l < 8; ++l)
+            for (int i = 0; i < 8; ++i) store_le32(out + 32 * (first + l) + 4 * i, words[i][l]);
+    }
+
+HASH_AVX512_WARNINGS_PUSH
+    /// На AVX‑512 все четыре циклических сдвига G — одна инструкция vprord.
+    __attribute__((target("avx512f")))
+    inline void g_avx512(__m512i& a, __m512i& b, __m512i& c, __m512i& d, __m512i x, __m512i y) {
+        a = _mm512_add_epi32(_mm512_add_epi32(a, b), x);
+        d = _mm512_ror_epi32(_mm512_xor_si512(d, a), 16);
+        c = _mm512_add_epi32(c, d);
+        b = _mm512_ror_epi32(_mm512_xor_si512(b, c), 12);
+        a = _mm512_add_epi32(_mm512_add_epi32(a, b), y);
+        d = _mm512_ror_epi32(_mm512_xor_si512(d, a), 8);
+        c = _mm512_add_epi32(c, d);
+        b = _mm512_ror_epi32(_mm512_xor_si512(b, c), 7);
+    }
+
+    __attribute__((target("avx512f")))
+    inline void round_x16_avx512(__m512i* v, const __m512i* m, const uint8_t* s) {
+        g_avx512(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        g_avx512(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        g_avx512(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        g_avx512(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        g_avx512(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        g_avx512(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        g_avx512(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        g_avx512(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+
+    /// Шестнадцать входов пачки.
+    __attribute__((target("avx512f")))
+    void hash16_avx512(const Batch& b, size_t first, uint8_t* out) {
+        __m512i h[8];
+        for (int i = 0; i < 8; ++i) h[i] = _mm512_set1_epi32(static_cast<int>(b.key[i]));
+        alignas(64) uint32_t lo[16], hi[16];
+        for (size_t l = 0; l < 16; ++l) {
+            uint64_t counter = lane_counter(b, first + l);
+            lo[l] = static_cast<uint32_t>(counter);
+            hi[l] = static_cast<uint32_t>(counter >> 32);
+        }
+        const __m512i counter_lo = _mm512_load_si512(lo);
+        const __m512i counter_hi = _mm512_load_si512(hi);
+        const int stride = static_cast<int>(b.stride);
+        const __m512i index = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(stride));
+        const uint8_t* input = b.input + first * b.stride;
+
+        for (size_t blk = 0; blk < b.blocks; ++blk) {
+            __m512i m[16];
+            const uint8_t* p = input + 64 * blk;
+            for (int j = 0; j < 16; ++j) m[j] = _mm512_i32gather_epi32(index, p + 4 * j, 1);
+            __m512i v[16] = {
+                h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+                _mm512_set1_epi32(static_cast<int>(IV[0])), _mm512_set1_epi32(static_cast<int>(IV[1])),
+                _mm512_set1_epi32(static_cast<int>(IV[2])), _mm512_set1_epi32(static_cast<int>(IV[3])),
+                counter_lo, counter_hi, _mm512_set1_epi32(64), _mm512_set1_epi32(block_flags(b, blk)),
+            };
+            for (const uint8_t* s : MSG_SCHEDULE) round_x16_avx512(v, m, s);
+            for (int i = 0; i < 8; ++i) h[i] = _mm512_xor_si512(v[i], v[i + 8]);
+        }
+
+        alignas(64) uint32_t words[8][16];
+        for (int i = 0; i < 8; ++i) _mm512_store_si512(words[i], h[i]);
+        for (size_t l = 0; l < 16; ++l)
+            for (int i = 0; i < 8; ++i) store_le32(out + 32 * (first + l) + 4 * i, words[i][l]);
+    }
+HASH_AVX512_WARNINGS_POP
+#endif
+
+    void compress(const uint32_t cv[8], const uint8_t block[64], uint8_t block_len,
+                  uint64_t counter, uint8_t flags, uint32_t out[16]) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_sse41()) {
+            compress_sse41(cv, block, block_len, counter, flags, out);
+            return;
+        }
+#endif
+        compress_portable(cv, block, block_len, counter, flags, out);
+    }
+
+    /// Один вход пачки последовательными вызовами compress().
+    void hash_one(const Batch& b, size_t lane, uint8_t* out) {
+        uint32_t cv[8];
+        std::copy(b.key, b.key + 8, cv);
+        const uint8_t* input = b.input + lane * b.stride;
+        for (size_t blk = 0; blk < b.blocks; ++blk) {
+            uint32_t state[16];
+            compress(cv, input + 64 * blk, 64, lane_counter(b, lane), block_flags(b, blk), state);
+            std::copy(state, state + 8, cv);
+        }
+        for (int i = 0; i < 8; ++i) store_le32(out + 32 * lane + 4 * i, cv[i]);
+    }
+
+    /**
+     * @brief Вычисляет CV count входов пачки; CV i‑го входа — out + 32·i.
+     *
+     * Входы раздаются самым широким доступным ядрам, остаток — узким.
+     */
+    void hash_many(const Batch& b, size_t count, uint8_t* out) {
+        size_t i = 0;
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx512f())
+            for (; i + 16 <= count; i += 16) hash16_avx512(b, i, out);
+        if (cpu_has_avx2())
+            for (; i + 8 <= count; i += 8) hash8_avx2(b, i, out);
+        if (cpu_has_sse41())
+            for (; i + 4 <= count; i += 4) hash4_sse41(b, i, out);
+#endif
+        for (; i < count; ++i) hash_one(b, i, out);
+    }
+
+    /**
+     * @brief Узел дерева, ещё не сжатый: из него получается CV или, для корня, выход.
+     */
+    struct Output {
+        uint32_t cv[8];
+        uint8_t block[64];
+        uint8_t block_len;
+        uint64_t counter;
+        uint8_t flags;
+    };
+
+    void output_cv(const Output& node, uint32_t cv[8]) {
+        uint32_t state[16];
+        compress(node.cv, node.block, node.block_len, node.counter, node.flags, state);
+        std::copy(state, state + 8, cv);
+    }
+
+    Output parent_output(const uint32_t left[8], const uint32_t right[8], const uint32_t key[8], uint8_t flags) {
+        Output node;
+        std::copy(key, key + 8, node.cv);
+        for (int i = 0; i < 8; ++i) {
+            store_le32(node.block + 4 * i, left[i]);
+            store_le32(node.block + 32 + 4 * i, right[i]);
+        }
+        node.block_len = 64;
+        node.counter = 0;
+        node.flags = flags | PARENT;
+        return node;
+    }
+
+    inline size_t chunk_len(const Blake3Context& ctx) {
+        return ctx.blocks_compressed * 64 + ctx.used;
+    }
+
+    inline uint8_t start_flag(const Blake3Context& ctx) {
+        return ctx.blocks_compressed == 0 ? CHUNK_START : 0;
+    }
+
+    void start_chunk(Blake3Context& ctx, uint64_t counter) {
+        ctx.cv = ctx.key;
+        ctx.chunk_counter = counter;
+        ctx.used = 0;
+        ctx.blocks_compressed = 0;
+    }
+
+    /**
+     * @brief Кладёт в стек CV выровненного поддерева из 2^level кусков.
+     *
+     * Поддерево завершает столько уровней, сколько младших нулевых бит
+     * у total >> level; каждый завершённый уровень сливается с вершиной стека.
+     * Сливать можно сразу, потому что за поддеревом заведомо есть данные
+     * и ни один из этих узлов не станет корнем.
+     *
+     * @param total Число кусков вместе с этим поддеревом.
+     */
+    void push_cv(Blake3Context& ctx, std::array<uint32_t, 8> cv, uint64_t total, unsigned level) {
+        total >>= level;
+        while ((total & 1) == 0) {
+            Output parent = parent_output(ctx.stack[--ctx.stack_size].data(), cv.data(), ctx.key.data(), ctx.flags);
+            output_cv(parent, cv.data());
+            total >>= 1;
+        }
+        ctx.stack[ctx.stack_size++] = cv;
+    }
+
+    /**
+     * @brief CV выровненного поддерева из count = 2^k полных кусков.
+     *
+     * Сначала все куски, затем каждый уровень родителей сжимается через
+     * hash_many(), так что SIMD‑ядра работают и на внутренних узлах.
+     */
+    void subtree_cv(const uint8_t* data, size_t count, uint64_t counter, const uint32_t key[8], uint8_t flags,
+                    std::array<uint32_t, 8>& cv) {
+        std::vector<uint8_t> level(count * 32), next(count * 32);
+        Batch chunks = { data, BLAKE3_CHUNK_LEN, BLAKE3_CHUNK_LEN / 64, key, counter, true,
+                         flags, CHUNK_START, CHUNK_END };
+        hash_many(chunks, count, level.data());
+        while (count > 1) {
+            count /= 2;
+            Batch parents = { level.data(), 64, 1, key, 0, false, static_cast<uint8_t>(flags | PARENT), 0, 0 };
+            hash_many(parents, count, next.data());
+            level.swap(next);
+        }
+        for (int i = 0; i < 8; ++i) cv[i] = load_le32(level.data() + 4 * i);
+    }
+}
+
+void blake3_init(Blake3Context& ctx) {
+    std::copy(IV, IV + 8, ctx.key.begin());
+    ctx.flags = 0;
+    ctx.block.fill(0);
+    ctx.stack_size = 0;
+    start_chunk(ctx, 0);
+}
+
+void blake3_update(Blake3Context& ctx, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        if (chunk_len(ctx) == BLAKE3_CHUNK_LEN) {
+            // Кусок заполнен, и данные ещё есть — значит, он не корень.
+            uint32_t state[16];
+            compress(ctx.cv.data(), ctx.block.data(), 64, ctx.chunk_counter,
+                     ctx.flags | start_flag(ctx) | CHUNK_END, state);
+            std::array<uint32_t, 8> cv;
+            std::copy(state, state + 8, cv.begin());
+            push_cv(ctx, cv, ctx.chunk_counter + 1, 0);
+            start_chunk(ctx, ctx.chunk_counter + 1);
+        }
+        if (chunk_len(ctx) == 0 && size > BLAKE3_CHUNK_LEN) {
+            // Целые куски, за которыми есть данные, — пачкой через SIMD‑ядра.
+            const size_t count = std::min((size - 1) / BLAKE3_CHUNK_LEN, BATCH_CHUNKS);
+            uint8_t cvs[BATCH_CHUNKS * 32];
+            Batch chunks = { data, BLAKE3_CHUNK_LEN, BLAKE3_CHUNK_LEN / 64, ctx.key.data(), ctx.chunk_counter, true,
+                             ctx.flags, CHUNK_START, CHUNK_END };
+            hash_many(chunks, count, cvs);
+            for (size_t i = 0; i < count; ++i) {
+                std::array<uint32_t, 8> cv;
+                for (int w = 0; w < 8; ++w) cv[w] = load_le32(cvs + 32 * i + 4 * w);
+                push_cv(ctx, cv, ctx.chunk_counter + 1, 0);
+                start_chunk(ctx, ctx.chunk_counter + 1);
+            }
+            data += count * BLAKE3_CHUNK_LEN;
+            size -= count * BLAKE3_CHUNK_LEN;
+            continue;
+        }
+        if (ctx.used == 64) {
+            uint32_t state[16];
+            compress(ctx.cv.data(), ctx.block.data(), 64, ctx.chunk_counter, ctx.flags | start_flag(ctx), state);
+            std::copy(state, state + 8, ctx.cv.begin());
+            ++ctx.blocks_compressed;
+            ctx.used = 0;
+        }
+        const size_t take = std::min(64 - ctx.used, size);
+        std::memcpy(ctx.block.data() + ctx.used, data, take);
+        ctx.used += take;
+        data += take;
+        size -= take;
+    }
+}
+
+void blake3_final(Blake3Context& ctx, uint8_t* out, size_t size) {
+    Output node;
+    std::copy(ctx.cv.begin(), ctx.cv.end(), node.cv);
+    std::memset(node.block, 0, sizeof(node.block));
+    std::memcpy(node.block, ctx.block.data(), ctx.used);
+    node.block_len = static_cast<uint8_t>(ctx.used);
+    node.counter = ctx.chunk_counter;
+    node.flags = ctx.flags | start_flag(ctx) | CHUNK_END;
+
+    for (size_t i = ctx.stack_size; i-- > 0;) {
+        uint32_t cv[8];
+        output_cv(node, cv);
+        node = parent_output(ctx.stack[i].data(), cv, ctx.key.data(), ctx.flags);
+    }
+
+    // Корень: счётчик задаёт номер 64‑байтного блока расширенного выхода.
+    for (uint64_t counter = 0; size > 0; ++counter) {
+        uint32_t state[16];
+        compress(node.cv, node.block, node.block_len, counter, node.flags | ROOT, state);
+        uint8_t bytes[64];
+        for (int i = 0; i < 16; ++i) store_le32(bytes + 4 * i, state[i]);
+        const size_t take = std::min<size_t>(64, size);
+        std::memcpy(out, bytes, take);
+        out += take;
+        size -= take;
+    }
+}
+
+std::string blake3_file(const std::string& filepath, unsigned threads) {
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return "";
+    const uint64_t size = file.size();
+
+    // Сегмент — наибольшее поддерево из 2^level кусков, помещающееся в буфер пула.
+    unsigned level = 0;
+    while ((BLAKE3_CHUNK_LEN << (level + 1)) <= buffer_pool::buffer_size()) ++level;
+    const size_t chunks = size_t(1) << level;
+    const size_t segment = BLAKE3_CHUNK_LEN << level;
+    const size_t full = size > segment ? static_cast<size_t>((size - 1) / segment) : 0;
+
+    Blake3Context ctx;
+    blake3_init(ctx);
+    std::vector<std::array<uint32_t, 8>> cvs(full);
+    std::atomic<bool> ok(true);
+    parallel_for(full, [&](size_t i) {
+        buffer_pool::Buffer buffer = buffer_pool::acquire();
+        if (file.read_at(static_cast<uint64_t>(i) * segment, buffer.data(), segment) != static_cast<int64_t>(segment)) {
+            ok = false;
+            return;
+        }
+        subtree_cv(buffer.data(), chunks, static_cast<uint64_t>(i) * chunks, ctx.key.data(), ctx.flags, cvs[i]);
+    }, threads);
+    if (!ok) return "";
+
+    for (size_t i = 0; i < full; ++i) push_cv(ctx, cvs[i], static_cast<uint64_t>(i + 1) * chunks, level);
+    start_chunk(ctx, static_cast<uint64_t>(full) * chunks);
+    const uint64_t offset = static_cast<uint64_t>(full) * segment;
+    if (!file.read_range(offset, size - offset, [&](const uint8_t* data, size_t n) { blake3_update(ctx, data, n); }))
+        return "";
+
+    uint8_t digest[32];
+    blake3_final(ctx, digest);
+    return to_hex(digest, sizeof(digest));
+}
@@ -0,0 +1,121 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief Реализация общего пула буферов ввода‑вывода.
+ */
+
+#include "../include/buffer_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct Pool {
+        std::mutex mutex;
+        std::condition_variable released;
+        std::vector<std::unique_ptr<uint8_t[]>> free;
+        uint64_t limit = buffer_pool::DEFAULT_MEMORY_LIMIT;
+        size_t buffer_size = buffer_pool::DEFAULT_BUFFER_SIZE;
+        size_t capacity = buffer_pool::DEFAULT_MEMORY_LIMIT / buffer_pool::DEFAULT_BUFFER_SIZE;
+        size_t allocated = 0;
+    };
+
+    Pool& pool() {
+        static Pool instance;
+        return instance;
+    }
+}
+
+namespace buffer_pool {
+    Buffer::Buffer(Buffer&& other) noexcept
+        : data_(std::move(other.data_)), size_(other.size_) {
+        other.size_ = 0;
+    }
+
+    Buffer& Buffer::operator=(Buffer&& other) noexcept {
+        if (this != &other) {
+            Buffer old(std::move(*this));
+            data_ = std::move(other.data_);
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    Buffer::~Buffer() {
+        if (!data_) return;
+        Pool& p = pool();
+        {
+            std::lock_guard<std::mutex> lock(p.mutex);
+            if (size_ == p.buffer_size && p.allocated <= p.capacity) {
+                p.free.push_back(std::move(data_));
+            } else {
+                data_.reset();
+                --p.allocated;
+            }
+        }
+        p.released.notify_one();
+    }
+
+    bool set_memory_limit(uint64_t bytes) {
+        if (bytes < MIN_BUFFER_SIZE) return false;
+        Pool& p = pool();
+        {
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.limit = bytes;
+            // Четыре буфера, чтобы несколько потоков могли читать одновременно;
+            // при лимите меньше 4 · MIN_BUFFER_SIZE буферов меньше.
+            size_t size = static_cast<size_t>(std::min<uint64_t>(DEFAULT_BUFFER_SIZE, bytes / 4));
+            size = std::max(size, MIN_BUFFER_SIZE);
+            if (size != p.buffer_size) {
+                p.allocated -= p.free.size();
+                p.free.clear();
+                p.buffer_size = size;
+            }
+            p.capacity = static_cast<size_t>(bytes / p.buffer_size);
+            while (p.allocated > p.capacity && !p.free.empty()) {
+                p.free.pop_back();
+                --p.allocated;
+            }
+        }
+        p.released.notify_all();
+        return true;
+    }
+
+    uint64_t memory_limit() {
+        Pool& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        return p.limit;
+    }
+
+    size_t buffer_size() {
+        Pool& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        return p.buffer_size;
+    }
+
+    size_t allocated_buffers() {
+        Pool& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        return p.allocated;
+    }
+
+    Buffer acquire() {
+        Pool& p = pool();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        p.released.wait(lock, [&] { return !p.free.empty() || p.allocated < p.capacity; });
+
+        Buffer buffer;
+        buffer.size_ = p.buffer_size;
+        if (!p.free.empty()) {
+            buffer.data_ = std::move(p.free.back());
+            p.free.pop_back();
+        } else {
+            ++p.allocated;
+            lock.unlock();
+            buffer.data_.reset(new uint8_t[buffer.size_]);
+        }
+        return buffer;
+    }
+}
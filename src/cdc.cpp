@@ -0,0 +1,167 @@
+/**
+ * @file cdc.cpp
+ * @brief Разбиение FastCDC с SHA‑256 кусков для дедупликации.
+ */
+
+#include "../include/cdc.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+#include "../include/torrent.h"
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <memory>
+
+namespace {
+    /// Таблица Gear: 256 псевдослучайных 64‑битных чисел (splitmix64 от нуля).
+    constexpr std::array<uint64_t, 256> make_gear() {
+        std::array<uint64_t, 256> table{};
+        uint64_t state = 0;
+        for (size_t i = 0; i < table.size(); ++i) {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            table[i] = z ^ (z >> 31);
+        }
+        return table;
+    }
+
+    constexpr std::array<uint64_t, 256> GEAR = make_gear();
+
+    /// Маска из bits старших битов: старшие биты fp зависят от последних 64 байт.
+    uint64_t top_mask(unsigned bits) {
+        return bits == 0 ? 0 : ~0ull << (64 - bits);
+    }
+
+    struct ChunkState {
+        Sha256Context ctx;
+        std::string hash;
+    };
+}
+
+double DedupStats::ratio() const {
+    return unique_bytes == 0 ? 1.0 : static_cast<double>(total_bytes) / static_cast<double>(unique_bytes);
+}
+
+bool cdc_params_valid(const CdcParams& p) {
+    return p.min_size >= 64 && p.min_size <= p.avg_size && p.avg_size <= p.max_size;
+}
+
+bool cdc_chunk_file(const std::string& filepath, const CdcParams& params,
+                    std::vector<CdcChunk>& chunks, unsigned threads) {
+    chunks.clear();
+    if (!cdc_params_valid(params)) return false;
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return false;
+
+    const unsigned bits = static_cast<unsigned>(std::lround(std::log2(static_cast<double>(params.avg_size))));
+    const uint64_t mask_small = top_mask(bits + 1);
+    const uint64_t mask_large = top_mask(bits - 1);
+    if (threads == 0) threads = worker_count();
+
+    const uint64_t size = file.size();
+    std::vector<std::shared_ptr<ChunkState>> states;
+    bool ok = true;
+    {
+        std::vector<std::unique_ptr<SerialExecutor>> executors;
+        for (unsigned t = 0; t < threads; ++t) executors.push_back(std::make_unique<SerialExecutor>());
+
+        auto start_chunk = [&] {
+            auto state = std::make_shared<ChunkState>();
+            sha256_init(state->ctx);
+            states.push_back(state);
+        };
+        // Порция данных текущего куска уходит его исполнителю; буфер
+        // вернётся в пул после последней порции, при нехватке памяти ждём.
+        auto submit = [&](const std::shared_ptr<buffer_pool::Buffer>& buffer, size_t from, size_t to, bool last) {
+            std::shared_ptr<ChunkState> state = states.back();
+            executors[(states.size() - 1) % threads]->submit([buffer, state, from, to, last] {
+                sha256_update(state->ctx, buffer->data() + from, to - from);
+                if (last) {
+                    uint8_t digest[32];
+                    sha256_final(state->ctx, digest);
+                    state->hash = to_hex(digest, sizeof(digest));
+                }
+            });
+        };
+
+        uint64_t chunk_start = 0, length = 0, fp = 0;
+        if (size > 0) start_chunk();
+        for (uint64_t pos = 0; pos < size; ) {
+            auto buffer = std::make_shared<buffer_pool::Buffer>(buffer_pool::acquire());
+            size_t want = static_cast<size_t>(std::min<uint64_t>(size - pos, buffer->size()));
+            int64_t got = file.read_at(pos, buffer->data(), want);
+            if (got <= 0) { ok = false; break; }
+            const size_t n = static_cast<size_t>(got);
+            const uint8_t* data = buffer->data();
+
+            size_t piece = 0;
+            for (size_t i = 0; i < n; ++i) {
+                ++length;
+                bool cut = length >= params.max_size;
+                if (!cut && length > params.min_size) {
+                    fp = (fp << 1) + GEAR[data[i]];
+                    cut = (fp & (length <= params.avg_size ? mask_small : mask_large)) == 0;
+                }
+                if (!cut) continue;
+                submit(buffer, piece, i + 1, true);
+                chunks.push_back({ chunk_start, length, "" });
+                chunk_start += length;
+                length = 0;
+                fp = 0;
+                piece = i + 1;
+                if (pos + piece < size) start_chunk();
+            }
+            if (piece < n) submit(buffer, piece, n, pos + n == size);
+            pos += n;
+        }
+        if (ok && length > 0) chunks.push_back({ chunk_start, length, "" });
+    }
+    if (!ok) {
+        chunks.clear();
+        return false;
+    }
+    for (size_t i = 0; i < chunks.size(); ++i) chunks[i].hash = states[i]->hash;
+    return true;
+}
+
+void add_dedup_stats(const std::vector<CdcChunk>& chunks, std::unordered_set<std::string>& seen, DedupStats& stats) {
+    ++stats.files;
+    for (const CdcChunk& c : chunks) {
+        ++stats.chunks;
+        stats.total_bytes += c.length;
+        if (seen.insert(c.hash).second) {
+            ++stats.unique_chunks;
+            stats.unique_bytes += c.length;
+        }
+    }
+}
+
+bool cdc_chunk_tree(const std::string& path, const CdcParams& params, const std::string& list_path,
+                    DedupStats& stats, unsigned threads) {
+    stats = DedupStats();
+    std::vector<std::string> files;
+    if (!cdc_params_valid(params) || !torrent_file_list(path, files)) return false;
+
+    std::ofstream out;
+    if (!list_path.empty()) {
+        out.open(list_path);
+        if (!out) return false;
+        out << "# fastcdc min=" << params.min_size << " avg=" << params.avg_size
+            << " max=" << params.max_size << "\n";
+    }
+
+    std::unordered_set<std::string> seen;
+    std::vector<CdcChunk> chunks;
+    for (const std::string& f : files) {
+        if (!cdc_chunk_file(f, params, chunks, threads)) return false;
+        add_dedup_stats(chunks, seen, stats);
+        if (!out.is_open()) continue;
+        out << "file: " << f << "\n";
+        for (const CdcChunk& c : chunks) out << c.hash << " " << c.offset << " " << c.length << "\n";
+    }
+    return !out.is_open() || static_cast<bool>(out);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Хеширование длинных файлов с контрольными точками и продолжением после сбоя.
+ */
+
+#include "../include/checkpoint.h"
+#include "../include/hasher.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    /**
+     * Формат файла контрольной точки (little endian):
+     * "HCKP", версия (1 байт), размер файла (8), mtime (8),
+     * смещение продолжения (8), длина блоба (4), блоб Hasher::save_state().
+     */
+    const char CHECKPOINT_MAGIC[] = "HCKP";
+    constexpr uint8_t CHECKPOINT_VERSION = 1;
+
+    struct Checkpoint {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        uint64_t offset = 0;
+        std::string state;
+    };
+
+    constexpr size_t CHECKPOINT_HEADER = 4 + 1 + 8 + 8 + 8 + 4;
+
+    /// Записывает файл и дожидается, пока данные окажутся на диске.
+    bool write_synced(const std::string& path, const std::string& data) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        DWORD written = 0;
+        bool ok = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr)
+                  && written == data.size() && FlushFileBuffers(file);
+        CloseHandle(file);
+        return ok;
+#else
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) return false;
+        size_t done = 0;
+        while (done < data.size()) {
+            ssize_t n = write(fd, data.data() + done, data.size() - done);
+            if (n <= 0) break;
+            done += static_cast<size_t>(n);
+        }
+        bool ok = done == data.size() && fsync(fd) == 0;
+        return close(fd) == 0 && ok;
+#endif
+    }
+
+    bool save_checkpoint(const std::string& path, const Checkpoint& c) {
+        std::string data(CHECKPOINT_MAGIC, 4);
+        data += static_cast<char>(CHECKPOINT_VERSION);
+        append_le64(data, c.size);
+        append_le64(data, static_cast<uint64_t>(c.mtime));
+        append_le64(data, c.offset);
+        append_le32(data, static_cast<uint32_t>(c.state.size()));
+        data += c.state;
+
+        // Данные сбрасываются на диск до переименования, иначе после сбоя
+        // питания на месте контрольной точки может оказаться пустой файл.
+        std::string tmp = path + ".tmp";
+        if (!write_synced(tmp, data)) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) std::remove(tmp.c_str());
+        return !ec;
+    }
+
+    bool load_checkpoint(const std::string& path, Checkpoint& c) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (data.size() < CHECKPOINT_HEADER || data.compare(0, 4, CHECKPOINT_MAGIC, 4) != 0) return false;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data());
+        if (p[4] != CHECKPOINT_VERSION) return false;
+        c.size = load_le64(p + 5);
+        c.mtime = static_cast<int64_t>(load_le64(p + 13));
+        c.offset = load_le64(p + 21);
+        if (load_le32(p + 29) != data.size() - CHECKPOINT_HEADER) return false;
+        c.state = data.substr(CHECKPOINT_HEADER);
+        return true;
+    }
+}
+
+std::string checkpoint_path(const std::string& filepath, const std::string& algo) {
+    return filepath + "." + algo + ".checkpoint";
+}
+
+CheckpointResult hash_file_checkpointed(const std::string& algo, const std::string& filepath,
+                                        uint64_t interval, const std::string& checkpoint) {
+    CheckpointResult result;
+    if (interval == 0) return result;
+    const std::string path = checkpoint.empty() ? checkpoint_path(filepath, algo) : checkpoint;
+
+    std::error_code ec;
+    uint64_t size = std::filesystem::file_size(filepath, ec);
+    if (ec) return result;
+    int64_t mtime = std::filesystem::last_write_time(filepath, ec).time_since_epoch().count();
+    if (ec) return result;
+
+    // Алгоритм без сериализации состояния никогда не записал бы контрольную точку.
+    std::unique_ptr<Hasher> hasher = make_hasher(algo);
+    if (!hasher || hasher->save_state().empty()) return result;
+
+    uint64_t offset = 0;
+    Checkpoint saved;
+    if (load_checkpoint(path, saved) && saved.size == size && saved.mtime == mtime
+        && saved.offset <= size && hasher->load_state(saved.state)) {
+        offset = saved.offset;
+    } else {
+        hasher = make_hasher(algo);
+    }
+    result.resumed_from = offset;
+
+    uint64_t position = offset;
+    uint64_t next = (offset / interval + 1) * interval;
+    bool ok = read_file_range(filepath, offset, size - offset, [&](const uint8_t* data, size_t n) {
+        hasher->update(data, n);
+        position += n;
+        if (position >= next && position < size) {
+            Checkpoint c;
+            c.size = size;
+            c.mtime = mtime;
+            c.offset = position;
+            c.state = hasher->save_state();
+            if (!c.state.empty() && save_checkpoint(path, c))
+                ++result.checkpoints;
+            next = (position / interval + 1) * interval;
+        }
+    });
+    if (!ok) return result;
+
+    std::string digest = hasher->digest();
+    result.hash = to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+    std::filesystem::remove(path, ec);
+    return result;
+}
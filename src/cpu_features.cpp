@@ -0,0 +1,113 @@
+/**
+ * @file cpu_features.cpp
+ * @brief Определение возможностей процессора во время выполнения.
+ */
+
+#include "../include/cpu_features.h"
+
+#include <atomic>
+
+namespace {
+    std::atomic<SimdLevel> g_simd_max_level(SimdLevel::avx512bw);
+
+    bool allowed(SimdLevel level) {
+        return level <= g_simd_max_level.load();
+    }
+}
+
+void set_simd_max_level(SimdLevel level) {
+    g_simd_max_level = level;
+}
+
+SimdLevel simd_max_level() {
+    return g_simd_max_level;
+}
+
+void set_simd_enabled(bool enabled) {
+    g_simd_max_level = enabled ? SimdLevel::avx512bw : SimdLevel::scalar;
+}
+
+bool simd_enabled() {
+    return allowed(SimdLevel::sse2);
+}
+
+bool cpu_has_sse2() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("sse2"));
+    return supported && allowed(SimdLevel::sse2);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_sse41() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("sse4.1"));
+    return supported && allowed(SimdLevel::sse41);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_sse42() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("sse4.2"));
+    return supported && allowed(SimdLevel::sse41);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_pclmul() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("pclmul"));
+    return supported && allowed(SimdLevel::sse41);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_bmi() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("bmi"));
+    return supported && allowed(SimdLevel::avx2);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_bmi2() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2"));
+    return supported && allowed(SimdLevel::avx2);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_avx2() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return supported && allowed(SimdLevel::avx2);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_avx512f() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx512f"));
+    return supported && allowed(SimdLevel::avx512f);
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_avx512bw() {
+#ifdef HASH_X86_SIMD
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx512bw"));
+    return supported && allowed(SimdLevel::avx512bw);
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,305 @@
+/**
+ * @file crc32.cpp
+ * @brief CRC32C (инструкция crc32 SSE4.2, три независимых потока) и CRC32
+ *        IEEE (свёртка PCLMULQDQ) с табличным запасным вариантом и combine.
+ */
+
+#include "../include/crc32.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+#include "../include/cpu_features.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    /// Отражённые полиномы: бит 31 соответствует x^0.
+    constexpr uint32_t POLY_IEEE = 0xEDB88320U;
+    constexpr uint32_t POLY_CASTAGNOLI = 0x82F63B78U;
+
+    /// Таблицы slicing‑by‑8: t[k][b] — вклад байта b, за которым следуют k нулевых байт.
+    struct Tables {
+        uint32_t t[8][256];
+    };
+
+    Tables make_tables(uint32_t poly) {
+        Tables tables;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+            tables.t[0][i] = c;
+        }
+        for (int k = 1; k < 8; ++k)
+            for (uint32_t i = 0; i < 256; ++i)
+                tables.t[k][i] = (tables.t[k - 1][i] >> 8) ^ tables.t[0][tables.t[k - 1][i] & 0xFF];
+        return tables;
+    }
+
+    const Tables& tables_for(uint32_t poly) {
+        static const Tables ieee = make_tables(POLY_IEEE);
+        static const Tables castagnoli = make_tables(POLY_CASTAGNOLI);
+        return poly == POLY_IEEE ? ieee : castagnoli;
+    }
+
+    /// Регистр CRC (без начальной и конечной инверсии), по 8 байт за шаг.
+    uint32_t crc_portable(const Tables& tables, uint32_t c, const uint8_t* p, size_t n) {
+        const auto& t = tables.t;
+        while (n >= 8) {
+            const uint32_t lo = load_le32(p) ^ c;
+            const uint32_t hi = load_le32(p + 4);
+            c = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+            n -= 8;
+        }
+        while (n--) c = t[0][(c ^ *p++) & 0xFF] ^ (c >> 8);
+        return c;
+    }
+
+    // ---------- Арифметика по модулю полинома (для combine и сдвигов) ----------
+
+    /// Произведение a·b mod P в отражённом представлении.
+    uint32_t multmodp(uint32_t poly, uint32_t a, uint32_t b) {
+        uint32_t m = 1U << 31;
+        uint32_t p = 0;
+        for (;;) {
+            if (a & m) {
+                p ^= b;
+                if ((a & (m - 1)) == 0) break;
+            }
+            m >>= 1;
+            b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+        }
+        return p;
+    }
+
+    /// x^(n·2^k) mod P: произведение степеней x^(2^j) по битам n.
+    uint32_t x2nmodp(uint32_t poly, uint64_t n, unsigned k) {
+        uint32_t square = 1U << 30;               // x^1
+        for (unsigned i = 0; i < k; ++i) square = multmodp(poly, square, square);
+        uint32_t p = 1U << 31;                    // x^0
+        while (n) {
+            if (n & 1) p = multmodp(poly, square, p);
+            square = multmodp(poly, square, square);
+            n >>= 1;
+        }
+        return p;
+    }
+
+    uint32_t combine(uint32_t poly, uint32_t crc_a, uint32_t crc_b, uint64_t len_b) {
+        return multmodp(poly, x2nmodp(poly, len_b, 3), crc_a) ^ crc_b;
+    }
+
+#ifdef HASH_X86_SIMD
+    /**
+     * @brief Табличный сдвиг регистра CRC32C на фиксированное число нулевых байт.
+     *
+     * Сдвиг линеен, поэтому раскладывается на четыре таблицы по байтам
+     * регистра — дешевле, чем multmodp() на каждом блоке.
+     */
+    struct ShiftTable {
+        uint32_t t[4][256];
+
+        explicit ShiftTable(size_t bytes) {
+            const uint32_t op = x2nmodp(POLY_CASTAGNOLI, bytes, 3);
+            for (int k = 0; k < 4; ++k)
+                for (uint32_t b = 0; b < 256; ++b) t[k][b] = multmodp(POLY_CASTAGNOLI, op, b << (8 * k));
+        }
+
+        uint32_t shift(uint32_t c) const {
+            return t[0][c & 0xFF] ^ t[1][(c >> 8) & 0xFF] ^ t[2][(c >> 16) & 0xFF] ^ t[3][c >> 24];
+        }
+    };
+
+    /// Длины потока для больших и малых тройных блоков.
+    constexpr size_t LONG_STREAM = 8192;
+    constexpr size_t SHORT_STREAM = 256;
+
+    /**
+     * @brief Регистр CRC32C инструкцией crc32 по трём независимым потокам.
+     *
+     * У crc32 задержка 3 такта при пропускной способности 1 за такт, поэтому
+     * блок 3·L делится на три потока по L байт, которые считаются
+     * одновременно (второй и третий — с нулевого регистра), а затем
+     * сводятся: crc = shift(shift(c0) ^ c1) ^ c2, где shift — сдвиг на L байт.
+     */
+    __attribute__((target("sse4.2")))
+    uint32_t crc32c_sse42(uint32_t crc, const uint8_t* p, size_t n) {
+        static const ShiftTable long_shift(LONG_STREAM);
+        static const ShiftTable short_shift(SHORT_STREAM);
+
+        uint64_t c0 = crc;
+        for (const ShiftTable* table : { &long_shift, &short_shift }) {
+            const size_t stream = table == &long_shift ? LONG_STREAM : SHORT_STREAM;
+            while (n >= 3 * stream) {
+                uint64_t c1 = 0, c2 = 0;
+                for (size_t i = 0; i < stream; i += 8) {
+                    c0 = _mm_crc32_u64(c0, load_le64(p + i));
+                    c1 = _mm_crc32_u64(c1, load_le64(p + stream + i));
+                    c2 = _mm_crc32_u64(c2, load_le64(p + 2 * stream + i));
+                }
+                const uint32_t ab = table->shift(static_cast<uint32_t>(c0)) ^ static_cast<uint32_t>(c1);
+                c0 = table->shift(ab) ^ static_cast<uint32_t>(c2);
+                p += 3 * stream;
+                n -= 3 * stream;
+            }
+        }
+        while (n >= 8) {
+            c0 = _mm_crc32_u64(c0, load_le64(p));
+            p += 8;
+            n -= 8;
+        }
+        uint32_t c = static_cast<uint32_t>(c0);
+        while (n--) c = _mm_crc32_u8(c, *p++);
+        return c;
+    }
+
+    /**
+     * @brief Регистр CRC32 (IEEE) свёрткой PCLMULQDQ (Intel, «Fast CRC
+     *        Computation Using PCLMULQDQ», отражённый вариант).
+     *
+     * Четыре 128‑битных аккумулятора сворачиваются с очередными 64 байтами
+     * умножением без переносов на x^(512±64) mod P, затем сводятся в один,
+     * дальше — по 16 байт, и остаток 128 бит редуцируется до 32 бит
+     * методом Барретта. Требует n >= 64 и n кратного 16.
+     */
+    __attribute__((target("pclmul,sse4.1")))
+    uint32_t crc32_pclmul(uint32_t crc, const uint8_t* p, size_t n) {
+        const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+        const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+        const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124LL);
+        const __m128i poly_mu = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+        const __m128i low32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+        __m128i x1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+                                   _mm_cvtsi32_si128(static_cast<int>(crc)));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+        __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48));
+        p += 64;
+        n -= 64;
+
+        while (n >= 64) {
+            const __m128i f1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+            const __m128i f2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+            const __m128i f3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+            const __m128i f4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k1k2, 0x11), f1);
+            x2 = _mm_xor_si128(_mm_clmulepi64_si128(x2, k1k2, 0x11), f2);
+            x3 = _mm_xor_si128(_mm_clmulepi64_si128(x3, k1k2, 0x11), f3);
+            x4 = _mm_xor_si128(_mm_clmulepi64_si128(x4, k1k2, 0x11), f4);
+            x1 = _mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            x2 = _mm_xor_si128(x2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)));
+            x3 = _mm_xor_si128(x3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)));
+            x4 = _mm_xor_si128(x4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)));
+            p += 64;
+            n -= 64;
+        }
+
+        // Четыре аккумулятора — в один, затем оставшиеся 16‑байтные блоки.
+        const __m128i next[3] = { x2, x3, x4 };
+        for (const __m128i& x : next) {
+            const __m128i f = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x), f);
+        }
+        while (n >= 16) {
+            const __m128i f = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), f);
+            x1 = _mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            p += 16;
+            n -= 16;
+        }
+
+        // 128 -> 64 бита.
+        __m128i t = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+        t = _mm_srli_si128(x1, 4);
+        x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, low32), k5, 0x00), t);
+
+        // Редукция Барретта до 32 бит.
+        t = _mm_clmulepi64_si128(_mm_and_si128(x1, low32), poly_mu, 0x10);
+        t = _mm_clmulepi64_si128(_mm_and_si128(t, low32), poly_mu, 0x00);
+        x1 = _mm_xor_si128(x1, t);
+        return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+    }
+#endif
+
+    using CrcFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+    using CombineFunction = uint32_t (*)(uint32_t, uint32_t, uint64_t);
+
+    /// CRC сегментов размером с буфер пула параллельно, затем combine по порядку.
+    std::string crc_file(const std::string& filepath, unsigned threads, CrcFunction crc, CombineFunction merge) {
+        RandomAccessFile file(filepath);
+        if (!file.is_open()) return "";
+        const uint64_t size = file.size();
+        const size_t segment = buffer_pool::buffer_size();
+        const size_t count = static_cast<size_t>((size + segment - 1) / segment);
+
+        std::vector<uint32_t> crcs(count);
+        std::atomic<bool> ok(true);
+        parallel_for(count, [&](size_t i) {
+            const uint64_t offset = static_cast<uint64_t>(i) * segment;
+            const size_t n = static_cast<size_t>(std::min<uint64_t>(segment, size - offset));
+            buffer_pool::Buffer buffer = buffer_pool::acquire();
+            if (file.read_at(offset, buffer.data(), n) != static_cast<int64_t>(n)) {
+                ok = false;
+                return;
+            }
+            crcs[i] = crc(0, buffer.data(), n);
+        }, threads);
+        if (!ok) return "";
+
+        uint32_t total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t offset = static_cast<uint64_t>(i) * segment;
+            total = merge(total, crcs[i], std::min<uint64_t>(segment, size - offset));
+        }
+        uint8_t out[4];
+        store_be32(out, total);
+        return to_hex(out, sizeof(out));
+    }
+}
+
+uint32_t crc32c(uint32_t crc, const uint8_t* data, size_t size) {
+#ifdef HASH_X86_SIMD
+    if (cpu_has_sse42()) return ~crc32c_sse42(~crc, data, size);
+#endif
+    return ~crc_portable(tables_for(POLY_CASTAGNOLI), ~crc, data, size);
+}
+
+uint32_t crc32_ieee(uint32_t crc, const uint8_t* data, size_t size) {
+    uint32_t c = ~crc;
+#ifdef HASH_X86_SIMD
+    if (size >= 64 && cpu_has_pclmul() && cpu_has_sse41()) {
+        const size_t folded = size & ~static_cast<size_t>(15);
+        c = crc32_pclmul(c, data, folded);
+        data += folded;
+        size -= folded;
+    }
+#endif
+    return ~crc_portable(tables_for(POLY_IEEE), c, data, size);
+}
+
+uint32_t crc32c_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b) {
+    return combine(POLY_CASTAGNOLI, crc_a, crc_b, len_b);
+}
+
+uint32_t crc32_ieee_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b) {
+    return combine(POLY_IEEE, crc_a, crc_b, len_b);
+}
+
+std::string crc32c_file(const std::string& filepath, unsigned threads) {
+    return crc_file(filepath, threads, crc32c, crc32c_combine);
+}
+
+std::string crc32_file(const std::string& filepath, unsigned threads) {
+    return crc_file(filepath, threads, crc32_ieee, crc32_ieee_combine);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file etag.cpp
+ * @brief Вычисление и проверка ETag составных (multipart) объектов S3.
+ */
+
+#include "../include/etag.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/file_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace {
+    /// ETag вида "<md5 от MD5 частей>-N" (в том числе для одной части).
+    std::string multipart_etag(const RandomAccessFile& file, uint64_t part_size, unsigned threads) {
+        std::vector<std::string> digests;
+        if (!digest_chunks("md5", file, part_size, digests, threads)) return "";
+
+        Md5Context ctx;
+        md5_init(ctx);
+        for (const std::string& d : digests)
+            md5_update(ctx, reinterpret_cast<const uint8_t*>(d.data()), d.size());
+        uint8_t digest[16];
+        md5_final(ctx, digest);
+        return to_hex(digest, sizeof(digest)) + "-" + std::to_string(digests.size());
+    }
+}
+
+std::string s3_etag(const std::string& filepath, uint64_t part_size, unsigned threads) {
+    if (part_size == 0) return "";
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return "";
+    if (file.size() <= part_size) return md5_file(filepath);
+    return multipart_etag(file, part_size, threads);
+}
+
+bool verify_s3_etag(const std::string& filepath, const std::string& expected, uint64_t* part_size) {
+    std::string etag = expected;
+    etag.erase(std::remove(etag.begin(), etag.end(), '"'), etag.end());
+    std::transform(etag.begin(), etag.end(), etag.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return false;
+    const uint64_t size = file.size();
+
+    size_t dash = etag.find('-');
+    if (dash == std::string::npos) {
+        if (md5_file(filepath) != etag) return false;
+        if (part_size) *part_size = size;
+        return true;
+    }
+
+    uint64_t parts = 0;
+    for (size_t i = dash + 1; i < etag.size(); ++i) {
+        if (etag[i] < '0' || etag[i] > '9') return false;
+        parts = parts * 10 + (etag[i] - '0');
+    }
+    if (parts == 0 || dash + 1 == etag.size()) return false;
+
+    const uint64_t MiB = 1ull << 20;
+    std::vector<uint64_t> candidates;
+    for (uint64_t mib : { 8, 5, 16, 15, 32, 25, 50, 64, 100, 128, 256, 512, 1024 })
+        candidates.push_back(mib * MiB);
+    uint64_t minimal = (size + parts - 1) / parts;
+    candidates.push_back((minimal + MiB - 1) / MiB * MiB);
+    candidates.push_back(minimal);
+
+    std::vector<uint64_t> tried;
+    for (uint64_t candidate : candidates) {
+        if (candidate == 0 || std::max<uint64_t>(1, (size + candidate - 1) / candidate) != parts) continue;
+        if (std::find(tried.begin(), tried.end(), candidate) != tried.end()) continue;
+        tried.push_back(candidate);
+        if (multipart_etag(file, candidate, 0) == etag) {
+            if (part_size) *part_size = candidate;
+            return true;
+        }
+    }
+    return false;
+}
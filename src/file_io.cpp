@@ -0,0 +1,120 @@
+/**
+ * @file file_io.cpp
+ * @brief Чтение файлов порциями через общий пул буферов.
+ */
+
+#include "../include/file_io.h"
+#include "../include/buffer_pool.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool read_file_chunks(const std::string& filepath, const ChunkSink& sink) {
+    std::ifstream file;
+    // Собственный буфер потока не нужен: читаем сразу в буфер пула.
+    file.rdbuf()->pubsetbuf(nullptr, 0);
+    file.open(filepath, std::ios::binary);
+    if (!file) return false;
+
+    buffer_pool::Buffer buffer = buffer_pool::acquire();
+    char* data = reinterpret_cast<char*>(buffer.data());
+    while (file) {
+        file.read(data, buffer.size());
+        std::streamsize got = file.gcount();
+        if (got > 0) sink(buffer.data(), static_cast<size_t>(got));
+    }
+    return file.eof();
+}
+
+#ifdef _WIN32
+RandomAccessFile::RandomAccessFile(const std::string& filepath) {
+    handle_ = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                          nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+}
+
+RandomAccessFile::~RandomAccessFile() {
+    if (is_open()) CloseHandle(handle_);
+}
+
+bool RandomAccessFile::is_open() const {
+    return handle_ != INVALID_HANDLE_VALUE;
+}
+
+uint64_t RandomAccessFile::size() const {
+    LARGE_INTEGER size;
+    if (!is_open() || !GetFileSizeEx(handle_, &size)) return 0;
+    return static_cast<uint64_t>(size.QuadPart);
+}
+
+int64_t RandomAccessFile::read_at(uint64_t offset, uint8_t* buffer, size_t size) const {
+    OVERLAPPED ov = {};
+    ov.Offset = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD got = 0;
+    DWORD want = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+    if (!ReadFile(handle_, buffer, want, &got, &ov))
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    return got;
+}
+#else
+RandomAccessFile::RandomAccessFile(const std::string& filepath) {
+    fd_ = open(filepath.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd_ >= 0 && (fstat(fd_, &st) != 0 || S_ISDIR(st.st_mode))) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+RandomAccessFile::~RandomAccessFile() {
+    if (is_open()) close(fd_);
+}
+
+bool RandomAccessFile::is_open() const {
+    return fd_ >= 0;
+}
+
+uint64_t RandomAccessFile::size() const {
+    struct stat st;
+    if (!is_open() || fstat(fd_, &st) != 0) return 0;
+    return static_cast<uint64_t>(st.st_size);
+}
+
+int64_t RandomAccessFile::read_at(uint64_t offset, uint8_t* buffer, size_t size) const {
+    ssize_t got;
+    do {
+        got = pread(fd_, buffer, size, static_cast<off_t>(offset));
+    } while (got < 0 && errno == EINTR);
+    return got;
+}
+#endif
+
+bool RandomAccessFile::read_range(uint64_t offset, uint64_t length, const ChunkSink& sink) const {
+    if (!is_open()) return false;
+    if (length == 0) return true;
+
+    buffer_pool::Buffer buffer = buffer_pool::acquire();
+    while (length > 0) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(length, buffer.size()));
+        int64_t got = read_at(offset, buffer.data(), want);
+        if (got <= 0) return false;
+        sink(buffer.data(), static_cast<size_t>(got));
+        offset += static_cast<uint64_t>(got);
+        length -= static_cast<uint64_t>(got);
+    }
+    return true;
+}
+
+bool read_file_range(const std::string& filepath, uint64_t offset, uint64_t length, const ChunkSink& sink) {
+    RandomAccessFile file(filepath);
+    return file.read_range(offset, length, sink);
+}
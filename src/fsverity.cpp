@@ -0,0 +1,158 @@
+/**
+ * @file fsverity.cpp
+ * @brief Дайджест fs-verity: измерение ядра и вычисление в userspace.
+ */
+
+#include "../include/fsverity.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/parallel.h"
+#include "../include/buffer_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/fsverity.h>)
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/fsverity.h>
+#define HAVE_FS_VERITY 1
+#endif
+#endif
+
+namespace {
+    using Digest = std::array<uint8_t, 32>;
+
+    constexpr uint8_t LOG_BLOCK_SIZE = 12;
+    constexpr uint8_t HASH_ALG_SHA256 = 1;
+    constexpr size_t HASHES_PER_BLOCK = FSVERITY_BLOCK_SIZE / 32;
+
+    Digest hash_block(const uint8_t* data, size_t size) {
+        static const uint8_t zeros[FSVERITY_BLOCK_SIZE] = {};
+        Sha256Context ctx;
+        sha256_init(ctx);
+        sha256_update(ctx, data, size);
+        sha256_update(ctx, zeros, FSVERITY_BLOCK_SIZE - size);
+        Digest d;
+        sha256_final(ctx, d.data());
+        return d;
+    }
+
+    /**
+     * @brief Уровни дерева над потоком хешей блоков данных.
+     *
+     * На уровне копится не больше 128 хешей: заполненный блок сразу
+     * хешируется на уровень выше, поэтому память — O(глубина × 128 хешей),
+     * а не хеш на каждый блок файла.
+     */
+    class LevelStack {
+    public:
+        void push(const Digest& digest, size_t level = 0) {
+            if (levels_.size() <= level) levels_.resize(level + 1);
+            std::vector<Digest>& pending = levels_[level];
+            pending.push_back(digest);
+            if (pending.size() == HASHES_PER_BLOCK) {
+                const Digest up = hash_block(pending[0].data(), FSVERITY_BLOCK_SIZE);
+                pending.clear();
+                push(up, level + 1);
+            }
+        }
+
+        /// Корень: неполные блоки снизу вверх дополняются нулями; нужен хотя бы один push().
+        Digest root() {
+            for (size_t level = 0;; ++level) {
+                std::vector<Digest>& pending = levels_[level];
+                if (level + 1 == levels_.size() && pending.size() == 1) return pending[0];
+                if (pending.empty()) continue;
+                const Digest up = hash_block(pending[0].data(), pending.size() * 32);
+                pending.clear();
+                push(up, level + 1);
+            }
+        }
+
+    private:
+        std::vector<std::vector<Digest>> levels_;
+    };
+}
+
+std::string fsverity_compute(const std::string& filepath, unsigned threads) {
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return "";
+
+    const uint64_t size = file.size();
+    const uint64_t blocks = (size + FSVERITY_BLOCK_SIZE - 1) / FSVERITY_BLOCK_SIZE;
+
+    // Задача читает столько блоков, сколько помещается в буфер пула; файл идёт
+    // пачками по 4 задачи на поток, и хеши пачки сразу уходят в LevelStack.
+    const uint64_t per_task = std::max<uint64_t>(1, buffer_pool::buffer_size() / FSVERITY_BLOCK_SIZE);
+    const uint64_t batch = per_task * 4 * (threads ? threads : worker_count());
+    std::vector<Digest> leaves(static_cast<size_t>(std::min(batch, blocks)));
+    LevelStack tree;
+    std::atomic<bool> ok(true);
+    for (uint64_t base = 0; base < blocks && ok; base += batch) {
+        const uint64_t in_batch = std::min(batch, blocks - base);
+        parallel_for((in_batch + per_task - 1) / per_task, [&](size_t task) {
+            const uint64_t first = task * per_task;
+            const uint64_t count = std::min(per_task, in_batch - first);
+            const uint64_t offset = (base + first) * FSVERITY_BLOCK_SIZE;
+            const size_t length = static_cast<size_t>(std::min(count * FSVERITY_BLOCK_SIZE, size - offset));
+            buffer_pool::Buffer buffer = buffer_pool::acquire();
+            if (file.read_at(offset, buffer.data(), length) != static_cast<int64_t>(length)) {
+                ok = false;
+                return;
+            }
+            for (uint64_t b = 0; b < count; ++b) {
+                uint64_t start = b * FSVERITY_BLOCK_SIZE;
+                leaves[first + b] = hash_block(buffer.data() + start, static_cast<size_t>(std::min<uint64_t>(FSVERITY_BLOCK_SIZE, length - start)));
+            }
+        }, threads);
+        for (uint64_t i = 0; i < in_batch; ++i) tree.push(leaves[i]);
+    }
+    if (!ok) return "";
+
+    // Пустой файл: дерева нет, корень — нули.
+    const Digest root = blocks ? tree.root() : Digest{};
+
+    uint8_t descriptor[256] = {};
+    descriptor[0] = 1;
+    descriptor[1] = HASH_ALG_SHA256;
+    descriptor[2] = LOG_BLOCK_SIZE;
+    store_le64(descriptor + 8, size);
+    std::memcpy(descriptor + 16, root.data(), root.size());
+
+    Digest digest;
+    Sha256Context ctx;
+    sha256_init(ctx);
+    sha256_update(ctx, descriptor, sizeof(descriptor));
+    sha256_final(ctx, digest.data());
+    return to_hex(digest.data(), digest.size());
+}
+
+std::string fsverity_measure(const std::string& filepath) {
+#ifdef HAVE_FS_VERITY
+    int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return "";
+    alignas(struct fsverity_digest) uint8_t raw[sizeof(struct fsverity_digest) + 64] = {};
+    struct fsverity_digest* d = reinterpret_cast<struct fsverity_digest*>(raw);
+    d->digest_size = 64;
+    int rc = ::ioctl(fd, FS_IOC_MEASURE_VERITY, d);
+    ::close(fd);
+    if (rc != 0 || d->digest_algorithm != FS_VERITY_HASH_ALG_SHA256 || d->digest_size != 32) return "";
+    return to_hex(d->digest, d->digest_size);
+#else
+    (void)filepath;
+    return "";
+#endif
+}
+
+std::string fsverity_digest(const std::string& filepath, unsigned threads, bool* measured) {
+    std::string digest = fsverity_measure(filepath);
+    if (measured) *measured = !digest.empty();
+    return digest.empty() ? fsverity_compute(filepath, threads) : digest;
+}
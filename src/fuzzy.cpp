@@ -0,0 +1,255 @@
+/**
+ * @file fuzzy.cpp
+ * @brief Нечёткое хеширование CTPH (ssdeep) и сравнение подписей.
+ */
+
+#include "../include/fuzzy.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/file_io.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+
+#include <algorithm>
+#include <charconv>
+#include <memory>
+
+namespace {
+    const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    constexpr uint32_t MIN_BLOCKSIZE = 3;
+    constexpr uint8_t HASH_INIT = 0x27;
+    constexpr size_t SPAMSUM_LENGTH = 64;
+    constexpr size_t ROLLING_WINDOW = 7;
+
+    /// FNV‑1 (простое 0x01000193) по модулю 64: в подпись идут только 6 младших бит.
+    inline uint8_t sum_hash(uint8_t c, uint8_t h) {
+        return static_cast<uint8_t>(((h * 0x13u) ^ c) & 0x3f);
+    }
+
+    inline uint64_t block_size(unsigned index) {
+        return static_cast<uint64_t>(MIN_BLOCKSIZE) << index;
+    }
+
+    struct Signature {
+        uint64_t block_size = 0;
+        std::string first, second;
+    };
+
+    /// Последовательности из более чем трёх одинаковых символов сокращаются до трёх.
+    std::string eliminate_sequences(const std::string& s) {
+        std::string out;
+        for (size_t i = 0; i < s.size(); ++i) {
+            if (i < 3 || s[i] != s[i - 1] || s[i] != s[i - 2] || s[i] != s[i - 3]) out += s[i];
+        }
+        return out;
+    }
+
+    bool parse(const std::string& text, Signature& sig) {
+        size_t colon1 = text.find(':');
+        if (colon1 == std::string::npos || colon1 == 0) return false;
+        size_t colon2 = text.find(':', colon1 + 1);
+        if (colon2 == std::string::npos) return false;
+        // Только цифры и без переполнения: std::stoull бросил бы исключение на длинном поле.
+        const std::from_chars_result r = std::from_chars(text.data(), text.data() + colon1, sig.block_size);
+        if (r.ec != std::errc() || r.ptr != text.data() + colon1) return false;
+        sig.first = text.substr(colon1 + 1, colon2 - colon1 - 1);
+        sig.second = text.substr(colon2 + 1, text.find(',', colon2) - colon2 - 1);
+        if (sig.first.size() > SPAMSUM_LENGTH || sig.second.size() > SPAMSUM_LENGTH) return false;
+        sig.first = eliminate_sequences(sig.first);
+        sig.second = eliminate_sequences(sig.second);
+        return true;
+    }
+
+    bool has_common_substring(const std::string& a, const std::string& b) {
+        if (a.size() < ROLLING_WINDOW || b.size() < ROLLING_WINDOW) return false;
+        for (size_t i = 0; i + ROLLING_WINDOW <= a.size(); ++i)
+            if (b.find(a.substr(i, ROLLING_WINDOW)) != std::string::npos) return true;
+        return false;
+    }
+
+    /// Расстояние редактирования: вставка и удаление — 1, замена — 2.
+    uint32_t edit_distance(const std::string& a, const std::string& b) {
+        std::vector<uint32_t> prev(b.size() + 1), cur(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); ++j) prev[j] = static_cast<uint32_t>(j);
+        for (size_t i = 1; i <= a.size(); ++i) {
+            cur[0] = static_cast<uint32_t>(i);
+            for (size_t j = 1; j <= b.size(); ++j) {
+                uint32_t replace = prev[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 2);
+                cur[j] = std::min({ prev[j] + 1, cur[j - 1] + 1, replace });
+            }
+            prev.swap(cur);
+        }
+        return prev[b.size()];
+    }
+
+    uint32_t score_strings(const std::string& a, const std::string& b, uint64_t block) {
+        if (!has_common_substring(a, b)) return 0;
+        uint32_t score = edit_distance(a, b);
+        score = score * SPAMSUM_LENGTH / static_cast<uint32_t>(a.size() + b.size());
+        score = 100 * score / SPAMSUM_LENGTH;
+        if (score >= 100) return 0;
+        score = 100 - score;
+        // Для малых блоков совпадение коротких подписей мало о чём говорит.
+        if (block >= (99 + ROLLING_WINDOW) / ROLLING_WINDOW * MIN_BLOCKSIZE) return score;
+        uint64_t cap = block / MIN_BLOCKSIZE * std::min(a.size(), b.size());
+        return static_cast<uint32_t>(std::min<uint64_t>(score, cap));
+    }
+}
+
+FuzzyHasher::FuzzyHasher() {
+    bh_[0].h = bh_[0].halfh = HASH_INIT;
+    bh_[0].digest[0] = '\0';
+    bh_[0].halfdigest = '\0';
+    bh_[0].dlen = 0;
+}
+
+void FuzzyHasher::update(const uint8_t* data, size_t size) {
+    total_size_ += size;
+    for (size_t i = 0; i < size; ++i) step(data[i]);
+}
+
+void FuzzyHasher::try_fork() {
+    if (bhend_ >= NUM_BLOCKHASHES) return;
+    BlockHash& next = bh_[bhend_];
+    next.h = bh_[bhend_ - 1].h;
+    next.halfh = bh_[bhend_ - 1].halfh;
+    next.digest[0] = '\0';
+    next.halfdigest = '\0';
+    next.dlen = 0;
+    ++bhend_;
+}
+
+void FuzzyHasher::try_reduce() {
+    // Отбрасывает наименьший размер блока, если итог его уже точно не выберет;
+    // на результат не влияет, только сокращает работу на байт.
+    if (bhend_ - bhstart_ < 2) return;
+    if (block_size(bhstart_) * SPAMSUM_LENGTH >= total_size_) return;
+    if (bh_[bhstart_ + 1].dlen < SPAMSUM_LENGTH / 2) return;
+    ++bhstart_;
+}
+
+void FuzzyHasher::step(uint8_t c) {
+    h2_ -= h1_;
+    h2_ += ROLLING_WINDOW * static_cast<uint32_t>(c);
+    h1_ += c;
+    h1_ -= window_[n_];
+    window_[n_] = c;
+    if (++n_ == ROLLING_WINDOW) n_ = 0;
+    h3_ = (h3_ << 5) ^ c;
+    const uint32_t h = h1_ + h2_ + h3_;
+
+    for (unsigned i = bhstart_; i < bhend_; ++i) {
+        bh_[i].h = sum_hash(c, bh_[i].h);
+        bh_[i].halfh = sum_hash(c, bh_[i].halfh);
+    }
+    for (unsigned i = bhstart_; i < bhend_; ++i) {
+        // Размеры блоков кратны друг другу: если граница не сработала для i,
+        // она не сработает и для больших.
+        if (h % block_size(i) != block_size(i) - 1) break;
+        if (bh_[i].dlen == 0) try_fork();
+        BlockHash& b = bh_[i];
+        b.digest[b.dlen] = B64[b.h];
+        b.halfdigest = B64[b.halfh];
+        if (b.dlen < SPAMSUM_LENGTH - 1) {
+            // Пока есть место, кусок закрывается; последний символ
+            // подписи накрывает весь остаток данных.
+            b.digest[++b.dlen] = '\0';
+            b.h = HASH_INIT;
+            if (b.dlen < SPAMSUM_LENGTH / 2) {
+                b.halfh = HASH_INIT;
+                b.halfdigest = '\0';
+            }
+        } else {
+            try_reduce();
+        }
+    }
+}
+
+std::string FuzzyHasher::digest() const {
+    const uint32_t h = h1_ + h2_ + h3_;
+    unsigned bi = bhstart_;
+    while (block_size(bi) * SPAMSUM_LENGTH < total_size_) {
+        if (++bi >= NUM_BLOCKHASHES) return "";
+    }
+    if (bi >= bhend_) bi = bhend_ - 1;
+    while (bi > bhstart_ && bh_[bi].dlen < SPAMSUM_LENGTH / 2) --bi;
+
+    std::string result = std::to_string(block_size(bi)) + ":";
+    const BlockHash& b = bh_[bi];
+    result.append(b.digest, b.dlen);
+    if (h != 0) result += B64[b.h];
+    else if (b.digest[b.dlen] != '\0') result += b.digest[b.dlen];
+    result += ':';
+
+    if (bi < bhend_ - 1) {
+        const BlockHash& d = bh_[bi + 1];
+        result.append(d.digest, std::min<unsigned>(d.dlen, SPAMSUM_LENGTH / 2 - 1));
+        if (h != 0) result += B64[d.halfh];
+        else if (d.halfdigest != '\0') result += d.halfdigest;
+    } else if (h != 0) {
+        result += B64[b.h];
+    }
+    return result;
+}
+
+int fuzzy_compare(const std::string& a, const std::string& b) {
+    Signature s1, s2;
+    if (!parse(a, s1) || !parse(b, s2)) return -1;
+    if (s1.block_size != s2.block_size && s1.block_size != 2 * s2.block_size && s2.block_size != 2 * s1.block_size)
+        return 0;
+    if (s1.block_size == s2.block_size && s1.first == s2.first && s1.second == s2.second) return 100;
+
+    if (s1.block_size == s2.block_size) {
+        return static_cast<int>(std::max(score_strings(s1.first, s2.first, s1.block_size),
+                                         score_strings(s1.second, s2.second, s1.block_size * 2)));
+    }
+    if (s1.block_size == 2 * s2.block_size) return static_cast<int>(score_strings(s1.first, s2.second, s1.block_size));
+    return static_cast<int>(score_strings(s1.second, s2.first, s2.block_size));
+}
+
+bool fuzzy_hash_file(const std::string& filepath, const std::vector<std::string>& algos,
+                     std::vector<std::string>& digests, std::string& fuzzy) {
+    digests.clear();
+    fuzzy.clear();
+    std::vector<std::unique_ptr<Hasher>> hashers;
+    for (const std::string& algo : algos) {
+        hashers.push_back(make_hasher(algo));
+        if (!hashers.back()) return false;
+    }
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return false;
+
+    FuzzyHasher ctph;
+    const uint64_t size = file.size();
+    bool ok = true;
+    {
+        // Исполнитель на каждого потребителя: порции идут каждому по порядку,
+        // а разные хеши считаются параллельно; буфер вернётся в пул после всех.
+        SerialExecutor fuzzy_executor;
+        std::vector<std::unique_ptr<SerialExecutor>> executors;
+        for (size_t i = 0; i < hashers.size(); ++i) executors.push_back(std::make_unique<SerialExecutor>());
+
+        for (uint64_t pos = 0; pos < size; ) {
+            auto buffer = std::make_shared<buffer_pool::Buffer>(buffer_pool::acquire());
+            size_t want = static_cast<size_t>(std::min<uint64_t>(size - pos, buffer->size()));
+            int64_t got = file.read_at(pos, buffer->data(), want);
+            if (got <= 0) { ok = false; break; }
+            size_t n = static_cast<size_t>(got);
+            fuzzy_executor.submit([&ctph, buffer, n] { ctph.update(buffer->data(), n); });
+            for (size_t i = 0; i < hashers.size(); ++i) {
+                Hasher* hasher = hashers[i].get();
+                executors[i]->submit([hasher, buffer, n] { hasher->update(buffer->data(), n); });
+            }
+            pos += n;
+        }
+    }
+    if (!ok) return false;
+
+    for (std::unique_ptr<Hasher>& hasher : hashers) {
+        std::string digest = hasher->digest();
+        digests.push_back(to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size()));
+    }
+    fuzzy = ctph.digest();
+    return true;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file git_hash.cpp
+ * @brief Идентификаторы git‑объектов (blob и tree) без вызова git.
+ */
+
+#include "../include/git_hash.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/file_io.h"
+#include "../include/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <map>
+
+namespace fs = std::filesystem;
+
+namespace {
+    /// Хеш git‑объекта по заголовку "<type> <size>\0" и телу (бинарный).
+    std::string object_id(const std::string& algo, const std::string& type, const std::string& body) {
+        std::unique_ptr<Hasher> hasher = make_hasher(algo);
+        std::string header = type + " " + std::to_string(body.size()) + '\0';
+        hasher->update(reinterpret_cast<const uint8_t*>(header.data()), header.size());
+        hasher->update(reinterpret_cast<const uint8_t*>(body.data()), body.size());
+        return hasher->digest();
+    }
+
+    bool blob_id(const std::string& algo, const fs::path& path, std::string& id) {
+        std::error_code ec;
+        uint64_t size = fs::file_size(path, ec);
+        if (ec) return false;
+        std::unique_ptr<Hasher> hasher = make_hasher(algo);
+        std::string header = "blob " + std::to_string(size) + '\0';
+        hasher->update(reinterpret_cast<const uint8_t*>(header.data()), header.size());
+        RandomAccessFile file(path.string());
+        if (!file.read_range(0, size, [&](const uint8_t* data, size_t n) { hasher->update(data, n); }))
+            return false;
+        id = hasher->digest();
+        return true;
+    }
+
+    struct Entry {
+        std::string name;
+        std::string mode;   ///< "100644", "100755", "120000" или "40000".
+        fs::path path;
+        size_t dir = 0;     ///< Для каталога — индекс в списке каталогов.
+        std::string id;     ///< Бинарный идентификатор; пусто у пустого каталога.
+    };
+
+    struct Dir {
+        size_t depth;
+        std::vector<Entry> entries;
+        std::string id;
+    };
+
+    bool walk(const fs::path& path, size_t depth, std::vector<Dir>& dirs, size_t index) {
+        std::error_code ec;
+        for (fs::directory_iterator it(path, ec), end; it != end && !ec; it.increment(ec)) {
+            std::string name = it->path().filename().string();
+            if (name == ".git") continue;
+            fs::file_status st = it->symlink_status(ec);
+            if (ec) return false;
+
+            Entry e;
+            e.name = name;
+            e.path = it->path();
+            if (fs::is_symlink(st)) {
+                e.mode = "120000";
+            } else if (fs::is_directory(st)) {
+                e.mode = "40000";
+                e.dir = dirs.size();
+                dirs.push_back({ depth + 1, {}, "" });
+                if (!walk(e.path, depth + 1, dirs, e.dir)) return false;
+            } else if (fs::is_regular_file(st)) {
+                bool exec = (st.permissions() & fs::perms::owner_exec) != fs::perms::none;
+                e.mode = exec ? "100755" : "100644";
+            } else {
+                continue;
+            }
+            dirs[index].entries.push_back(e);
+        }
+        return !ec;
+    }
+}
+
+std::string git_blob_id(const std::string& filepath, const std::string& algo) {
+    if (algo != "sha1" && algo != "sha256") return "";
+    std::string id;
+    if (!blob_id(algo, filepath, id)) return "";
+    return to_hex(reinterpret_cast<const uint8_t*>(id.data()), id.size());
+}
+
+std::string git_tree_id(const std::string& dirpath, const std::string& algo, unsigned threads) {
+    if (algo != "sha1" && algo != "sha256") return "";
+    std::error_code ec;
+    if (!fs::is_directory(dirpath, ec)) return "";
+
+    std::vector<Dir> dirs = { { 0, {}, "" } };
+    if (!walk(dirpath, 0, dirs, 0)) return "";
+
+    // Все файлы и ссылки всего дерева — одним параллельным проходом.
+    std::vector<Entry*> leaves;
+    for (Dir& d : dirs)
+        for (Entry& e : d.entries)
+            if (e.mode != "40000") leaves.push_back(&e);
+    std::atomic<bool> ok(true);
+    parallel_for(leaves.size(), [&](size_t i) {
+        Entry& e = *leaves[i];
+        if (e.mode == "120000") {
+            std::error_code link_ec;
+            std::string target = fs::read_symlink(e.path, link_ec).generic_string();
+            if (link_ec) ok = false;
+            else e.id = object_id(algo, "blob", target);
+        } else if (!blob_id(algo, e.path, e.id)) {
+            ok = false;
+        }
+    }, threads);
+    if (!ok) return "";
+
+    // Деревья: от самых глубоких каталогов к корню, каталоги одного уровня параллельно.
+    std::map<size_t, std::vector<size_t>, std::greater<size_t>> levels;
+    for (size_t i = 0; i < dirs.size(); ++i) levels[dirs[i].depth].push_back(i);
+    for (auto& level : levels) {
+        parallel_for(level.second.size(), [&](size_t k) {
+            Dir& d = dirs[level.second[k]];
+            std::vector<std::pair<std::string, const Entry*>> sorted;
+            for (Entry& e : d.entries) {
+                if (e.mode == "40000") {
+                    e.id = dirs[e.dir].id;
+                    if (e.id.empty()) continue;  // git не хранит пустые каталоги
+                    sorted.emplace_back(e.name + "/", &e);
+                } else {
+                    sorted.emplace_back(e.name, &e);
+                }
+            }
+            if (sorted.empty() && level.first > 0) return;
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+            std::string body;
+            for (const auto& item : sorted)
+                body += item.second->mode + " " + item.second->name + '\0' + item.second->id;
+            d.id = object_id(algo, "tree", body);
+        }, threads);
+    }
+    return to_hex(reinterpret_cast<const uint8_t*>(dirs[0].id.data()), dirs[0].id.size());
+}
@@ -1,14 +1,89 @@
 /**
  * @file hash.cpp
- * @brief Реализация алгоритмов хеширования MD5, SHA-1 и SHA-256 для проверки целостности файлов.
+ * @brief Реализация алгоритмов хеширования MD5, SHA-1, SHA-256 и семейства SHA-512 для проверки целостности файлов.
  */
 
 #include "../include/hash.h"
+#include "../include/md_engine.h"
+#include "../include/file_io.h"
+#include "../include/cpu_features.h"
+#include "../include/byte_order.h"
+
+#include <cstring>
+#include <utility>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#ifdef HASH_X86_SIMD
+HASH_AVX512_WARNINGS_PUSH
+namespace {
+    /**
+     * @brief Транспонирует матрицу 16×16 32‑битных слов: строка i — блок
+     *        потока i, после — слово i всех шестнадцати потоков.
+     *
+     * Перестановки внутри 128‑битных частей (unpack), затем между ними
+     * (shuffle_i32x4): 64 инструкции вместо 16 сборок gather на слово.
+     */
+    __attribute__((target("avx512f")))
+    inline void transpose16(__m512i r[16]) {
+        __m512i t[16], u[16];
+        for (int i = 0; i < 8; ++i) {
+            t[2 * i] = _mm512_unpacklo_epi32(r[2 * i], r[2 * i + 1]);
+            t[2 * i + 1] = _mm512_unpackhi_epi32(r[2 * i], r[2 * i + 1]);
+        }
+        for (int i = 0; i < 4; ++i) {
+            u[4 * i] = _mm512_unpacklo_epi64(t[4 * i], t[4 * i + 2]);
+            u[4 * i + 1] = _mm512_unpackhi_epi64(t[4 * i], t[4 * i + 2]);
+            u[4 * i + 2] = _mm512_unpacklo_epi64(t[4 * i + 1], t[4 * i + 3]);
+            u[4 * i + 3] = _mm512_unpackhi_epi64(t[4 * i + 1], t[4 * i + 3]);
+        }
+        // u[4i + j], 128‑битная часть k — слово 4k + j строк 4i..4i+3.
+        for (int j = 0; j < 4; ++j) {
+            const __m512i v = _mm512_shuffle_i32x4(u[j], u[4 + j], 0x88);
+            const __m512i w = _mm512_shuffle_i32x4(u[j], u[4 + j], 0xDD);
+            const __m512i v2 = _mm512_shuffle_i32x4(u[8 + j], u[12 + j], 0x88);
+            const __m512i w2 = _mm512_shuffle_i32x4(u[8 + j], u[12 + j], 0xDD);
+            r[j] = _mm512_shuffle_i32x4(v, v2, 0x88);
+            r[4 + j] = _mm512_shuffle_i32x4(w, w2, 0x88);
+            r[8 + j] = _mm512_shuffle_i32x4(v, v2, 0xDD);
+            r[12 + j] = _mm512_shuffle_i32x4(w, w2, 0xDD);
+        }
+    }
+
+    /// Слово i блока каждого из 16 потоков — в дорожку с номером потока.
+    __attribute__((target("avx512f")))
+    inline void load_x16(const uint8_t* const data[16], size_t offset, __m512i m[16]) {
+        for (int l = 0; l < 16; ++l) m[l] = _mm512_loadu_si512(data[l] + offset);
+        transpose16(m);
+    }
+
+    __attribute__((target("avx512f")))
+    inline void load_state_x16(const uint32_t* const H[16], int words, __m512i* state) {
+        alignas(64) uint32_t lanes[16];
+        for (int i = 0; i < words; ++i) {
+            for (int l = 0; l < 16; ++l) lanes[l] = H[l][i];
+            state[i] = _mm512_load_si512(lanes);
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void store_state_x16(uint32_t* const H[16], int words, const __m512i* state) {
+        alignas(64) uint32_t lanes[16];
+        for (int i = 0; i < words; ++i) {
+            _mm512_store_si512(lanes, state[i]);
+            for (int l = 0; l < 16; ++l) H[l][i] = lanes[l];
+        }
+    }
+}
+HASH_AVX512_WARNINGS_POP
+#endif
 
 
 // ======================= MD5 =======================
 namespace md5_internal {
-    const std::array<uint32_t, 64> K = {
+    constexpr std::array<uint32_t, 64> K = {
         0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
         0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
         0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
@@ -27,7 +102,7 @@ namespace md5_internal {
         0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
     };
 
-    const std::array<uint32_t, 64> S = {
+    constexpr std::array<uint32_t, 64> S = {
         7,12,17,22, 7,12,17,22, 7,12,17,22, 7,12,17,22,
         5, 9,14,20, 5, 9,14,20, 5, 9,14,20, 5, 9,14,20,
         4,11,16,23, 4,11,16,23, 4,11,16,23, 4,11,16,23,
@@ -39,111 +114,187 @@ namespace md5_internal {
     }
 
     void md5_transform(std::array<uint32_t, 4>& H, const std::array<uint8_t, 64>& block) {
-        uint32_t A = H[0], B = H[1], C = H[2], D = H[3], F, g, M[16];
-        for (int i = 0; i < 16; ++i)
-            M[i] = block[i*4] | (block[i*4+1] << 8) | (block[i*4+2] << 16) | (block[i*4+3] << 24);
-        for (int i = 0; i < 64; ++i) {
-            if (i < 16) { F = (B & C) | (~B & D); g = i; }
-            else if (i < 32) { F = (D & B) | (~D & C); g = (5*i + 1) % 16; }
-            else if (i < 48) { F = B ^ C ^ D; g = (3*i + 5) % 16; }
-            else { F = C ^ (B | ~D); g = (7*i) % 16; }
-            F += A + K[i] + M[g]; A = D; D = C; C = B; B += left_rotate(F, S[i]);
-        }
-        H[0] += A; H[1] += B; H[2] += C; H[3] += D;
+        md5_transform(H, block.data());
     }
-}
 
-std::string md5_file(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file) return "";
+    /// Индекс слова сообщения для шага i.
+    constexpr size_t message_index(size_t i) {
+        return i < 16 ? i : i < 32 ? (5*i + 1) % 16 : i < 48 ? (3*i + 5) % 16 : (7*i) % 16;
+    }
 
-    std::array<uint32_t, 4> H = {
-        0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476
-    };
+    /**
+     * @brief Шаг I: функция раунда, слово сообщения, K и S известны при компиляции.
+     *
+     * Регистры не переставляются: роль a на шаге I играет v[(4 - I) % 4],
+     * поэтому после 64 шагов v снова совпадает с (A, B, C, D).
+     */
+    template <size_t I>
+    inline void step(uint32_t (&v)[4], const uint32_t (&M)[16]) {
+        constexpr size_t r = I % 4;
+        uint32_t& a = v[(4 - r) % 4];
+        const uint32_t b = v[(5 - r) % 4], c = v[(6 - r) % 4], d = v[(7 - r) % 4];
+        uint32_t f;
+        if constexpr (I < 16) f = d ^ (b & (c ^ d));
+        else if constexpr (I < 32) f = c ^ (d & (b ^ c));
+        else if constexpr (I < 48) f = b ^ c ^ d;
+        else f = c ^ (b | ~d);
+        constexpr uint32_t s = S[I];
+        const uint32_t x = a + f + K[I] + M[message_index(I)];
+        a = b + ((x << s) | (x >> (32 - s)));
+    }
+
+    template <size_t... I>
+    inline void steps(uint32_t (&v)[4], const uint32_t (&M)[16], std::index_sequence<I...>) {
+        (step<I>(v, M), ...);
+    }
+
+    void md5_transform(std::array<uint32_t, 4>& H, const uint8_t* block) {
+        uint32_t M[16];
+        for (int i = 0; i < 16; ++i) M[i] = load_le32(block + 4*i);
+        uint32_t v[4] = { H[0], H[1], H[2], H[3] };
+        steps(v, M, std::make_index_sequence<64>{});
+        H[0] += v[0]; H[1] += v[1]; H[2] += v[2]; H[3] += v[3];
+    }
 
-    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    uint64_t original_size = data.size();
-    data.push_back(0x80);
-    while ((data.size() % 64) != 56) data.push_back(0x00);
-    uint64_t bit_len = original_size * 8;
-    for (int i = 0; i < 8; ++i)
-        data.push_back((bit_len >> (8 * i)) & 0xFF);
+#ifdef HASH_X86_SIMD
+HASH_AVX512_WARNINGS_PUSH
+    /**
+     * @brief Шестнадцать потоков MD5 в 32‑битных дорожках AVX‑512.
+     *
+     * Каждая из функций F, G, H, I — одна vpternlogd: F = b ? c : d,
+     * G = d ? b : c, H = b ^ c ^ d, I = c ^ (b | ~d); сдвиг — vprolvd.
+     */
+    __attribute__((target("avx512f")))
+    void transform_x16_avx512(std::array<uint32_t, 4>* const H[16], const uint8_t* const data[16], size_t blocks) {
+        uint32_t* h[16];
+        for (int l = 0; l < 16; ++l) h[l] = H[l]->data();
+        __m512i state[4];
+        load_state_x16(h, 4, state);
 
-    for (size_t i = 0; i < data.size(); i += 64) {
-        std::array<uint8_t, 64> block;
-        std::copy(data.begin() + i, data.begin() + i + 64, block.begin());
-        md5_internal::md5_transform(H, block);
+        for (size_t blk = 0; blk < blocks; ++blk) {
+            __m512i m[16];
+            load_x16(data, 64 * blk, m);
+            __m512i a = state[0], b = state[1], c = state[2], d = state[3];
+            for (int i = 0; i < 64; ++i) {
+                __m512i f;
+                int g;
+                if (i < 16) { f = _mm512_ternarylogic_epi32(b, c, d, 0xCA); g = i; }
+                else if (i < 32) { f = _mm512_ternarylogic_epi32(b, c, d, 0xE4); g = (5*i + 1) % 16; }
+                else if (i < 48) { f = _mm512_ternarylogic_epi32(b, c, d, 0x96); g = (3*i + 5) % 16; }
+                else { f = _mm512_ternarylogic_epi32(b, c, d, 0x39); g = (7*i) % 16; }
+                f = _mm512_add_epi32(_mm512_add_epi32(f, a),
+                                     _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(K[i])), m[g]));
+                a = d; d = c; c = b;
+                b = _mm512_add_epi32(b, _mm512_rolv_epi32(f, _mm512_set1_epi32(static_cast<int>(S[i]))));
+            }
+            state[0] = _mm512_add_epi32(state[0], a); state[1] = _mm512_add_epi32(state[1], b);
+            state[2] = _mm512_add_epi32(state[2], c); state[3] = _mm512_add_epi32(state[3], d);
+        }
+        store_state_x16(h, 4, state);
     }
+HASH_AVX512_WARNINGS_POP
+#endif
 
-    std::ostringstream result;
-    for (uint32_t h : H)
-        for (int i = 0; i < 4; ++i)
-            result << std::hex << std::setw(2) << std::setfill('0') << ((h >> (8 * i)) & 0xFF);
-    return result.str();
+    void md5_transform_x16(std::array<uint32_t, 4>* const H[16], const uint8_t* const data[16], size_t blocks) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx512f()) {
+            transform_x16_avx512(H, data, blocks);
+            return;
+        }
+#endif
+        for (int l = 0; l < 16; ++l)
+            for (size_t blk = 0; blk < blocks; ++blk)
+                md5_transform(*H[l], data[l] + 64 * blk);
+    }
 }
 
-// ======================= SHA1 =======================
-std::string sha1_file(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file) return "";
+std::string to_hex(const uint8_t* digest, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string result(size * 2, '0');
+    for (size_t i = 0; i < size; ++i) {
+        result[2*i] = digits[digest[i] >> 4];
+        result[2*i + 1] = digits[digest[i] & 0x0F];
+    }
+    return result;
+}
 
-    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    uint64_t original_size = data.size();
-    data.push_back(0x80);
-    while ((data.size() % 64) != 56) data.push_back(0x00);
-    uint64_t bit_len = original_size * 8;
-    for (int i = 0; i < 8; ++i)
-        data.push_back((bit_len >> (8 * (7 - i))) & 0xFF);
+// ======================= MD5 =======================
+void md5_init(Md5Context& ctx) {
+    Md5Engine::init(ctx);
+}
 
-    uint32_t h0 = 0x67452301, h1 = 0xEFCDAB89, h2 = 0x98BADCFE, h3 = 0x10325476, h4 = 0xC3D2E1F0;
+void md5_update(Md5Context& ctx, const uint8_t* data, size_t size) {
+    Md5Engine::update(ctx, data, size);
+}
 
-    for (size_t i = 0; i < data.size(); i += 64) {
-        uint32_t w[80] = {};
-        for (int t = 0; t < 16; ++t)
-            w[t] = (data[i + 4*t] << 24) | (data[i + 4*t + 1] << 16) | (data[i + 4*t + 2] << 8) | data[i + 4*t + 3];
-        for (int t = 16; t < 80; ++t)
-            w[t] = ((w[t-3] ^ w[t-8] ^ w[t-14] ^ w[t-16]) << 1) | ((w[t-3] ^ w[t-8] ^ w[t-14] ^ w[t-16]) >> 31);
+void md5_final(Md5Context& ctx, uint8_t digest[16]) {
+    Md5Engine::final(ctx, digest);
+}
 
-        uint32_t a = h0, b = h1, c = h2, d = h3, e = h4;
-        for (int t = 0; t < 80; ++t) {
-            uint32_t f, k;
-            if (t < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
-            else if (t < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
-            else if (t < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
-            else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+std::string md5_file(const std::string& filepath) {
+    return Md5Engine::file(filepath);
+}
 
-            uint32_t temp = ((a << 5) | (a >> 27)) + f + e + k + w[t];
-            e = d; d = c; c = (b << 30) | (b >> 2); b = a; a = temp;
+// ======================= SHA1 =======================
+namespace sha1_internal {
+    /**
+     * @brief Раунд T с расписанием в кольце из 16 слов.
+     *
+     * Роль a на раунде T играет v[(5 - T) % 5]; вместо сдвига регистров
+     * меняются только e (новое a) и b (поворот на 30).
+     */
+    template <size_t T>
+    inline void round(uint32_t (&v)[5], uint32_t (&w)[16]) {
+        constexpr size_t r = T % 5;
+        const uint32_t a = v[(5 - r) % 5], c = v[(7 - r) % 5], d = v[(8 - r) % 5];
+        uint32_t& b = v[(6 - r) % 5];
+        uint32_t& e = v[(9 - r) % 5];
+        if constexpr (T >= 16) {
+            const uint32_t x = w[(T - 3) % 16] ^ w[(T - 8) % 16] ^ w[(T - 14) % 16] ^ w[T % 16];
+            w[T % 16] = (x << 1) | (x >> 31);
         }
+        uint32_t f, k;
+        if constexpr (T < 20) { f = d ^ (b & (c ^ d)); k = 0x5A827999; }
+        else if constexpr (T < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+        else if constexpr (T < 60) { f = (b & c) | (d & (b | c)); k = 0x8F1BBCDC; }
+        else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+        e += ((a << 5) | (a >> 27)) + f + k + w[T % 16];
+        b = (b << 30) | (b >> 2);
+    }
 
-        h0 += a; h1 += b; h2 += c; h3 += d; h4 += e;
+    template <size_t... T>
+    inline void rounds(uint32_t (&v)[5], uint32_t (&w)[16], std::index_sequence<T...>) {
+        (round<T>(v, w), ...);
     }
 
-    std::ostringstream result;
-    for (uint32_t h : {h0, h1, h2, h3, h4})
-        result << std::hex << std::setw(8) << std::setfill('0') << h;
-    return result.str();
+    void sha1_transform(std::array<uint32_t, 5>& H, const uint8_t* block) {
+        uint32_t w[16];
+        for (int t = 0; t < 16; ++t) w[t] = load_be32(block + 4*t);
+        uint32_t v[5] = { H[0], H[1], H[2], H[3], H[4] };
+        rounds(v, w, std::make_index_sequence<80>{});
+        for (int i = 0; i < 5; ++i) H[i] += v[i];
+    }
 }
 
-// ======================= SHA256 =======================
-std::string sha256_file(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file) return "";
-
-    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    uint64_t original_size = data.size();
-    data.push_back(0x80);
-    while ((data.size() % 64) != 56) data.push_back(0x00);
-    uint64_t bit_len = original_size * 8;
-    for (int i = 0; i < 8; ++i)
-        data.push_back((bit_len >> (8 * (7 - i))) & 0xFF);
-
-    uint32_t h[8] = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
+void sha1_init(Sha1Context& ctx) {
+    Sha1Engine::init(ctx);
+}
 
-    const uint32_t k[64] = {
+void sha1_update(Sha1Context& ctx, const uint8_t* data, size_t size) {
+    Sha1Engine::update(ctx, data, size);
+}
+
+void sha1_final(Sha1Context& ctx, uint8_t digest[20]) {
+    Sha1Engine::final(ctx, digest);
+}
+
+std::string sha1_file(const std::string& filepath) {
+    return Sha1Engine::file(filepath);
+}
+
+// ======================= SHA256 =======================
+namespace sha256_internal {
+    constexpr std::array<uint32_t, 64> K = {
         0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
         0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
         0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
@@ -154,37 +305,483 @@ std::string sha256_file(const std::string& filepath) {
         0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
     };
 
-    for (size_t i = 0; i < data.size(); i += 64) {
-        uint32_t w[64] = {};
-        for (int t = 0; t < 16; ++t)
-            w[t] = (data[i + 4*t] << 24) | (data[i + 4*t + 1] << 16) | (data[i + 4*t + 2] << 8) | data[i + 4*t + 3];
-        for (int t = 16; t < 64; ++t) {
-            uint32_t s0 = ((w[t-15] >> 7) | (w[t-15] << 25)) ^ ((w[t-15] >> 18) | (w[t-15] << 14)) ^ (w[t-15] >> 3);
-            uint32_t s1 = ((w[t-2] >> 17) | (w[t-2] << 15)) ^ ((w[t-2] >> 19) | (w[t-2] << 13)) ^ (w[t-2] >> 10);
-            w[t] = w[t-16] + s0 + w[t-7] + s1;
+    template <int N>
+    inline uint32_t ror(uint32_t x) {
+        return (x >> N) | (x << (32 - N));
+    }
+
+    /**
+     * @brief Раунд T с расписанием в кольце из 16 слов.
+     *
+     * Роль a на раунде T играет v[(8 - T) % 8]; за раунд меняются только
+     * слоты d (новое e) и h (новое a).
+     */
+    template <size_t T>
+    inline void round(uint32_t (&v)[8], uint32_t (&w)[16]) {
+        constexpr size_t r = T % 8;
+        const uint32_t a = v[(8 - r) % 8], b = v[(9 - r) % 8], c = v[(10 - r) % 8];
+        const uint32_t e = v[(12 - r) % 8], f = v[(13 - r) % 8], g = v[(14 - r) % 8];
+        uint32_t& d = v[(11 - r) % 8];
+        uint32_t& h = v[(15 - r) % 8];
+        if constexpr (T >= 16) {
+            const uint32_t w15 = w[(T - 15) % 16], w2 = w[(T - 2) % 16];
+            w[T % 16] += (ror<7>(w15) ^ ror<18>(w15) ^ (w15 >> 3)) + w[(T - 7) % 16]
+                       + (ror<17>(w2) ^ ror<19>(w2) ^ (w2 >> 10));
         }
+        const uint32_t t1 = h + (ror<6>(e) ^ ror<11>(e) ^ ror<25>(e)) + (g ^ (e & (f ^ g))) + K[T] + w[T % 16];
+        d += t1;
+        h = t1 + (ror<2>(a) ^ ror<13>(a) ^ ror<22>(a)) + ((a & b) | (c & (a | b)));
+    }
+
+    template <size_t... T>
+    inline void rounds(uint32_t (&v)[8], uint32_t (&w)[16], std::index_sequence<T...>) {
+        (round<T>(v, w), ...);
+    }
+
+    void sha256_transform(std::array<uint32_t, 8>& H, const uint8_t* block) {
+        uint32_t w[16];
+        for (int t = 0; t < 16; ++t) w[t] = load_be32(block + 4*t);
+        uint32_t v[8];
+        for (int i = 0; i < 8; ++i) v[i] = H[i];
+        rounds(v, w, std::make_index_sequence<64>{});
+        for (int i = 0; i < 8; ++i) H[i] += v[i];
+    }
+
+#ifdef HASH_X86_SIMD
+    __attribute__((target("bmi,bmi2")))
+    inline uint32_t rotr32(uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    }
 
-        uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
-        uint32_t e = h[4], f = h[5], g = h[6], hh = h[7];
+    /**
+     * @brief Раунд SHA‑256 на скалярных регистрах: с BMI2 сдвиги — rorx
+     * (не трогают флаги и не требуют копий), Ch — andn.
+     */
+    __attribute__((target("bmi,bmi2")))
+    inline void round_rorx(uint32_t a, uint32_t b, uint32_t c, uint32_t& d,
+                           uint32_t e, uint32_t f, uint32_t g, uint32_t& h, uint32_t wk) {
+        const uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) + wk;
+        d += t1;
+        h = t1 + (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (c & (a ^ b)));
+    }
+
+    /// Четыре раунда; после них роли переменных сдвигаются на четыре.
+    __attribute__((target("bmi,bmi2")))
+    inline void rounds4(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d,
+                        uint32_t& e, uint32_t& f, uint32_t& g, uint32_t& h, const uint32_t* wk) {
+        round_rorx(a, b, c, d, e, f, g, h, wk[0]);
+        round_rorx(h, a, b, c, d, e, f, g, wk[1]);
+        round_rorx(g, h, a, b, c, d, e, f, wk[2]);
+        round_rorx(f, g, h, a, b, c, d, e, wk[3]);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i rotr8x32(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+
+    /**
+     * @brief Следующие четыре слова расписания обоих блоков (по 128‑битной
+     *        половине на блок) из предыдущих шестнадцати x0..x3.
+     *
+     * σ1 зависит от двух слов, вычисляемых здесь же, поэтому считается
+     * в два приёма: для первых двух слов — по x3, для последних — по ним.
+     */
+    __attribute__((target("avx2")))
+    inline __m256i schedule4(__m256i x0, __m256i x1, __m256i x2, __m256i x3) {
+        const __m256i w15 = _mm256_alignr_epi8(x1, x0, 4);
+        const __m256i w7 = _mm256_alignr_epi8(x3, x2, 4);
+        const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x32(w15, 7), rotr8x32(w15, 18)),
+                                            _mm256_srli_epi32(w15, 3));
+        __m256i w = _mm256_add_epi32(_mm256_add_epi32(x0, s0), w7);
+
+        __m256i w2 = _mm256_shuffle_epi32(x3, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x32(w2, 17), rotr8x32(w2, 19)),
+                                      _mm256_srli_epi32(w2, 10));
+        w = _mm256_add_epi32(w, _mm256_blend_epi32(s1, _mm256_setzero_si256(), 0xCC));
+
+        w2 = _mm256_shuffle_epi32(w, _MM_SHUFFLE(1, 0, 1, 0));
+        s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x32(w2, 17), rotr8x32(w2, 19)),
+                              _mm256_srli_epi32(w2, 10));
+        return _mm256_add_epi32(w, _mm256_blend_epi32(s1, _mm256_setzero_si256(), 0x33));
+    }
+
+    /**
+     * @brief Однопоточный SHA‑256 с векторным расписанием на два блока.
+     *
+     * Блоки загружаются парами: первый — в младшие 128 бит регистров,
+     * второй — в старшие, так что одна цепочка AVX2 строит расписание
+     * обоих, а W[t] + K[t] складываются в wk. Раунды идут на скалярных
+     * регистрах: первый блок — вперемешку с расписанием (векторная и
+     * скалярная части исполняются параллельно), второй — уже по готовому wk.
+     */
+    __attribute__((target("avx2,bmi,bmi2")))
+    void transform_avx2(std::array<uint32_t, 8>& H, const uint8_t* data, size_t blocks) {
+        const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        alignas(32) uint32_t wk[2 * 64];
+        for (size_t blk = 0; blk < blocks; blk += 2) {
+            const uint8_t* first = data + 64 * blk;
+            const bool pair = blk + 1 < blocks;
+            const uint8_t* second = pair ? first + 64 : first;
+
+            __m256i x[4];
+            for (int i = 0; i < 4; ++i) {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + 16 * i));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + 16 * i));
+                x[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), bswap);
+                const __m256i k = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+                _mm256_store_si256(reinterpret_cast<__m256i*>(wk + 8 * i), _mm256_add_epi32(x[i], k));
+            }
+
+            uint32_t a = H[0], b = H[1], c = H[2], d = H[3];
+            uint32_t e = H[4], f = H[5], g = H[6], h = H[7];
+            for (int j = 0; j < 12; j += 2) {
+                for (int half = 0; half < 2; ++half) {
+                    const int t = 16 + 4 * (j + half);
+                    const __m256i next = schedule4(x[0], x[1], x[2], x[3]);
+                    x[0] = x[1]; x[1] = x[2]; x[2] = x[3]; x[3] = next;
+                    const __m256i k = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[t])));
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(wk + 2 * t), _mm256_add_epi32(next, k));
+                    if (half == 0) rounds4(a, b, c, d, e, f, g, h, wk + 8 * j);
+                    else rounds4(e, f, g, h, a, b, c, d, wk + 8 * (j + 1));
+                }
+            }
+            for (int j = 12; j < 16; j += 2) {
+                rounds4(a, b, c, d, e, f, g, h, wk + 8 * j);
+                rounds4(e, f, g, h, a, b, c, d, wk + 8 * (j + 1));
+            }
+            H[0] += a; H[1] += b; H[2] += c; H[3] += d;
+            H[4] += e; H[5] += f; H[6] += g; H[7] += h;
+            if (!pair) break;
+
+            a = H[0]; b = H[1]; c = H[2]; d = H[3];
+            e = H[4]; f = H[5]; g = H[6]; h = H[7];
+            for (int j = 0; j < 16; j += 2) {
+                rounds4(a, b, c, d, e, f, g, h, wk + 8 * j + 4);
+                rounds4(e, f, g, h, a, b, c, d, wk + 8 * (j + 1) + 4);
+            }
+            H[0] += a; H[1] += b; H[2] += c; H[3] += d;
+            H[4] += e; H[5] += f; H[6] += g; H[7] += h;
+        }
+    }
+
+HASH_AVX512_WARNINGS_PUSH
+    __attribute__((target("avx512f")))
+    inline __m512i xor3(__m512i a, __m512i b, __m512i c) {
+        return _mm512_ternarylogic_epi32(a, b, c, 0x96);
+    }
+
+    /// Порядок байт слов без AVX512BW: (ror 8 & FF00FF00) | (rol 8 & 00FF00FF).
+    __attribute__((target("avx512f")))
+    inline __m512i bswap_x16(__m512i x) {
+        return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 8), _mm512_rol_epi32(x, 8),
+                                         _mm512_set1_epi32(static_cast<int>(0xFF00FF00U)), 0xE4);
+    }
+
+    /// Порядок байт слов с AVX512BW: одна vpshufb вместо трёх инструкций.
+    __attribute__((target("avx512f,avx512bw")))
+    inline __m512i bswap_x16_bw(__m512i x) {
+        const __m512i order = _mm512_broadcast_i32x4(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+        return _mm512_shuffle_epi8(x, order);
+    }
+
+    /**
+     * @brief Блок шестнадцати потоков SHA‑256 в 32‑битных дорожках AVX‑512.
+     *
+     * Ch и Maj — по одной vpternlogd (выбор e ? f : g и большинство),
+     * суммы трёх сдвигов — тоже; циклические сдвиги — vprord.
+     * Расписание хранится в кольце из 16 слов; w уже в big endian.
+     */
+    __attribute__((target("avx512f")))
+    inline void compress_x16(__m512i state[8], __m512i w[16]) {
+        __m512i a = state[0], b = state[1], c = state[2], d = state[3];
+        __m512i e = state[4], f = state[5], g = state[6], hh = state[7];
         for (int t = 0; t < 64; ++t) {
-            uint32_t S1 = ((e >> 6) | (e << 26)) ^ ((e >> 11) | (e << 21)) ^ ((e >> 25) | (e << 7));
-            uint32_t ch = (e & f) ^ (~e & g);
-            uint32_t temp1 = hh + S1 + ch + k[t] + w[t];
-            uint32_t S0 = ((a >> 2) | (a << 30)) ^ ((a >> 13) | (a << 19)) ^ ((a >> 22) | (a << 10));
-            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
-            uint32_t temp2 = S0 + maj;
+            if (t >= 16) {
+                const __m512i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+                const __m512i s0 = xor3(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18), _mm512_srli_epi32(w15, 3));
+                const __m512i s1 = xor3(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19), _mm512_srli_epi32(w2, 10));
+                w[t & 15] = _mm512_add_epi32(_mm512_add_epi32(w[t & 15], s0), _mm512_add_epi32(w[(t - 7) & 15], s1));
+            }
+            const __m512i S1 = xor3(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25));
+            const __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+            const __m512i temp1 = _mm512_add_epi32(_mm512_add_epi32(hh, S1),
+                _mm512_add_epi32(_mm512_add_epi32(ch, _mm512_set1_epi32(static_cast<int>(K[t]))), w[t & 15]));
+            const __m512i S0 = xor3(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22));
+            const __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
 
             hh = g; g = f; f = e;
-            e = d + temp1; d = c; c = b; b = a;
-            a = temp1 + temp2;
+            e = _mm512_add_epi32(d, temp1); d = c; c = b; b = a;
+            a = _mm512_add_epi32(temp1, _mm512_add_epi32(S0, maj));
+        }
+        state[0] = _mm512_add_epi32(state[0], a); state[1] = _mm512_add_epi32(state[1], b);
+        state[2] = _mm512_add_epi32(state[2], c); state[3] = _mm512_add_epi32(state[3], d);
+        state[4] = _mm512_add_epi32(state[4], e); state[5] = _mm512_add_epi32(state[5], f);
+        state[6] = _mm512_add_epi32(state[6], g); state[7] = _mm512_add_epi32(state[7], hh);
+    }
+
+    __attribute__((target("avx512f")))
+    void transform_x16_avx512(std::array<uint32_t, 8>* const H[16], const uint8_t* const data[16], size_t blocks) {
+        uint32_t* h[16];
+        for (int l = 0; l < 16; ++l) h[l] = H[l]->data();
+        __m512i state[8];
+        load_state_x16(h, 8, state);
+        for (size_t blk = 0; blk < blocks; ++blk) {
+            __m512i w[16];
+            load_x16(data, 64 * blk, w);
+            for (__m512i& word : w) word = bswap_x16(word);
+            compress_x16(state, w);
+        }
+        store_state_x16(h, 8, state);
+    }
+
+    /// То же с перестановкой байт через vpshufb.
+    __attribute__((target("avx512f,avx512bw")))
+    void transform_x16_avx512bw(std::array<uint32_t, 8>* const H[16], const uint8_t* const data[16], size_t blocks) {
+        uint32_t* h[16];
+        for (int l = 0; l < 16; ++l) h[l] = H[l]->data();
+        __m512i state[8];
+        load_state_x16(h, 8, state);
+        for (size_t blk = 0; blk < blocks; ++blk) {
+            __m512i w[16];
+            load_x16(data, 64 * blk, w);
+            for (__m512i& word : w) word = bswap_x16_bw(word);
+            compress_x16(state, w);
+        }
+        store_state_x16(h, 8, state);
+    }
+HASH_AVX512_WARNINGS_POP
+#endif
+
+    void sha256_transform_x16(std::array<uint32_t, 8>* const H[16], const uint8_t* const data[16], size_t blocks) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx512bw()) {
+            transform_x16_avx512bw(H, data, blocks);
+            return;
+        }
+        if (cpu_has_avx512f()) {
+            transform_x16_avx512(H, data, blocks);
+            return;
+        }
+#endif
+        for (int l = 0; l < 16; ++l) sha256_transform_blocks(*H[l], data[l], blocks);
+    }
+
+    void sha256_transform_blocks(std::array<uint32_t, 8>& H, const uint8_t* data, size_t blocks) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx2() && cpu_has_bmi() && cpu_has_bmi2()) {
+            transform_avx2(H, data, blocks);
+            return;
+        }
+#endif
+        for (size_t i = 0; i < blocks; ++i) sha256_transform(H, data + 64 * i);
+    }
+}
+
+void sha256_init(Sha256Context& ctx) {
+    Sha256Engine::init(ctx);
+}
+
+void sha256_update(Sha256Context& ctx, const uint8_t* data, size_t size) {
+    Sha256Engine::update(ctx, data, size);
+}
+
+void sha256_final(Sha256Context& ctx, uint8_t digest[32]) {
+    Sha256Engine::final(ctx, digest);
+}
+
+std::string sha256_file(const std::string& filepath) {
+    return Sha256Engine::file(filepath);
+}
+
+// ======================= SHA512 =======================
+namespace sha512_internal {
+    constexpr std::array<uint64_t, 80> K = {
+        0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+        0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+        0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+        0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+        0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+        0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+        0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+        0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+        0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+        0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+        0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+        0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+        0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+        0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+        0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+        0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+        0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+        0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+        0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+        0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull
+    };
+
+    inline uint64_t rotr(uint64_t x, int n) {
+        return (x >> n) | (x << (64 - n));
+    }
+
+    /// Раунд T; устроен как sha256_internal::round().
+    template <size_t T>
+    inline void round(uint64_t (&v)[8], uint64_t (&w)[16]) {
+        constexpr size_t r = T % 8;
+        const uint64_t a = v[(8 - r) % 8], b = v[(9 - r) % 8], c = v[(10 - r) % 8];
+        const uint64_t e = v[(12 - r) % 8], f = v[(13 - r) % 8], g = v[(14 - r) % 8];
+        uint64_t& d = v[(11 - r) % 8];
+        uint64_t& h = v[(15 - r) % 8];
+        if constexpr (T >= 16) {
+            const uint64_t w15 = w[(T - 15) % 16], w2 = w[(T - 2) % 16];
+            w[T % 16] += (rotr(w15, 1) ^ rotr(w15, 8) ^ (w15 >> 7)) + w[(T - 7) % 16]
+                       + (rotr(w2, 19) ^ rotr(w2, 61) ^ (w2 >> 6));
         }
+        const uint64_t t1 = h + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + (g ^ (e & (f ^ g))) + K[T] + w[T % 16];
+        d += t1;
+        h = t1 + (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) | (c & (a | b)));
+    }
+
+    template <size_t... T>
+    inline void rounds(uint64_t (&v)[8], uint64_t (&w)[16], std::index_sequence<T...>) {
+        (round<T>(v, w), ...);
+    }
+
+    void sha512_transform(std::array<uint64_t, 8>& H, const uint8_t* block) {
+        uint64_t w[16];
+        for (int t = 0; t < 16; ++t) w[t] = load_be64(block + 8*t);
+        uint64_t v[8];
+        for (int i = 0; i < 8; ++i) v[i] = H[i];
+        rounds(v, w, std::make_index_sequence<80>{});
+        for (int i = 0; i < 8; ++i) H[i] += v[i];
+    }
 
-        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
-        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+#ifdef HASH_X86_SIMD
+    /**
+     * @brief Циклический сдвиг вправо четырёх 64‑битных слов.
+     */
+    __attribute__((target("avx2")))
+    inline __m256i rotr4(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n));
     }
 
-    std::ostringstream result;
-    for (uint32_t v : h)
-        result << std::hex << std::setw(8) << std::setfill('0') << v;
-    return result.str();
+    /**
+     * @brief Четыре независимых потока SHA‑512 в 64‑битных дорожках AVX2.
+     *
+     * В AVX2 нет циклического сдвига 64‑битных слов, он собирается из
+     * двух сдвигов; порядок байт слов меняется одним vpshufb.
+     */
+    __attribute__((target("avx2")))
+    void transform_x4_avx2(std::array<uint64_t, 8>* const H[4], const uint8_t* const data[4], size_t blocks) {
+        const __m256i bswap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                               7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        __m256i state[8];
+        for (int i = 0; i < 8; ++i) {
+            state[i] = _mm256_setr_epi64x(static_cast<long long>((*H[0])[i]), static_cast<long long>((*H[1])[i]),
+                                          static_cast<long long>((*H[2])[i]), static_cast<long long>((*H[3])[i]));
+        }
+
+        for (size_t blk = 0; blk < blocks; ++blk) {
+            __m256i w[80];
+            for (int t = 0; t < 16; ++t) {
+                uint64_t lane[4];
+                for (int l = 0; l < 4; ++l) std::memcpy(&lane[l], data[l] + 128 * blk + 8 * t, 8);
+                __m256i raw = _mm256_setr_epi64x(static_cast<long long>(lane[0]), static_cast<long long>(lane[1]),
+                                                 static_cast<long long>(lane[2]), static_cast<long long>(lane[3]));
+                w[t] = _mm256_shuffle_epi8(raw, bswap);
+            }
+            for (int t = 16; t < 80; ++t) {
+                __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr4(w[t-15], 1), rotr4(w[t-15], 8)),
+                                              _mm256_srli_epi64(w[t-15], 7));
+                __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr4(w[t-2], 19), rotr4(w[t-2], 61)),
+                                              _mm256_srli_epi64(w[t-2], 6));
+                w[t] = _mm256_add_epi64(_mm256_add_epi64(w[t-16], s0), _mm256_add_epi64(w[t-7], s1));
+            }
+
+            __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+            __m256i e = state[4], f = state[5], g = state[6], hh = state[7];
+            for (int t = 0; t < 80; ++t) {
+                __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(rotr4(e, 14), rotr4(e, 18)), rotr4(e, 41));
+                __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                __m256i k = _mm256_set1_epi64x(static_cast<long long>(K[t]));
+                __m256i temp1 = _mm256_add_epi64(_mm256_add_epi64(hh, S1),
+                                                 _mm256_add_epi64(_mm256_add_epi64(ch, k), w[t]));
+                __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(rotr4(a, 28), rotr4(a, 34)), rotr4(a, 39));
+                __m256i maj = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)),
+                                               _mm256_and_si256(b, c));
+                __m256i temp2 = _mm256_add_epi64(S0, maj);
+
+                hh = g; g = f; f = e;
+                e = _mm256_add_epi64(d, temp1); d = c; c = b; b = a;
+                a = _mm256_add_epi64(temp1, temp2);
+            }
+            state[0] = _mm256_add_epi64(state[0], a); state[1] = _mm256_add_epi64(state[1], b);
+            state[2] = _mm256_add_epi64(state[2], c); state[3] = _mm256_add_epi64(state[3], d);
+            state[4] = _mm256_add_epi64(state[4], e); state[5] = _mm256_add_epi64(state[5], f);
+            state[6] = _mm256_add_epi64(state[6], g); state[7] = _mm256_add_epi64(state[7], hh);
+        }
+
+        for (int i = 0; i < 8; ++i) {
+            alignas(32) uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), state[i]);
+            for (int l = 0; l < 4; ++l) (*H[l])[i] = lanes[l];
+        }
+    }
+#endif
+
+    void sha512_transform_x4(std::array<uint64_t, 8>* const H[4], const uint8_t* const data[4], size_t blocks) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx2()) {
+            transform_x4_avx2(H, data, blocks);
+            return;
+        }
+#endif
+        for (int l = 0; l < 4; ++l)
+            for (size_t blk = 0; blk < blocks; ++blk)
+                sha512_transform(*H[l], data[l] + 128 * blk);
+    }
+}
+
+void sha512_init(Sha512Context& ctx) {
+    Sha512Engine::init(ctx);
+}
+
+void sha384_init(Sha512Context& ctx) {
+    Sha384Engine::init(ctx);
+}
+
+void sha512_256_init(Sha512Context& ctx) {
+    Sha512_256Engine::init(ctx);
+}
+
+void sha512_update(Sha512Context& ctx, const uint8_t* data, size_t size) {
+    Sha512Engine::update(ctx, data, size);
+}
+
+void sha512_update_x4(Sha512Context* const ctx[4], const uint8_t* const data[4], size_t size) {
+    Sha512Engine::update_lanes(ctx, data, size);
+}
+
+void sha512_final(Sha512Context& ctx, uint8_t digest[64]) {
+    Sha512Engine::final(ctx, digest);
+}
+
+void sha384_final(Sha512Context& ctx, uint8_t digest[48]) {
+    Sha384Engine::final(ctx, digest);
+}
+
+void sha512_256_final(Sha512Context& ctx, uint8_t digest[32]) {
+    Sha512_256Engine::final(ctx, digest);
+}
+
+std::string sha512_file(const std::string& filepath) {
+    return Sha512Engine::file(filepath);
+}
+
+std::string sha384_file(const std::string& filepath) {
+    return Sha384Engine::file(filepath);
+}
+
+std::string sha512_256_file(const std::string& filepath) {
+    return Sha512_256Engine::file(filepath);
 }
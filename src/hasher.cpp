@@ -0,0 +1,662 @@
+/**
+ * @file hasher.cpp
+ * @brief Обёртки потоковых контекстов hash.h под общий интерфейс Hasher.
+ */
+
+#include "../include/hasher.h"
+#include "../include/hash.h"
+#include "../include/md_engine.h"
+#include "../include/blake2.h"
+#include "../include/blake3.h"
+#include "../include/xxh3.h"
+#include "../include/crc32.h"
+#include "../include/keccak.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/parallel.h"
+
+#include <atomic>
+
+bool Hasher::cryptographic() const {
+    return true;
+}
+
+bool Hasher::export_midstate(std::vector<uint32_t>&, uint64_t&) const {
+    return false;
+}
+
+bool Hasher::import_midstate(const std::vector<uint32_t>&, uint64_t) {
+    return false;
+}
+
+bool Hasher::save_body(std::string&) const {
+    return false;
+}
+
+bool Hasher::load_body(const uint8_t*, size_t) {
+    return false;
+}
+
+std::string Hasher::save_state() const {
+    std::string algo = name();
+    std::string blob = "HS";
+    blob += static_cast<char>(STATE_VERSION);
+    blob += static_cast<char>(algo.size());
+    blob += algo;
+    if (!save_body(blob)) return "";
+    return blob;
+}
+
+bool Hasher::load_state(const std::string& blob) {
+    const std::string algo = name();
+    const size_t header = 4 + algo.size();
+    if (blob.size() < header || blob.compare(0, 2, "HS") != 0) return false;
+    if (static_cast<uint8_t>(blob[2]) != STATE_VERSION) return false;
+    if (static_cast<uint8_t>(blob[3]) != algo.size() || blob.compare(4, algo.size(), algo) != 0) return false;
+    return load_body(reinterpret_cast<const uint8_t*>(blob.data()) + header, blob.size() - header);
+}
+
+namespace {
+    /// Поля тела состояния пишутся подряд в little endian.
+    inline void put(std::string& out, uint64_t v) { append_le64(out, v); }
+    inline void put(std::string& out, uint32_t v) { append_le32(out, v); }
+    inline void put(std::string& out, uint8_t v) { out += static_cast<char>(v); }
+
+    template <typename T, size_t N>
+    void put(std::string& out, const std::array<T, N>& values) {
+        for (T v : values) put(out, v);
+    }
+
+    /**
+     * @brief Читает поля тела состояния в порядке записи put().
+     *
+     * Выход за конец данных не бросает исключений, а запоминается:
+     * done() тогда возвращает false.
+     */
+    class BodyReader {
+    public:
+        BodyReader(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+        void get(uint64_t& v) { if (take(8)) v = load_le64(p_ - 8); }
+        void get(uint32_t& v) { if (take(4)) v = load_le32(p_ - 4); }
+        void get(uint8_t& v) { if (take(1)) v = p_[-1]; }
+
+        template <typename T, size_t N>
+        void get(std::array<T, N>& values) {
+            for (T& v : values) get(v);
+        }
+
+        void bytes(uint8_t* out, size_t size) {
+            if (take(size)) std::copy(p_ - size, p_, out);
+        }
+
+        /// Все поля прочитаны, и лишних данных нет.
+        bool done() const { return ok_ && p_ == end_; }
+
+    private:
+        bool take(size_t size) {
+            if (!ok_ || static_cast<size_t>(end_ - p_) < size) return ok_ = false;
+            p_ += size;
+            return true;
+        }
+
+        const uint8_t* p_;
+        const uint8_t* end_;
+        bool ok_ = true;
+    };
+
+    /// Губка Keccak: состояние и неполный блок; rate и суффикс задаёт init.
+    void put_keccak(std::string& out, const KeccakContext& ctx) {
+        put(out, ctx.a);
+        put(out, ctx.block);
+        put(out, static_cast<uint32_t>(ctx.used));
+    }
+
+    /// false, если неполный блок не меньше rate: полный блок поглощается сразу.
+    bool get_keccak(BodyReader& in, KeccakContext& ctx) {
+        uint32_t used = 0;
+        in.get(ctx.a);
+        in.get(ctx.block);
+        in.get(used);
+        ctx.used = used;
+        return used < ctx.rate;
+    }
+
+    /**
+     * @brief Hasher поверх MdEngine (см. md_engine.h).
+     *
+     * Размер блока и ширина слов H берутся из контекста политики, поэтому
+     * шаблон подходит и для 64‑битного семейства SHA‑512 со 128‑байтными блоками.
+     */
+    template <typename Policy, const char* Name>
+    class MdHasher : public Hasher {
+    public:
+        MdHasher() { Engine::init(ctx_); }
+
+        void update(const uint8_t* data, size_t size) override { Engine::update(ctx_, data, size); }
+        void reset() override { Engine::init(ctx_); }
+
+        std::string digest() override {
+            uint8_t out[Engine::DIGEST];
+            Engine::final(ctx_, out);
+            return std::string(reinterpret_cast<const char*>(out), Engine::DIGEST);
+        }
+
+        size_t digest_size() const override { return Engine::DIGEST; }
+        size_t block_size() const override { return BLOCK; }
+        std::string name() const override { return Name; }
+
+        /// 64‑битные слова H передаются парами 32‑битных (старшая половина первой).
+        bool export_midstate(std::vector<uint32_t>& state, uint64_t& length) const override {
+            if (ctx_.used != 0) return false;
+            state.clear();
+            for (Word h : ctx_.H) {
+                if (WORD == 8) state.push_back(static_cast<uint32_t>(static_cast<uint64_t>(h) >> 32));
+                state.push_back(static_cast<uint32_t>(h));
+            }
+            length = ctx_.length;
+            return true;
+        }
+
+        bool import_midstate(const std::vector<uint32_t>& state, uint64_t length) override {
+            const size_t per_word = WORD / 4;
+            if (state.size() != ctx_.H.size() * per_word || length % BLOCK != 0) return false;
+            for (size_t i = 0; i < ctx_.H.size(); ++i) {
+                uint64_t h = state[i * per_word];
+                if (per_word == 2) h = (h << 32) | state[i * per_word + 1];
+                ctx_.H[i] = static_cast<Word>(h);
+            }
+            ctx_.length = length;
+            ctx_.used = 0;
+            return true;
+        }
+
+    protected:
+        /// Тело: H (по 4 или 8 байт), длина (8 байт), неполный блок (1 байт длины + данные).
+        bool save_body(std::string& out) const override {
+            for (Word h : ctx_.H) {
+                if (WORD == 8) append_le64(out, h);
+                else append_le32(out, static_cast<uint32_t>(h));
+            }
+            append_le64(out, ctx_.length);
+            out += static_cast<char>(ctx_.used);
+            out.append(reinterpret_cast<const char*>(ctx_.block.data()), ctx_.used);
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            const size_t fixed = ctx_.H.size() * WORD + 8 + 1;
+            if (size < fixed) return false;
+            size_t used = data[fixed - 1];
+            if (used >= BLOCK || size != fixed + used) return false;
+            uint64_t length = load_le64(data + ctx_.H.size() * WORD);
+            if (length % BLOCK != used) return false;
+            for (size_t i = 0; i < ctx_.H.size(); ++i)
+                ctx_.H[i] = static_cast<Word>(WORD == 8 ? load_le64(data + 8 * i) : load_le32(data + 4 * i));
+            ctx_.length = length;
+            ctx_.used = used;
+            std::copy(data + fixed, data + fixed + used, ctx_.block.begin());
+            return true;
+        }
+
+    private:
+        using Engine = MdEngine<Policy>;
+        using Word = typename Engine::Word;
+        static constexpr size_t WORD = sizeof(Word);
+        static constexpr size_t BLOCK = Engine::BLOCK;
+
+        typename Engine::Context ctx_;
+    };
+
+    const char MD5_NAME[] = "md5";
+    const char SHA1_NAME[] = "sha1";
+    const char SHA256_NAME[] = "sha256";
+    const char SHA384_NAME[] = "sha384";
+    const char SHA512_NAME[] = "sha512";
+    const char SHA512_256_NAME[] = "sha512_256";
+
+    using Md5Hasher = MdHasher<Md5Policy, MD5_NAME>;
+    using Sha1Hasher = MdHasher<Sha1Policy, SHA1_NAME>;
+    using Sha256Hasher = MdHasher<Sha256Policy, SHA256_NAME>;
+    using Sha384Hasher = MdHasher<Sha384Policy, SHA384_NAME>;
+    using Sha512Hasher = MdHasher<Sha512Policy, SHA512_NAME>;
+    using Sha512_256Hasher = MdHasher<Sha512_256Policy, SHA512_256_NAME>;
+
+    /**
+     * @brief Вызывает f(MdEngine<Policy>{}) для алгоритма Merkle–Damgård.
+     * @return false, если algo не из их числа.
+     */
+    template <typename F>
+    bool with_md_engine(const std::string& algo, F&& f) {
+        if (algo == "md5") f(Md5Engine{});
+        else if (algo == "sha1") f(Sha1Engine{});
+        else if (algo == "sha256") f(Sha256Engine{});
+        else if (algo == "sha384") f(Sha384Engine{});
+        else if (algo == "sha512") f(Sha512Engine{});
+        else if (algo == "sha512_256") f(Sha512_256Engine{});
+        else return false;
+        return true;
+    }
+
+    /**
+     * @brief Hasher поверх контекста BLAKE2b/BLAKE2s (без ключа).
+     *
+     * Последний блок сжимается с флагом завершения, поэтому цепочечное
+     * значение на границе блока не является midstate в смысле Merkle–Damgård.
+     */
+    template <typename Context, size_t Size, const char* Name,
+              bool (*Init)(Context&, size_t, const uint8_t*, size_t),
+              void (*Update)(Context&, const uint8_t*, size_t),
+              void (*Final)(Context&, uint8_t*)>
+    class Blake2Hasher : public Hasher {
+    public:
+        Blake2Hasher() { Init(ctx_, Size, nullptr, 0); }
+
+        void update(const uint8_t* data, size_t size) override { Update(ctx_, data, size); }
+        void reset() override { Init(ctx_, Size, nullptr, 0); }
+
+        std::string digest() override {
+            uint8_t out[Size];
+            Final(ctx_, out);
+            return std::string(reinterpret_cast<const char*>(out), Size);
+        }
+
+        size_t digest_size() const override { return Size; }
+        size_t block_size() const override { return std::tuple_size<decltype(Context::block)>::value; }
+        std::string name() const override { return Name; }
+
+    protected:
+        bool save_body(std::string& out) const override {
+            put(out, ctx_.h);
+            put(out, ctx_.t);
+            put(out, ctx_.block);
+            put(out, static_cast<uint32_t>(ctx_.used));
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            Context ctx = ctx_;
+            uint32_t used = 0;
+            BodyReader in(data, size);
+            in.get(ctx.h);
+            in.get(ctx.t);
+            in.get(ctx.block);
+            in.get(used);
+            // Последний блок сжимается только в final(), так что used может равняться размеру блока.
+            if (!in.done() || used > ctx.block.size()) return false;
+            ctx.used = used;
+            ctx_ = ctx;
+            return true;
+        }
+
+    private:
+        Context ctx_;
+    };
+
+    const char BLAKE2B_NAME[] = "blake2b";
+    const char BLAKE2S_NAME[] = "blake2s";
+
+    using Blake2bHasher = Blake2Hasher<Blake2bContext, 64, BLAKE2B_NAME, blake2b_init, blake2b_update, blake2b_final>;
+    using Blake2sHasher = Blake2Hasher<Blake2sContext, 32, BLAKE2S_NAME, blake2s_init, blake2s_update, blake2s_final>;
+
+    /**
+     * @brief Hasher поверх потокового контекста BLAKE3.
+     *
+     * Дерево кусков не сводится к одному цепочечному значению, поэтому
+     * midstate и сериализация состояния не поддерживаются.
+     */
+    class Blake3Hasher : public Hasher {
+    public:
+        Blake3Hasher() { blake3_init(ctx_); }
+
+        void update(const uint8_t* data, size_t size) override { blake3_update(ctx_, data, size); }
+        void reset() override { blake3_init(ctx_); }
+
+        std::string digest() override {
+            uint8_t out[32];
+            blake3_final(ctx_, out);
+            return std::string(reinterpret_cast<const char*>(out), sizeof(out));
+        }
+
+        size_t digest_size() const override { return 32; }
+        size_t block_size() const override { return 64; }
+        std::string name() const override { return "blake3"; }
+
+    protected:
+        /// Ключ, CV куска, неполный блок и занятая часть стека CV поддеревьев.
+        bool save_body(std::string& out) const override {
+            put(out, ctx_.key);
+            put(out, ctx_.cv);
+            put(out, ctx_.chunk_counter);
+            put(out, ctx_.block);
+            put(out, static_cast<uint32_t>(ctx_.used));
+            put(out, static_cast<uint32_t>(ctx_.blocks_compressed));
+            put(out, ctx_.flags);
+            put(out, static_cast<uint32_t>(ctx_.stack_size));
+            for (size_t i = 0; i < ctx_.stack_size; ++i) put(out, ctx_.stack[i]);
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            Blake3Context ctx = ctx_;
+            uint32_t used = 0, blocks = 0, depth = 0;
+            BodyReader in(data, size);
+            in.get(ctx.key);
+            in.get(ctx.cv);
+            in.get(ctx.chunk_counter);
+            in.get(ctx.block);
+            in.get(used);
+            in.get(blocks);
+            in.get(ctx.flags);
+            in.get(depth);
+            if (used > ctx.block.size() || blocks > 16 || depth > ctx.stack.size()) return false;
+            for (size_t i = 0; i < depth; ++i) in.get(ctx.stack[i]);
+            if (!in.done()) return false;
+            ctx.used = used;
+            ctx.blocks_compressed = blocks;
+            ctx.stack_size = depth;
+            ctx_ = ctx;
+            return true;
+        }
+
+    private:
+        Blake3Context ctx_;
+    };
+
+    /**
+     * @brief Hasher поверх губки Keccak: SHA3‑224/256/384/512 или SHAKE128/256.
+     *
+     * Для SHAKE длина дайджеста фиксируется при создании (32 и 64 байта).
+     */
+    class KeccakHasher : public Hasher {
+    public:
+        KeccakHasher(const std::string& name, bool shake, size_t bits) : name_(name), shake_(shake), bits_(bits) {
+            reset();
+        }
+
+        void update(const uint8_t* data, size_t size) override { keccak_update(ctx_, data, size); }
+
+        void reset() override {
+            if (shake_) shake_init(ctx_, bits_, bits_ / 4);
+            else sha3_init(ctx_, bits_);
+        }
+
+        std::string digest() override {
+            std::string out(ctx_.out_len, '\0');
+            keccak_final(ctx_, reinterpret_cast<uint8_t*>(&out[0]));
+            return out;
+        }
+
+        size_t digest_size() const override { return ctx_.out_len; }
+        size_t block_size() const override { return ctx_.rate; }
+        std::string name() const override { return name_; }
+
+    protected:
+        bool save_body(std::string& out) const override {
+            put_keccak(out, ctx_);
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            KeccakContext ctx = ctx_;
+            BodyReader in(data, size);
+            if (!get_keccak(in, ctx) || !in.done()) return false;
+            ctx_ = ctx;
+            return true;
+        }
+
+    private:
+        KeccakContext ctx_;
+        std::string name_;
+        bool shake_;
+        size_t bits_;
+    };
+
+    /// Hasher поверх потокового контекста KangarooTwelve (32 байта).
+    class K12Hasher : public Hasher {
+    public:
+        K12Hasher() { k12_init(ctx_); }
+
+        void update(const uint8_t* data, size_t size) override { k12_update(ctx_, data, size); }
+        void reset() override { k12_init(ctx_); }
+
+        std::string digest() override {
+            uint8_t out[32];
+            k12_final(ctx_, out, sizeof(out));
+            return std::string(reinterpret_cast<const char*>(out), sizeof(out));
+        }
+
+        size_t digest_size() const override { return 32; }
+        size_t block_size() const override { return K12_CHUNK_LEN; }
+        std::string name() const override { return "k12"; }
+
+    protected:
+        /// Губка узла, неполная группа листьев (только занятая часть) и счётчики.
+        bool save_body(std::string& out) const override {
+            put_keccak(out, ctx_.node);
+            put(out, static_cast<uint32_t>(ctx_.pending_len));
+            out.append(reinterpret_cast<const char*>(ctx_.pending.data()), ctx_.pending_len);
+            put(out, ctx_.total);
+            put(out, ctx_.leaves);
+            put(out, static_cast<uint8_t>(ctx_.tree));
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            K12Context ctx = ctx_;
+            uint32_t pending = 0;
+            uint8_t tree = 0;
+            BodyReader in(data, size);
+            if (!get_keccak(in, ctx.node)) return false;
+            in.get(pending);
+            // Полная группа поглощается сразу; final() дописывает байт за pending_len.
+            if (pending >= ctx.pending.size()) return false;
+            in.bytes(ctx.pending.data(), pending);
+            in.get(ctx.total);
+            in.get(ctx.leaves);
+            in.get(tree);
+            if (!in.done() || tree > 1) return false;
+            ctx.pending_len = pending;
+            ctx.tree = tree != 0;
+            ctx_ = ctx;
+            return true;
+        }
+
+    private:
+        K12Context ctx_;
+    };
+
+    /**
+     * @brief Hasher поверх состояния XXH3; дайджест в каноническом порядке (big endian).
+     *
+     * @tparam Wide false — XXH3‑64, true — XXH128.
+     */
+    template <bool Wide>
+    class XxhHasher : public Hasher {
+    public:
+        XxhHasher() { xxh3_init(state_); }
+
+        void update(const uint8_t* data, size_t size) override { xxh3_update(state_, data, size); }
+        void reset() override { xxh3_init(state_); }
+
+        std::string digest() override {
+            uint8_t out[16];
+            if (Wide) {
+                const Xxh128Hash h = xxh3_128_digest(state_);
+                store_be64(out, h.high);
+                store_be64(out + 8, h.low);
+            } else {
+                store_be64(out, xxh3_64_digest(state_));
+            }
+            return std::string(reinterpret_cast<const char*>(out), digest_size());
+        }
+
+        size_t digest_size() const override { return Wide ? 16 : 8; }
+        size_t block_size() const override { return 64; }
+        std::string name() const override { return Wide ? "xxh128" : "xxh3"; }
+        bool cryptographic() const override { return false; }
+
+    protected:
+        /// Буфер пишется целиком: его хвост хранит последнюю полосу для digest().
+        bool save_body(std::string& out) const override {
+            put(out, state_.acc);
+            put(out, state_.buffer);
+            put(out, static_cast<uint32_t>(state_.buffered));
+            put(out, static_cast<uint32_t>(state_.stripes));
+            put(out, state_.total);
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            Xxh3State state = state_;
+            uint32_t buffered = 0, stripes = 0;
+            BodyReader in(data, size);
+            in.get(state.acc);
+            in.get(state.buffer);
+            in.get(buffered);
+            in.get(stripes);
+            in.get(state.total);
+            // Стандартный секрет в 192 байта даёт (192 − 64) / 8 = 16 полос на блок.
+            if (!in.done() || buffered > state.buffer.size() || stripes >= 16) return false;
+            state.buffered = buffered;
+            state.stripes = stripes;
+            state_ = state;
+            return true;
+        }
+
+    private:
+        Xxh3State state_;
+    };
+
+    /// CRC32 (IEEE) или CRC32C; дайджест — значение CRC в big endian.
+    template <bool Castagnoli>
+    class CrcHasher : public Hasher {
+    public:
+        void update(const uint8_t* data, size_t size) override {
+            crc_ = Castagnoli ? crc32c(crc_, data, size) : crc32_ieee(crc_, data, size);
+        }
+
+        void reset() override { crc_ = 0; }
+
+        std::string digest() override {
+            uint8_t out[4];
+            store_be32(out, crc_);
+            return std::string(reinterpret_cast<const char*>(out), sizeof(out));
+        }
+
+        size_t digest_size() const override { return 4; }
+        size_t block_size() const override { return 1; }
+        std::string name() const override { return Castagnoli ? "crc32c" : "crc32"; }
+        bool cryptographic() const override { return false; }
+
+    protected:
+        bool save_body(std::string& out) const override {
+            put(out, crc_);
+            return true;
+        }
+
+        bool load_body(const uint8_t* data, size_t size) override {
+            BodyReader in(data, size);
+            uint32_t crc = 0;
+            in.get(crc);
+            if (!in.done()) return false;
+            crc_ = crc;
+            return true;
+        }
+
+    private:
+        uint32_t crc_ = 0;
+    };
+}
+
+std::unique_ptr<Hasher> make_hasher(const std::string& algo) {
+    if (algo == "md5") return std::make_unique<Md5Hasher>();
+    if (algo == "sha1") return std::make_unique<Sha1Hasher>();
+    if (algo == "sha256") return std::make_unique<Sha256Hasher>();
+    if (algo == "sha384") return std::make_unique<Sha384Hasher>();
+    if (algo == "sha512") return std::make_unique<Sha512Hasher>();
+    if (algo == "sha512_256") return std::make_unique<Sha512_256Hasher>();
+    if (algo == "blake2b") return std::make_unique<Blake2bHasher>();
+    if (algo == "blake2s") return std::make_unique<Blake2sHasher>();
+    if (algo == "blake3") return std::make_unique<Blake3Hasher>();
+    if (algo == "sha3_224") return std::make_unique<KeccakHasher>(algo, false, 224);
+    if (algo == "sha3_256") return std::make_unique<KeccakHasher>(algo, false, 256);
+    if (algo == "sha3_384") return std::make_unique<KeccakHasher>(algo, false, 384);
+    if (algo == "sha3_512") return std::make_unique<KeccakHasher>(algo, false, 512);
+    if (algo == "shake128") return std::make_unique<KeccakHasher>(algo, true, 128);
+    if (algo == "shake256") return std::make_unique<KeccakHasher>(algo, true, 256);
+    if (algo == "k12") return std::make_unique<K12Hasher>();
+    if (algo == "xxh3") return std::make_unique<XxhHasher<false>>();
+    if (algo == "xxh128") return std::make_unique<XxhHasher<true>>();
+    if (algo == "crc32") return std::make_unique<CrcHasher<false>>();
+    if (algo == "crc32c") return std::make_unique<CrcHasher<true>>();
+    return nullptr;
+}
+
+std::string hash_file(const std::string& algo, const std::string& filepath) {
+    std::unique_ptr<Hasher> hasher = make_hasher(algo);
+    if (!hasher) return "";
+    if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { hasher->update(data, size); }))
+        return "";
+    std::string digest = hasher->digest();
+    return to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+}
+
+bool digest_range(const std::string& algo, const RandomAccessFile& file,
+                  uint64_t offset, uint64_t length, std::string& digest) {
+    bool ok = false;
+    if (with_md_engine(algo, [&](auto engine) {
+            uint8_t out[decltype(engine)::DIGEST];
+            ok = engine.range(file, offset, length, out);
+            if (ok) digest.assign(reinterpret_cast<const char*>(out), sizeof(out));
+        }))
+        return ok;
+    std::unique_ptr<Hasher> hasher = make_hasher(algo);
+    if (!hasher) return false;
+    if (!file.read_range(offset, length, [&](const uint8_t* data, size_t size) { hasher->update(data, size); }))
+        return false;
+    digest = hasher->digest();
+    return true;
+}
+
+bool digest_chunks(const std::string& algo, const RandomAccessFile& file, uint64_t chunk_size,
+                   std::vector<std::string>& digests, unsigned threads) {
+    if (chunk_size == 0) return false;
+    const uint64_t size = file.size();
+    digests.assign(static_cast<size_t>(std::max<uint64_t>(1, (size + chunk_size - 1) / chunk_size)), "");
+    std::atomic<bool> ok(true);
+    parallel_for(digests.size(), [&](size_t i) {
+        uint64_t offset = i * chunk_size;
+        if (!digest_range(algo, file, offset, std::min(chunk_size, size - offset), digests[i])) ok = false;
+    }, threads);
+    return ok;
+}
+
+std::string hash_file_range(const std::string& algo, const std::string& filepath,
+                            uint64_t offset, uint64_t length) {
+    return hash_file_ranges(algo, filepath, { { offset, length } }, 1)[0];
+}
+
+std::vector<std::string> hash_file_ranges(const std::string& algo, const std::string& filepath,
+                                          const std::vector<ByteRange>& ranges, unsigned threads) {
+    std::vector<std::string> result(ranges.size());
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return result;
+
+    parallel_for(ranges.size(), [&](size_t i) {
+        std::string digest;
+        if (digest_range(algo, file, ranges[i].offset, ranges[i].length, digest))
+            result[i] = to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+    }, threads);
+    return result;
+}
+
+std::vector<std::string> hash_files(const std::string& algo, const std::vector<std::string>& paths,
+                                    unsigned threads) {
+    std::vector<std::string> result;
+    if (with_md_engine(algo, [&](auto engine) { result = engine.files(paths, threads); }))
+        return result;
+    result.resize(paths.size());
+    parallel_for(paths.size(), [&](size_t i) { result[i] = hash_file(algo, paths[i]); }, threads);
+    return result;
+}
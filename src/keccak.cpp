@@ -0,0 +1,485 @@
+/**
+ * @file keccak.cpp
+ * @brief Keccak‑p[1600] (обычная форма с BMI, форма с дополнением дорожек,
+ *        AVX2 на четыре состояния), губки SHA‑3/SHAKE/TurboSHAKE и
+ *        KangarooTwelve.
+ */
+
+#include "../include/keccak.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+#include "../include/cpu_features.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    const uint64_t RC[24] = {
+        0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+        0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+        0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+        0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+        0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+        0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+    };
+
+    /// Сдвиги ρ для дорожки x + 5y.
+    const unsigned RHO[25] = {
+         0,  1, 62, 28, 27,
+        36, 44,  6, 55, 20,
+         3, 10, 43, 25, 39,
+        41, 45, 15, 21,  8,
+        18,  2, 61, 56, 14,
+    };
+
+    /// Куда π переносит дорожку x + 5y: в y + 5·((2x + 3y) mod 5).
+    const unsigned PI[25] = {
+         0, 10, 20,  5, 15,
+        16,  1, 11, 21,  6,
+         7, 17,  2, 12, 22,
+        23,  8, 18,  3, 13,
+        14, 24,  9, 19,  4,
+    };
+
+    inline uint64_t rotl64(uint64_t x, unsigned n) {
+        return n ? (x << n) | (x >> (64 - n)) : x;
+    }
+
+    /// θ, ρ и π: B — дорожки после переноса, строки B — плоскости для χ.
+    inline void theta_rho_pi(const uint64_t a[25], uint64_t b[25]) {
+        uint64_t c[5], d[5];
+        for (int x = 0; x < 5; ++x) c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        for (int x = 0; x < 5; ++x) d[x] = c[(x + 4) % 5] ^ rotl64(c[(x + 1) % 5], 1);
+        for (int i = 0; i < 25; ++i) b[PI[i]] = rotl64(a[i] ^ d[i % 5], RHO[i]);
+    }
+
+    /// Прямая форма: χ с and‑not; с BMI1 это одна инструкция andn.
+    inline void permute_plain(uint64_t a[25], unsigned rounds) {
+        uint64_t b[25];
+        for (unsigned r = 24 - rounds; r < 24; ++r) {
+            theta_rho_pi(a, b);
+            for (int y = 0; y < 25; y += 5)
+                for (int x = 0; x < 5; ++x) a[y + x] = b[y + x] ^ (~b[y + (x + 1) % 5] & b[y + (x + 2) % 5]);
+            a[0] ^= RC[r];
+        }
+    }
+
+    /// Дорожки, которые форма с дополнением хранит инвертированными.
+    const int COMPLEMENTED[6] = { 1, 2, 8, 12, 17, 20 };
+
+    /**
+     * @brief Форма с дополнением дорожек (lane complementing) для
+     *        процессоров без andn.
+     *
+     * Если шесть дорожек хранить инвертированными, χ на каждой плоскости
+     * переписывается так, что вместо пяти NOT остаётся один, а остальные
+     * and‑not заменяются на or/and. Инверсия снимается после последнего раунда.
+     */
+    void permute_complemented(uint64_t a[25], unsigned rounds) {
+        for (int i : COMPLEMENTED) a[i] = ~a[i];
+        uint64_t b[25];
+        for (unsigned r = 24 - rounds; r < 24; ++r) {
+            theta_rho_pi(a, b);
+            const uint64_t* p = b;
+            a[0] = p[0] ^ (p[1] | p[2]);
+            a[1] = p[1] ^ (~p[2] | p[3]);
+            a[2] = p[2] ^ (p[3] & p[4]);
+            a[3] = p[3] ^ (p[4] | p[0]);
+            a[4] = p[4] ^ (p[0] & p[1]);
+            p = b + 5;
+            a[5] = p[0] ^ (p[1] | p[2]);
+            a[6] = p[1] ^ (p[2] & p[3]);
+            a[7] = p[2] ^ (p[3] | ~p[4]);
+            a[8] = p[3] ^ (p[4] | p[0]);
+            a[9] = p[4] ^ (p[0] & p[1]);
+            p = b + 10;
+            a[10] = p[0] ^ (p[1] | p[2]);
+            a[11] = p[1] ^ (p[2] & p[3]);
+            a[12] = p[2] ^ (~p[3] & p[4]);
+            a[13] = ~p[3] ^ (p[4] | p[0]);
+            a[14] = p[4] ^ (p[0] & p[1]);
+            p = b + 15;
+            a[15] = p[0] ^ (p[1] & p[2]);
+            a[16] = p[1] ^ (p[2] | p[3]);
+            a[17] = p[2] ^ (~p[3] | p[4]);
+            a[18] = ~p[3] ^ (p[4] & p[0]);
+            a[19] = p[4] ^ (p[0] | p[1]);
+            p = b + 20;
+            a[20] = p[0] ^ (~p[1] & p[2]);
+            a[21] = ~p[1] ^ (p[2] | p[3]);
+            a[22] = p[2] ^ (p[3] & p[4]);
+            a[23] = p[3] ^ (p[4] | p[0]);
+            a[24] = p[4] ^ (p[0] & p[1]);
+            a[0] ^= RC[r];
+        }
+        for (int i : COMPLEMENTED) a[i] = ~a[i];
+    }
+
+#ifdef HASH_X86_SIMD
+    __attribute__((target("bmi")))
+    void permute_bmi(uint64_t a[25], unsigned rounds) {
+        permute_plain(a, rounds);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i rotl_x4(__m256i x, unsigned n) {
+        return _mm256_or_si256(_mm256_sllv_epi64(x, _mm256_set1_epi64x(n)),
+                               _mm256_srlv_epi64(x, _mm256_set1_epi64x(64 - n)));
+    }
+
+    /// Четыре независимых состояния: дорожка i всех четырёх — в a[i].
+    __attribute__((target("avx2")))
+    void permute_x4_avx2(__m256i a[25], unsigned rounds) {
+        __m256i b[25], c[5], d[5];
+        for (unsigned r = 24 - rounds; r < 24; ++r) {
+            for (int x = 0; x < 5; ++x)
+                c[x] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]),
+                                                         _mm256_xor_si256(a[x + 10], a[x + 15])), a[x + 20]);
+            for (int x = 0; x < 5; ++x) d[x] = _mm256_xor_si256(c[(x + 4) % 5], rotl_x4(c[(x + 1) % 5], 1));
+            for (int i = 0; i < 25; ++i) b[PI[i]] = rotl_x4(_mm256_xor_si256(a[i], d[i % 5]), RHO[i]);
+            for (int y = 0; y < 25; y += 5)
+                for (int x = 0; x < 5; ++x)
+                    a[y + x] = _mm256_xor_si256(b[y + x], _mm256_andnot_si256(b[y + (x + 1) % 5], b[y + (x + 2) % 5]));
+            a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<long long>(RC[r])));
+        }
+    }
+#endif
+
+    void permute(uint64_t a[25], unsigned rounds) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_bmi()) {
+            permute_bmi(a, rounds);
+            return;
+        }
+#endif
+        permute_complemented(a, rounds);
+    }
+
+    void absorb_block(KeccakContext& ctx, const uint8_t* block) {
+        for (size_t i = 0; i < ctx.rate / 8; ++i) ctx.a[i] ^= load_le64(block + 8 * i);
+        permute(ctx.a.data(), ctx.rounds);
+    }
+
+    void sponge_init(KeccakContext& ctx, size_t rate, unsigned rounds, uint8_t suffix, size_t out_len) {
+        ctx.a.fill(0);
+        ctx.block.fill(0);
+        ctx.rate = rate;
+        ctx.used = 0;
+        ctx.out_len = out_len;
+        ctx.rounds = rounds;
+        ctx.suffix = suffix;
+    }
+
+    // ---------- KangarooTwelve ----------
+
+    constexpr size_t K12_RATE = 168;
+    constexpr size_t K12_CV_LEN = 32;
+    constexpr uint8_t K12_LEAF_SUFFIX = 0x0B;
+    constexpr uint8_t K12_SINGLE_SUFFIX = 0x07;
+    constexpr uint8_t K12_FINAL_SUFFIX = 0x06;
+
+    /// TurboSHAKE128 листа с доменом 0x0B — его 32‑байтный CV.
+    void leaf_cv(const uint8_t* data, size_t size, uint8_t* cv) {
+        KeccakContext leaf;
+        sponge_init(leaf, K12_RATE, 12, K12_LEAF_SUFFIX, K12_CV_LEN);
+        keccak_update(leaf, data, size);
+        keccak_final(leaf, cv);
+    }
+
+#ifdef HASH_X86_SIMD
+    /**
+     * @brief CV четырёх полных листьев подряд одним проходом AVX2.
+     *
+     * 8192 = 48·168 + 128: 48 полных блоков и последний блок из 128 байт
+     * данных с доменом и дополнением — одинаково для всех четырёх листьев.
+     */
+    __attribute__((target("avx2")))
+    void leaf_cv_x4_avx2(const uint8_t* data, uint8_t* cvs) {
+        const uint8_t* p[4] = { data, data + K12_CHUNK_LEN, data + 2 * K12_CHUNK_LEN, data + 3 * K12_CHUNK_LEN };
+        __m256i a[25];
+        for (__m256i& lane : a) lane = _mm256_setzero_si256();
+        const size_t blocks = K12_CHUNK_LEN / K12_RATE;
+        const size_t tail = K12_CHUNK_LEN % K12_RATE;
+        for (size_t blk = 0; blk <= blocks; ++blk) {
+            const size_t len = blk < blocks ? K12_RATE : tail;
+            const size_t at = blk * K12_RATE;
+            for (size_t i = 0; i < len / 8; ++i)
+                a[i] = _mm256_xor_si256(a[i], _mm256_set_epi64x(
+                    static_cast<long long>(load_le64(p[3] + at + 8 * i)), static_cast<long long>(load_le64(p[2] + at + 8 * i)),
+                    static_cast<long long>(load_le64(p[1] + at + 8 * i)), static_cast<long long>(load_le64(p[0] + at + 8 * i))));
+            if (blk == blocks) {
+                a[tail / 8] = _mm256_xor_si256(a[tail / 8], _mm256_set1_epi64x(K12_LEAF_SUFFIX));
+                a[K12_RATE / 8 - 1] = _mm256_xor_si256(a[K12_RATE / 8 - 1],
+                                                       _mm256_set1_epi64x(static_cast<long long>(0x80ULL << 56)));
+            }
+            permute_x4_avx2(a, 12);
+        }
+        alignas(32) uint64_t lanes[4][4];
+        for (int i = 0; i < 4; ++i) _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[i]), a[i]);
+        for (int l = 0; l < 4; ++l)
+            for (int i = 0; i < 4; ++i) store_le64(cvs + l * K12_CV_LEN + 8 * i, lanes[i][l]);
+    }
+#endif
+
+    /// CV count полных листьев подряд.
+    void leaf_cvs(const uint8_t* data, size_t count, uint8_t* cvs) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx2()) {
+            for (; count >= 4; count -= 4) {
+                leaf_cv_x4_avx2(data, cvs);
+                data += 4 * K12_CHUNK_LEN;
+                cvs += 4 * K12_CV_LEN;
+            }
+        }
+#endif
+        for (; count > 0; --count) {
+            leaf_cv(data, K12_CHUNK_LEN, cvs);
+            data += K12_CHUNK_LEN;
+            cvs += K12_CV_LEN;
+        }
+    }
+
+    /// Поглощает заголовок дерева (03 00…00) после первого куска, один раз.
+    void start_tree(K12Context& ctx) {
+        if (ctx.tree) return;
+        const uint8_t header[8] = { 0x03, 0, 0, 0, 0, 0, 0, 0 };
+        keccak_update(ctx.node, header, sizeof(header));
+        ctx.tree = true;
+    }
+
+    /// Хеширует полные листья и поглощает их CV узлом.
+    void absorb_leaves(K12Context& ctx, const uint8_t* data, size_t count) {
+        uint8_t cvs[4 * K12_CV_LEN];
+        while (count > 0) {
+            const size_t n = std::min<size_t>(count, 4);
+            leaf_cvs(data, n, cvs);
+            keccak_update(ctx.node, cvs, n * K12_CV_LEN);
+            ctx.leaves += n;
+            data += n * K12_CHUNK_LEN;
+            count -= n;
+        }
+    }
+
+    std::string sha3_file(const std::string& filepath, size_t bits) {
+        KeccakContext ctx;
+        sha3_init(ctx, bits);
+        if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { keccak_update(ctx, data, size); }))
+            return "";
+        uint8_t digest[64];
+        keccak_final(ctx, digest);
+        return to_hex(digest, ctx.out_len);
+    }
+
+    std::string shake_file(const std::string& filepath, size_t bits, size_t out_len) {
+        KeccakContext ctx;
+        if (!shake_init(ctx, bits, out_len)) return "";
+        if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { keccak_update(ctx, data, size); }))
+            return "";
+        std::vector<uint8_t> out(out_len);
+        keccak_final(ctx, out.data());
+        return to_hex(out.data(), out.size());
+    }
+}
+
+bool sha3_init(KeccakContext& ctx, size_t bits) {
+    if (bits != 224 && bits != 256 && bits != 384 && bits != 512) return false;
+    sponge_init(ctx, 200 - 2 * bits / 8, 24, 0x06, bits / 8);
+    return true;
+}
+
+bool shake_init(KeccakContext& ctx, size_t bits, size_t out_len) {
+    if ((bits != 128 && bits != 256) || out_len == 0) return false;
+    sponge_init(ctx, 200 - 2 * bits / 8, 24, 0x1F, out_len);
+    return true;
+}
+
+void keccak_update(KeccakContext& ctx, const uint8_t* data, size_t size) {
+    if (ctx.used) {
+        const size_t take = std::min(size, ctx.rate - ctx.used);
+        std::memcpy(ctx.block.data() + ctx.used, data, take);
+        ctx.used += take;
+        data += take;
+        size -= take;
+        if (ctx.used < ctx.rate) return;
+        absorb_block(ctx, ctx.block.data());
+        ctx.used = 0;
+    }
+    for (; size >= ctx.rate; data += ctx.rate, size -= ctx.rate) absorb_block(ctx, data);
+    std::memcpy(ctx.block.data(), data, size);
+    ctx.used = size;
+}
+
+void keccak_final(KeccakContext& ctx, uint8_t* out) {
+    std::fill(ctx.block.begin() + ctx.used, ctx.block.begin() + ctx.rate, 0);
+    ctx.block[ctx.used] ^= ctx.suffix;
+    ctx.block[ctx.rate - 1] ^= 0x80;
+    absorb_block(ctx, ctx.block.data());
+
+    uint8_t lanes[168];
+    for (size_t left = ctx.out_len;;) {
+        for (size_t i = 0; i < ctx.rate / 8; ++i) store_le64(lanes + 8 * i, ctx.a[i]);
+        const size_t n = std::min(left, ctx.rate);
+        std::memcpy(out, lanes, n);
+        out += n;
+        left -= n;
+        if (left == 0) break;
+        permute(ctx.a.data(), ctx.rounds);
+    }
+}
+
+void k12_init(K12Context& ctx) {
+    sponge_init(ctx.node, K12_RATE, 12, K12_FINAL_SUFFIX, K12_CV_LEN);
+    ctx.pending_len = 0;
+    ctx.total = 0;
+    ctx.leaves = 0;
+    ctx.tree = false;
+}
+
+void k12_update(K12Context& ctx, const uint8_t* data, size_t size) {
+    if (ctx.total < K12_CHUNK_LEN) {
+        const size_t take = static_cast<size_t>(std::min<uint64_t>(size, K12_CHUNK_LEN - ctx.total));
+        keccak_update(ctx.node, data, take);
+        ctx.total += take;
+        data += take;
+        size -= take;
+    }
+    if (size == 0) return;
+    start_tree(ctx);
+    ctx.total += size;
+
+    // Листья хешируются группами по четыре; неполная группа ждёт в pending.
+    const size_t group = ctx.pending.size();
+    if (ctx.pending_len) {
+        const size_t take = std::min(size, group - ctx.pending_len);
+        std::memcpy(ctx.pending.data() + ctx.pending_len, data, take);
+        ctx.pending_len += take;
+        data += take;
+        size -= take;
+        if (ctx.pending_len < group) return;
+        absorb_leaves(ctx, ctx.pending.data(), 4);
+        ctx.pending_len = 0;
+    }
+    const size_t direct = size / group * group;
+    absorb_leaves(ctx, data, direct / K12_CHUNK_LEN);
+    std::memcpy(ctx.pending.data(), data + direct, size - direct);
+    ctx.pending_len = size - direct;
+}
+
+void k12_final(K12Context& ctx, uint8_t* out, size_t size) {
+    // Строка персонализации пуста: к сообщению дописывается length_encode(0) = 00.
+    if (ctx.total < K12_CHUNK_LEN) {
+        const uint8_t zero = 0;
+        keccak_update(ctx.node, &zero, 1);
+        ctx.node.suffix = K12_SINGLE_SUFFIX;
+    } else {
+        start_tree(ctx);
+        ctx.pending[ctx.pending_len++] = 0;
+        const size_t full = ctx.pending_len / K12_CHUNK_LEN;
+        absorb_leaves(ctx, ctx.pending.data(), full);
+        const size_t rest = ctx.pending_len - full * K12_CHUNK_LEN;
+        if (rest) {
+            uint8_t cv[K12_CV_LEN];
+            leaf_cv(ctx.pending.data() + full * K12_CHUNK_LEN, rest, cv);
+            keccak_update(ctx.node, cv, sizeof(cv));
+            ++ctx.leaves;
+        }
+
+        // length_encode(число листьев), затем FF FF.
+        uint8_t trailer[11];
+        size_t n = 0;
+        for (uint64_t v = ctx.leaves; v; v >>= 8) ++n;
+        for (size_t i = 0; i < n; ++i) trailer[i] = static_cast<uint8_t>(ctx.leaves >> (8 * (n - 1 - i)));
+        trailer[n] = static_cast<uint8_t>(n);
+        trailer[n + 1] = 0xFF;
+        trailer[n + 2] = 0xFF;
+        keccak_update(ctx.node, trailer, n + 3);
+        ctx.node.suffix = K12_FINAL_SUFFIX;
+    }
+    ctx.node.out_len = size;
+    keccak_final(ctx.node, out);
+}
+
+std::string sha3_224_file(const std::string& filepath) {
+    return sha3_file(filepath, 224);
+}
+
+std::string sha3_256_file(const std::string& filepath) {
+    return sha3_file(filepath, 256);
+}
+
+std::string sha3_384_file(const std::string& filepath) {
+    return sha3_file(filepath, 384);
+}
+
+std::string sha3_512_file(const std::string& filepath) {
+    return sha3_file(filepath, 512);
+}
+
+std::string shake128_file(const std::string& filepath, size_t out_len) {
+    return shake_file(filepath, 128, out_len);
+}
+
+std::string shake256_file(const std::string& filepath, size_t out_len) {
+    return shake_file(filepath, 256, out_len);
+}
+
+std::string k12_file(const std::string& filepath, size_t out_len, unsigned threads) {
+    if (out_len == 0) return "";
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return "";
+    const uint64_t size = file.size();
+
+    K12Context ctx;
+    k12_init(ctx);
+    const uint64_t first = std::min<uint64_t>(size, K12_CHUNK_LEN);
+    if (!file.read_range(0, first, [&](const uint8_t* data, size_t n) { k12_update(ctx, data, n); })) return "";
+
+    // Полные листья после первого куска — сегментами по буферу пула параллельно.
+    // Сегменты идут пачками, и CV каждой пачки поглощаются узлом по порядку,
+    // поэтому память под CV не зависит от размера файла.
+    const uint64_t full = (size - first) / K12_CHUNK_LEN;
+    if (full > 0) {
+        const size_t per_segment = std::max<size_t>(1, buffer_pool::buffer_size() / K12_CHUNK_LEN);
+        const uint64_t segments = (full + per_segment - 1) / per_segment;
+        const size_t batch = 4 * static_cast<size_t>(threads ? threads : worker_count());
+        std::vector<uint8_t> cvs(batch * per_segment * K12_CV_LEN);
+        start_tree(ctx);
+        for (uint64_t base = 0; base < segments; base += batch) {
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(batch, segments - base));
+            std::atomic<bool> ok(true);
+            parallel_for(count, [&](size_t k) {
+                const uint64_t leaf = (base + k) * per_segment;
+                const size_t leaves = static_cast<size_t>(std::min<uint64_t>(per_segment, full - leaf));
+                const size_t bytes = leaves * K12_CHUNK_LEN;
+                buffer_pool::Buffer buffer = buffer_pool::acquire();
+                if (file.read_at(first + leaf * K12_CHUNK_LEN, buffer.data(), bytes) != static_cast<int64_t>(bytes)) {
+                    ok = false;
+                    return;
+                }
+                leaf_cvs(buffer.data(), leaves, cvs.data() + k * per_segment * K12_CV_LEN);
+            }, threads);
+            if (!ok) return "";
+            // Неполным может быть только последний сегмент файла, так что CV пачки идут подряд.
+            const uint64_t leaves = std::min<uint64_t>(full - base * per_segment, count * per_segment);
+            keccak_update(ctx.node, cvs.data(), static_cast<size_t>(leaves) * K12_CV_LEN);
+        }
+        ctx.leaves += full;
+        ctx.total += full * K12_CHUNK_LEN;
+    }
+
+    const uint64_t offset = first + full * K12_CHUNK_LEN;
+    if (!file.read_range(offset, size - offset, [&](const uint8_t* data, size_t n) { k12_update(ctx, data, n); }))
+        return "";
+    std::vector<uint8_t> out(out_len);
+    k12_final(ctx, out.data(), out_len);
+    return to_hex(out.data(), out.size());
+}
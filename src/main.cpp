@@ -7,7 +7,30 @@
  */
 
 #include <iostream>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
 #include "../include/hash.h"
+#include "../include/buffer_pool.h"
+#include "../include/midstate.h"
+#include "../include/checkpoint.h"
+#include "../include/hasher.h"
+#include "../include/piecewise.h"
+#include "../include/merkle.h"
+#include "../include/etag.h"
+#include "../include/tree_hash.h"
+#include "../include/torrent.h"
+#include "../include/git_hash.h"
+#include "../include/fsverity.h"
+#include "../include/cas.h"
+#include "../include/cdc.h"
+#include "../include/rsync.h"
+#include "../include/fuzzy.h"
+#include "../include/blake2.h"
+#include "../include/blake3.h"
+#include "../include/xxh3.h"
+#include "../include/crc32.h"
+#include "../include/keccak.h"
 
 /**
  * @brief Очищает экран консоли.
@@ -18,6 +41,132 @@ void clear_screen() {
     system("cls");
 }
 
+/**
+ * @brief Разбирает размер вида "512M", "4G", "65536".
+ *
+ * Допускаются суффиксы K, M, G, T (степени 1024), регистр не важен,
+ * необязательная буква B в конце ("512MB", "1GiB" тоже принимаются).
+ *
+ * @param text  Строка с размером.
+ * @param bytes Результат в байтах.
+ * @return false, если строка не является корректным размером.
+ */
+bool parse_size(const std::string& text, uint64_t& bytes) {
+    size_t pos = 0;
+    uint64_t value = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        if (value > (UINT64_MAX - 9) / 10) return false;
+        value = value * 10 + (text[pos++] - '0');
+    }
+    if (pos == 0) return false;
+
+    std::string suffix = text.substr(pos);
+    for (char& c : suffix) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    if (suffix == "B" || suffix.empty()) { bytes = value; return true; }
+
+    int shift;
+    switch (suffix[0]) {
+        case 'K': shift = 10; break;
+        case 'M': shift = 20; break;
+        case 'G': shift = 30; break;
+        case 'T': shift = 40; break;
+        default: return false;
+    }
+    std::string rest = suffix.substr(1);
+    if (!rest.empty() && rest != "B" && rest != "IB") return false;
+    if (value > (UINT64_MAX >> shift)) return false;
+    bytes = value << shift;
+    return true;
+}
+
+/**
+ * @brief Разбирает список диапазонов вида "0:1M,4G:512M" (смещение:длина).
+ *
+ * @return false, если хотя бы один диапазон записан некорректно.
+ */
+bool parse_ranges(const std::string& text, std::vector<ByteRange>& ranges) {
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        size_t colon = item.find(':');
+        if (colon == std::string::npos) return false;
+        ByteRange range;
+        if (!parse_size(item.substr(0, colon), range.offset)) return false;
+        if (!parse_size(item.substr(colon + 1), range.length)) return false;
+        ranges.push_back(range);
+    }
+    return !ranges.empty();
+}
+
+/// Параметры командной строки, не сводящиеся к настройке пула.
+struct CommandLine {
+    std::string action;           ///< "checkpoint", "range" или пусто — интерактивный режим.
+    std::string algo;             ///< Алгоритм для --checkpoint и --range.
+    std::string file;             ///< Хешируемый файл.
+    uint64_t checkpoint_interval = 0;
+    std::vector<ByteRange> ranges;
+};
+
+/**
+ * @brief Разбирает параметры командной строки.
+ *
+ * Поддерживаются:
+ * - --max-memory SIZE (или --max-memory=SIZE) — лимит памяти общего пула
+ *   буферов чтения;
+ * - --checkpoint ALGO FILE SIZE — хеширование без меню с контрольной точкой
+ *   каждые SIZE байт; повторный запуск после сбоя продолжает с неё;
+ * - --range ALGO FILE OFF:LEN[,OFF:LEN...] — хеши диапазонов байт без меню.
+ *
+ * --checkpoint и --range взаимоисключающие.
+ *
+ * @return false, если параметры некорректны.
+ */
+bool parse_options(int argc, char* argv[], CommandLine& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        if ((arg == "--checkpoint" || arg == "--range") && i + 3 < argc) {
+            if (!options.action.empty()) {
+                std::cerr << "only one of --checkpoint and --range may be given\n";
+                return false;
+            }
+            options.action = arg.substr(2);
+            options.algo = argv[++i];
+            options.file = argv[++i];
+            value = argv[++i];
+            if (!make_hasher(options.algo)) {
+                std::cerr << "unknown algorithm: " << options.algo << "\n";
+                return false;
+            }
+            if (options.action == "range" && !parse_ranges(value, options.ranges)) {
+                std::cerr << "invalid range list: " << value << "\n";
+                return false;
+            }
+            if (options.action == "checkpoint"
+                && (!parse_size(value, options.checkpoint_interval) || options.checkpoint_interval == 0)) {
+                std::cerr << "invalid interval: " << value << "\n";
+                return false;
+            }
+            continue;
+        }
+        if (arg == "--max-memory" && i + 1 < argc) {
+            value = argv[++i];
+        } else if (arg.rfind("--max-memory=", 0) == 0) {
+            value = arg.substr(std::strlen("--max-memory="));
+        } else {
+            std::cerr << "unknown option: " << arg << "\n";
+            return false;
+        }
+        uint64_t limit;
+        if (!parse_size(value, limit) || !buffer_pool::set_memory_limit(limit)) {
+            std::cerr << "invalid memory limit: " << value << " (at least "
+                      << (buffer_pool::MIN_BUFFER_SIZE >> 10) << "K)\n";
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Показывает меню возврата в главное меню или выхода из программы.
  */
@@ -40,7 +189,10 @@ void wait_menu_or_exit() {
 /**
  * @brief Отображает меню выбора алгоритма хеширования.
  *
- * @return Название алгоритма ("md5", "sha1", "sha256") или пустую строку для выхода.
+ * @return Название алгоритма ("md5", "sha1", "sha256", "sha384", "sha512", "sha512_256",
+ *         "blake3", "blake2b", "blake2s", "xxh3", "xxh128", "crc32", "crc32c",
+ *         "sha3_224", "sha3_256", "sha3_384", "sha3_512", "shake128", "shake256", "k12")
+ *         или пустую строку для выхода.
  */
 std::string select_algorithm() {
     while (true) {
@@ -49,6 +201,23 @@ std::string select_algorithm() {
         std::cout << "[1] md5\n";
         std::cout << "[2] sha1\n";
         std::cout << "[3] sha256\n";
+        std::cout << "[4] sha384\n";
+        std::cout << "[5] sha512\n";
+        std::cout << "[6] sha512/256\n";
+        std::cout << "[7] blake3\n";
+        std::cout << "[8] blake2b\n";
+        std::cout << "[9] blake2s\n";
+        std::cout << "[10] xxh3 (non-cryptographic, change detection only)\n";
+        std::cout << "[11] xxh128 (non-cryptographic, change detection only)\n";
+        std::cout << "[12] crc32 (gzip/zip checksum, non-cryptographic)\n";
+        std::cout << "[13] crc32c (iSCSI/ext4 checksum, non-cryptographic)\n";
+        std::cout << "[14] sha3-224\n";
+        std::cout << "[15] sha3-256\n";
+        std::cout << "[16] sha3-384\n";
+        std::cout << "[17] sha3-512\n";
+        std::cout << "[18] shake128 (256-bit output)\n";
+        std::cout << "[19] shake256 (512-bit output)\n";
+        std::cout << "[20] kangarootwelve\n";
         std::cout << "[0] back\n";
         std::cout << "> ";
         int choice;
@@ -57,6 +226,23 @@ std::string select_algorithm() {
             case 1: return "md5";
             case 2: return "sha1";
             case 3: return "sha256";
+            case 4: return "sha384";
+            case 5: return "sha512";
+            case 6: return "sha512_256";
+            case 7: return "blake3";
+            case 8: return "blake2b";
+            case 9: return "blake2s";
+            case 10: return "xxh3";
+            case 11: return "xxh128";
+            case 12: return "crc32";
+            case 13: return "crc32c";
+            case 14: return "sha3_224";
+            case 15: return "sha3_256";
+            case 16: return "sha3_384";
+            case 17: return "sha3_512";
+            case 18: return "shake128";
+            case 19: return "shake256";
+            case 20: return "k12";
             case 0: return "";
             default: std::cout << "invalid choice.\n";
         }
@@ -66,17 +252,49 @@ std::string select_algorithm() {
 /**
  * @brief Вычисляет хеш файла по указанному алгоритму.
  *
- * @param algo Алгоритм ("md5", "sha1", "sha256").
+ * @param algo Алгоритм (см. select_algorithm()).
  * @param filepath Путь к файлу.
+ * @param key Ключ для BLAKE2 в режиме MAC; пустой — обычный хеш.
  * @return Хеш в формате hex или пустая строка при ошибке.
  */
-std::string get_hash(const std::string& algo, const std::string& filepath) {
+std::string get_hash(const std::string& algo, const std::string& filepath, const std::string& key = "") {
     if (algo == "md5") return md5_file(filepath);
     if (algo == "sha1") return sha1_file(filepath);
     if (algo == "sha256") return sha256_file(filepath);
+    if (algo == "sha384") return sha384_file(filepath);
+    if (algo == "sha512") return sha512_file(filepath);
+    if (algo == "sha512_256") return sha512_256_file(filepath);
+    if (algo == "blake3") return blake3_file(filepath);
+    if (algo == "blake2b") return blake2b_file(filepath, key);
+    if (algo == "blake2s") return blake2s_file(filepath, key);
+    if (algo == "xxh3") return xxh3_file(filepath);
+    if (algo == "xxh128") return xxh128_file(filepath);
+    if (algo == "crc32") return crc32_file(filepath);
+    if (algo == "crc32c") return crc32c_file(filepath);
+    if (algo == "sha3_224") return sha3_224_file(filepath);
+    if (algo == "sha3_256") return sha3_256_file(filepath);
+    if (algo == "sha3_384") return sha3_384_file(filepath);
+    if (algo == "sha3_512") return sha3_512_file(filepath);
+    if (algo == "shake128") return shake128_file(filepath);
+    if (algo == "shake256") return shake256_file(filepath);
+    if (algo == "k12") return k12_file(filepath);
     return "";
 }
 
+/**
+ * @brief Запрашивает ключ для алгоритмов с режимом MAC (BLAKE2).
+ *
+ * @return Ключ или пустая строка, если алгоритм без ключа или ключ не задан ("-").
+ */
+std::string ask_key(const std::string& algo) {
+    if (algo != "blake2b" && algo != "blake2s") return "";
+    clear_screen();
+    std::string key;
+    std::cout << "enter key (- for plain hash):\n> ";
+    std::cin >> key;
+    return key == "-" ? "" : key;
+}
+
 /**
  * @brief Интерфейс режима получения хеша.
  *
@@ -90,6 +308,7 @@ void run_hash() {
     std::string filepath;
     std::cout << "enter file path:\n> ";
     std::cin >> filepath;
+    std::string key = ask_key(algo);
 
     clear_screen();
     std::cout << "select output:\n[1] console\n[2] file\n[0] back\n> ";
@@ -97,7 +316,7 @@ void run_hash() {
     std::cin >> output;
     if (output == 0) return;
 
-    std::string hash = get_hash(algo, filepath);
+    std::string hash = get_hash(algo, filepath, key);
 
     clear_screen();
     if (output == 1) {
@@ -137,6 +356,7 @@ void run_verify() {
     std::string filepath;
     std::cout << "enter file path:\n> ";
     std::cin >> filepath;
+    std::string key = ask_key(algo);
 
     clear_screen();
     std::cout << "hash input:\n[1] manual\n[2] from file\n[0] back\n> ";
@@ -165,11 +385,14 @@ void run_verify() {
         return;
     }
 
-    std::string actual = get_hash(algo, filepath);
+    std::string actual = get_hash(algo, filepath, key);
 
     clear_screen();
     if (expected == actual) {
         std::cout << "hash matches.\n";
+        std::unique_ptr<Hasher> hasher = make_hasher(algo);
+        if (hasher && !hasher->cryptographic())
+            std::cout << "note: " << algo << " is non-cryptographic; it detects accidental changes, not tampering.\n";
     } else {
         std::cout << "hash does not match.\n";
         std::cout << "expected:  " << expected << "\n";
@@ -179,17 +402,712 @@ void run_verify() {
     wait_menu_or_exit();
 }
 
+/**
+ * @brief Интерфейс режима повторного хеширования дописываемого файла.
+ *
+ * Хеш продолжается с midstate, сохранённого прошлым запуском рядом с файлом,
+ * поэтому читаются только дописанные с тех пор байты. Midstate есть только
+ * у алгоритмов Merkle–Damgård (md5, sha1, SHA‑2); для остальных файл
+ * хешировался бы целиком при каждом запуске, поэтому режим для них закрыт.
+ */
+void run_incremental() {
+    std::string algo = select_algorithm();
+    if (algo.empty()) return;
+
+    std::vector<uint32_t> state;
+    uint64_t length = 0;
+    if (!make_hasher(algo)->export_midstate(state, length)) {
+        clear_screen();
+        std::cout << algo << " keeps no midstate; incremental hashing supports md5, sha1 and sha-2 only.\n";
+        wait_menu_or_exit();
+        return;
+    }
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    clear_screen();
+    std::cout << "check tail of saved prefix:\n[1] yes\n[2] no (size/mtime only)\n[0] back\n> ";
+    int check;
+    std::cin >> check;
+    if (check == 0) return;
+
+    IncrementalResult result = hash_file_incremental(algo, filepath, check != 2);
+
+    clear_screen();
+    if (result.hash.empty()) {
+        std::cerr << "file read error.\n";
+    } else {
+        std::cout << "hash: " << result.hash << "\n";
+        std::cout << "reused prefix: " << result.reused << " bytes, read: " << result.hashed << " bytes\n";
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Выводит результат хеширования с контрольными точками.
+ * @return false при ошибке чтения.
+ */
+bool print_checkpointed(const CheckpointResult& result) {
+    if (result.hash.empty()) {
+        std::cerr << "file read error.\n";
+        return false;
+    }
+    if (result.resumed_from > 0)
+        std::cout << "resumed from offset " << result.resumed_from << "\n";
+    std::cout << "hash: " << result.hash << "\n";
+    return true;
+}
+
+/**
+ * @brief Интерфейс режима хеширования с контрольными точками.
+ *
+ * Для очень длинных файлов: состояние периодически сохраняется, и после
+ * сбоя повторный запуск продолжает вычисление с последней контрольной точки.
+ */
+void run_checkpointed() {
+    std::string algo = select_algorithm();
+    if (algo.empty()) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    clear_screen();
+    std::string interval_text;
+    std::cout << "checkpoint every (e.g. 4G):\n> ";
+    std::cin >> interval_text;
+    uint64_t interval;
+    if (!parse_size(interval_text, interval) || interval == 0) {
+        std::cerr << "invalid interval.\n";
+        wait_menu_or_exit();
+        return;
+    }
+
+    clear_screen();
+    print_checkpointed(hash_file_checkpointed(algo, filepath, interval));
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Выводит хеши диапазонов в виде "смещение+длина: хеш".
+ * @return false, если хотя бы один диапазон не прочитан.
+ */
+bool print_ranges(const std::vector<ByteRange>& ranges, const std::vector<std::string>& hashes) {
+    bool ok = true;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        std::cout << ranges[i].offset << "+" << ranges[i].length << ": ";
+        if (hashes[i].empty()) std::cout << "read error (file missing or range past end)\n";
+        else std::cout << hashes[i] << "\n";
+        ok = ok && !hashes[i].empty();
+    }
+    return ok;
+}
+
+/**
+ * @brief Интерфейс режима хеширования диапазонов байт файла.
+ *
+ * Несколько диапазонов одного файла хешируются параллельно.
+ */
+void run_ranges() {
+    std::string algo = select_algorithm();
+    if (algo.empty()) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    clear_screen();
+    std::string text;
+    std::cout << "enter ranges as offset:length, comma separated (e.g. 0:1M,4G:512M):\n> ";
+    std::cin >> text;
+    std::vector<ByteRange> ranges;
+    if (!parse_ranges(text, ranges)) {
+        std::cerr << "invalid range list.\n";
+        wait_menu_or_exit();
+        return;
+    }
+
+    clear_screen();
+    print_ranges(ranges, hash_file_ranges(algo, filepath, ranges));
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима поблочного хеширования (хеш на каждое окно файла).
+ *
+ * Создаёт таблицу хешей окон или сверяет файл с ранее созданной таблицей
+ * и показывает, в каких окнах есть повреждения.
+ */
+void run_piecewise() {
+    clear_screen();
+    std::cout << "piecewise mode:\n[1] create window table\n[2] check against window table\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode != 1 && mode != 2) return;
+
+    PiecewiseResult expected;
+    std::string algo;             ///< Алгоритм для --checkpoint и --range.
+    uint64_t window = 0;
+    std::string tablepath;
+    if (mode == 2) {
+        clear_screen();
+        std::cout << "enter window table path:\n> ";
+        std::cin >> tablepath;
+        if (!read_window_table(tablepath, expected)) {
+            std::cerr << "window table read error.\n";
+            wait_menu_or_exit();
+            return;
+        }
+        algo = expected.algo;
+        window = expected.window_size;
+    } else {
+        algo = select_algorithm();
+        if (algo.empty()) return;
+        clear_screen();
+        std::string text;
+        std::cout << "window size (e.g. 16M):\n> ";
+        std::cin >> text;
+        if (!parse_size(text, window) || window == 0) {
+            std::cerr << "invalid window size.\n";
+            wait_menu_or_exit();
+            return;
+        }
+    }
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    if (mode == 1) {
+        clear_screen();
+        std::cout << "enter output table file name:\n> ";
+        std::cin >> tablepath;
+    }
+
+    PiecewiseResult actual = piecewise_hash(algo, filepath, window);
+
+    clear_screen();
+    if (actual.hash.empty()) {
+        std::cerr << "file read error.\n";
+    } else if (mode == 1) {
+        if (write_window_table(tablepath, actual))
+            std::cout << actual.windows.size() << " windows saved to file.\ntotal: " << actual.hash << "\n";
+        else
+            std::cerr << "file write error.\n";
+    } else if (actual.hash == expected.hash && actual.size == expected.size) {
+        std::cout << "hash matches.\n";
+    } else {
+        std::cout << "hash does not match.\n";
+        for (size_t w : changed_windows(expected, actual)) {
+            uint64_t start = w * window;
+            std::cout << "changed window " << w << ": " << start << " - "
+                      << std::min(std::max(actual.size, expected.size), start + window) << "\n";
+        }
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима индекса Меркла.
+ *
+ * Строит индекс‑спутник "<файл>.merkle" или проверяет по нему диапазон
+ * байт, читая только затронутые листья.
+ */
+void run_merkle() {
+    clear_screen();
+    std::cout << "merkle index:\n[1] build index\n[2] verify range\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode != 1 && mode != 2) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    clear_screen();
+    if (mode == 1) {
+        std::string text;
+        std::cout << "leaf size (e.g. 4M):\n> ";
+        std::cin >> text;
+        uint64_t leaf;
+        std::string root;
+        clear_screen();
+        if (!parse_size(text, leaf) || leaf == 0) {
+            std::cerr << "invalid leaf size.\n";
+        } else if (merkle_build(filepath, "", leaf, root)) {
+            std::cout << "index saved to " << merkle_path(filepath) << "\nroot: " << root << "\n";
+        } else {
+            std::cerr << "file read or index write error.\n";
+        }
+    } else {
+        std::string text;
+        std::cout << "enter range as offset:length (e.g. 1G:4M):\n> ";
+        std::cin >> text;
+        std::vector<ByteRange> ranges;
+        std::vector<uint64_t> bad;
+        clear_screen();
+        if (!parse_ranges(text, ranges) || ranges.size() != 1) {
+            std::cerr << "invalid range.\n";
+        } else if (!merkle_verify_range(filepath, "", ranges[0].offset, ranges[0].length, bad)) {
+            std::cerr << "index or file read error (file changed size or range past end).\n";
+        } else if (bad.empty()) {
+            std::cout << "range is intact.\n";
+        } else {
+            std::cout << "range is corrupt.\n";
+            for (uint64_t leaf : bad) std::cout << "bad leaf " << leaf << "\n";
+        }
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима ETag объектов S3 (загрузка частями).
+ */
+void run_etag() {
+    clear_screen();
+    std::cout << "s3 etag:\n[1] compute etag\n[2] verify etag\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode != 1 && mode != 2) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    clear_screen();
+    if (mode == 1) {
+        std::string text;
+        std::cout << "part size (e.g. 8M):\n> ";
+        std::cin >> text;
+        uint64_t part;
+        clear_screen();
+        if (!parse_size(text, part) || part == 0) {
+            std::cerr << "invalid part size.\n";
+        } else {
+            std::string etag = s3_etag(filepath, part);
+            if (etag.empty()) std::cerr << "file read error.\n";
+            else std::cout << "etag: " << etag << "\n";
+        }
+    } else {
+        std::string expected;
+        std::cout << "enter expected etag:\n> ";
+        std::cin >> expected;
+        uint64_t part = 0;
+        clear_screen();
+        if (verify_s3_etag(filepath, expected, &part))
+            std::cout << "etag matches (part size " << part << " bytes).\n";
+        else
+            std::cout << "etag does not match.\n";
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима хешей облачных хранилищ (Glacier, Dropbox).
+ */
+void run_tree_hash() {
+    clear_screen();
+    std::cout << "select scheme:\n[1] glacier tree hash\n[2] dropbox content hash\n[0] back\n> ";
+    int scheme;
+    std::cin >> scheme;
+    if (scheme != 1 && scheme != 2) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    std::string hash = scheme == 1 ? glacier_tree_hash(filepath) : dropbox_content_hash(filepath);
+
+    clear_screen();
+    if (hash.empty()) std::cerr << "file read error.\n";
+    else std::cout << "hash: " << hash << "\n";
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима хешей кусков BitTorrent.
+ *
+ * Для файла или каталога создаёт хеши кусков v1 или v2 либо проверяет
+ * набор файлов по ранее сохранённым хешам.
+ */
+void run_torrent() {
+    clear_screen();
+    std::cout << "bittorrent pieces:\n[1] create v1 (sha1 pieces)\n[2] create v2 (sha256 merkle)\n"
+                 "[3] verify\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode < 1 || mode > 3) return;
+
+    clear_screen();
+    std::string path;
+    std::cout << "enter file or directory path:\n> ";
+    std::cin >> path;
+
+    clear_screen();
+    if (mode == 3) {
+        std::string hashfile;
+        std::cout << "enter piece hash file path:\n> ";
+        std::cin >> hashfile;
+        std::vector<std::string> bad;
+        clear_screen();
+        if (!torrent_verify(path, hashfile, bad)) {
+            std::cerr << "read error or file set differs.\n";
+        } else if (bad.empty()) {
+            std::cout << "all pieces match.\n";
+        } else {
+            std::cout << "pieces do not match:\n";
+            for (const std::string& item : bad) std::cout << item << "\n";
+        }
+        wait_menu_or_exit();
+        return;
+    }
+
+    std::string text, outpath;
+    std::cout << "piece size (e.g. 256K):\n> ";
+    std::cin >> text;
+    std::cout << "enter output file name:\n> ";
+    std::cin >> outpath;
+
+    uint64_t piece;
+    std::vector<std::string> files;
+    clear_screen();
+    if (!parse_size(text, piece) || piece == 0) {
+        std::cerr << "invalid piece size.\n";
+    } else if (!torrent_file_list(path, files)) {
+        std::cerr << "file read error.\n";
+    } else if (mode == 1) {
+        std::vector<std::string> pieces;
+        if (torrent_v1_pieces(files, piece, pieces) && write_torrent_v1(outpath, piece, pieces))
+            std::cout << pieces.size() << " pieces saved to file.\n";
+        else
+            std::cerr << "file read or write error.\n";
+    } else {
+        std::vector<TorrentV2File> hashes;
+        if (!torrent_v2_hashes(files, piece, hashes))
+            std::cerr << "file read error or piece size is not a power of two >= 16K.\n";
+        else if (!write_torrent_v2(outpath, piece, hashes))
+            std::cerr << "file write error.\n";
+        else
+            std::cout << hashes.size() << " files saved to file.\n";
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима идентификаторов git‑объектов.
+ *
+ * Для файла выводит id blob, для каталога — id tree (как `git write-tree`).
+ */
+void run_git_hash() {
+    clear_screen();
+    std::cout << "object format:\n[1] sha1\n[2] sha256\n[0] back\n> ";
+    int format;
+    std::cin >> format;
+    if (format != 1 && format != 2) return;
+    std::string algo = format == 1 ? "sha1" : "sha256";
+
+    clear_screen();
+    std::string path;
+    std::cout << "enter file or directory path:\n> ";
+    std::cin >> path;
+
+    std::error_code ec;
+    bool is_dir = std::filesystem::is_directory(path, ec);
+    std::string id = is_dir ? git_tree_id(path, algo) : git_blob_id(path, algo);
+
+    clear_screen();
+    if (id.empty()) std::cerr << "file read error.\n";
+    else std::cout << (is_dir ? "tree: " : "blob: ") << id << "\n";
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима дайджеста fs-verity.
+ *
+ * Для файла с включённым fs-verity дайджест берётся у ядра без чтения
+ * данных, иначе вычисляется. Можно сравнить с ожидаемым значением.
+ */
+void run_fsverity() {
+    clear_screen();
+    std::cout << "fs-verity digest:\n[1] compute\n[2] verify\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode != 1 && mode != 2) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    std::string expected;
+    if (mode == 2) {
+        std::cout << "enter expected digest:\n> ";
+        std::cin >> expected;
+        // Формат вывода `fsverity digest`: "sha256:<hex>".
+        if (expected.rfind("sha256:", 0) == 0) expected.erase(0, 7);
+    }
+
+    bool measured = false;
+    std::string digest = fsverity_digest(filepath, 0, &measured);
+
+    clear_screen();
+    if (digest.empty()) {
+        std::cerr << "file read error.\n";
+    } else {
+        std::cout << "sha256:" << digest << (measured ? " (kernel)\n" : " (computed)\n");
+        if (mode == 2) std::cout << (digest == expected ? "hash matches.\n" : "hash does not match.\n");
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима проверки хранилища, адресуемого по содержимому.
+ *
+ * Обходит каталог вида "<algo>/<digest>" (или OCI image layout) и выводит
+ * повреждённые и неверно названные блобы.
+ */
+void run_cas_verify() {
+    clear_screen();
+    std::string root;
+    std::cout << "enter store directory (OCI layout or <algo>/<digest>):\n> ";
+    std::cin >> root;
+
+    CasReport report;
+    bool ok = cas_verify(root, report);
+
+    clear_screen();
+    if (!ok) {
+        std::cerr << "file read error.\n";
+    } else {
+        std::cout << "verified: " << report.verified << " blobs, " << report.bytes << " bytes\n";
+        for (const std::string& path : report.corrupt) std::cout << "corrupt: " << path << "\n";
+        for (const std::string& path : report.misnamed) std::cout << "misnamed: " << path << "\n";
+        for (const std::string& path : report.unreadable) std::cout << "unreadable: " << path << "\n";
+        if (report.corrupt.empty() && report.misnamed.empty() && report.unreadable.empty())
+            std::cout << "store is intact.\n";
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима разбиения на куски FastCDC.
+ *
+ * Разбивает файл или каталог на куски с границами по содержимому,
+ * сохраняет список кусков с SHA‑256 и выводит коэффициент дедупликации.
+ */
+void run_cdc() {
+    clear_screen();
+    CdcParams params;
+    std::string text;
+    std::cout << "chunk sizes min/avg/max (e.g. 16K 64K 256K, 0 for defaults):\n> ";
+    std::cin >> text;
+    if (text != "0") {
+        std::string avg, max;
+        std::cin >> avg >> max;
+        if (!parse_size(text, params.min_size) || !parse_size(avg, params.avg_size)
+            || !parse_size(max, params.max_size) || !cdc_params_valid(params)) {
+            std::cerr << "invalid chunk sizes.\n";
+            wait_menu_or_exit();
+            return;
+        }
+    }
+
+    clear_screen();
+    std::string path;
+    std::cout << "enter file or directory path:\n> ";
+    std::cin >> path;
+
+    clear_screen();
+    std::string listpath;
+    std::cout << "enter output chunk list file name:\n> ";
+    std::cin >> listpath;
+
+    DedupStats stats;
+    bool ok = cdc_chunk_tree(path, params, listpath, stats);
+
+    clear_screen();
+    if (!ok) {
+        std::cerr << "file read error.\n";
+    } else {
+        std::cout << stats.files << " files, " << stats.chunks << " chunks (" << stats.unique_chunks
+                  << " unique) saved to file.\n";
+        std::cout << "total: " << stats.total_bytes << " bytes, unique: " << stats.unique_bytes << " bytes\n";
+        std::cout << "dedup ratio: " << stats.ratio() << "\n";
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима сигнатур и дельт rsync.
+ *
+ * Создаёт сигнатуру старого файла либо сравнивает с ней новый файл и
+ * выводит, сколько байт нужно передать.
+ */
+void run_rsync() {
+    clear_screen();
+    std::cout << "rsync mode:\n[1] create signature\n[2] compute delta\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode != 1 && mode != 2) return;
+
+    clear_screen();
+    std::string filepath;
+    std::cout << "enter file path:\n> ";
+    std::cin >> filepath;
+
+    clear_screen();
+    if (mode == 1) {
+        std::cout << "strong checksum:\n[1] md5\n[2] sha256\n> ";
+        int strong;
+        std::cin >> strong;
+        std::string text;
+        std::cout << "block size (e.g. 2K):\n> ";
+        std::cin >> text;
+        uint64_t block = 0;
+        if ((strong != 1 && strong != 2) || !parse_size(text, block) || block == 0) {
+            std::cerr << "invalid input option.\n";
+            wait_menu_or_exit();
+            return;
+        }
+        std::string sigpath;
+        std::cout << "enter output signature file name:\n> ";
+        std::cin >> sigpath;
+
+        RsyncSignature signature;
+        clear_screen();
+        if (!rsync_signature(filepath, strong == 1 ? "md5" : "sha256", block, signature))
+            std::cerr << "file read error.\n";
+        else if (!write_signature(sigpath, signature))
+            std::cerr << "file write error.\n";
+        else
+            std::cout << signature.weak.size() << " blocks saved to file.\n";
+    } else {
+        std::string sigpath, deltapath;
+        std::cout << "enter signature file path:\n> ";
+        std::cin >> sigpath;
+        std::cout << "enter output delta file name:\n> ";
+        std::cin >> deltapath;
+
+        RsyncSignature signature;
+        RsyncDelta delta;
+        clear_screen();
+        if (!read_signature(sigpath, signature))
+            std::cerr << "signature read error.\n";
+        else if (!rsync_delta(filepath, signature, delta))
+            std::cerr << "file read error.\n";
+        else if (!write_delta(deltapath, delta))
+            std::cerr << "file write error.\n";
+        else
+            std::cout << "matched: " << delta.matched_bytes << " bytes, to send: "
+                      << delta.literal_bytes << " bytes\n";
+    }
+
+    wait_menu_or_exit();
+}
+
+/**
+ * @brief Интерфейс режима нечёткого хеширования.
+ *
+ * Вычисляет MD5, SHA‑256 и подпись ssdeep за одно чтение файла либо
+ * сравнивает две подписи.
+ */
+void run_fuzzy() {
+    clear_screen();
+    std::cout << "fuzzy hash:\n[1] hash file (md5, sha256, ssdeep)\n[2] compare signatures\n[0] back\n> ";
+    int mode;
+    std::cin >> mode;
+    if (mode != 1 && mode != 2) return;
+
+    clear_screen();
+    if (mode == 1) {
+        std::string filepath;
+        std::cout << "enter file path:\n> ";
+        std::cin >> filepath;
+
+        std::vector<std::string> digests;
+        std::string fuzzy;
+        bool ok = fuzzy_hash_file(filepath, { "md5", "sha256" }, digests, fuzzy);
+
+        clear_screen();
+        if (!ok) {
+            std::cerr << "file read error.\n";
+        } else {
+            std::cout << "md5: " << digests[0] << "\nsha256: " << digests[1] << "\n";
+            std::cout << "ssdeep: " << fuzzy << "\n";
+        }
+    } else {
+        std::string first, second;
+        std::cout << "enter first signature:\n> ";
+        std::cin >> first;
+        std::cout << "enter second signature:\n> ";
+        std::cin >> second;
+
+        int score = fuzzy_compare(first, second);
+        clear_screen();
+        if (score < 0) std::cerr << "invalid signature.\n";
+        else std::cout << "similarity: " << score << "\n";
+    }
+
+    wait_menu_or_exit();
+}
+
 /**
  * @brief Главная функция. Отображает основное меню и запускает выбранный режим.
  *
  * Цикл продолжается до тех пор, пока пользователь не выберет выход.
+ * Использование: hash_verifier [--max-memory SIZE]
+ *                [--checkpoint ALGO FILE SIZE | --range ALGO FILE OFF:LEN[,OFF:LEN...]]
  */
-int main() {
+int main(int argc, char* argv[]) {
+    CommandLine options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "usage: hash_verifier [--max-memory SIZE]\n"
+                     "                     [--checkpoint ALGO FILE SIZE | --range ALGO FILE OFF:LEN[,OFF:LEN...]]\n";
+        return 1;
+    }
+    if (options.action == "checkpoint")
+        return print_checkpointed(hash_file_checkpointed(options.algo, options.file, options.checkpoint_interval)) ? 0 : 1;
+    if (options.action == "range")
+        return print_ranges(options.ranges, hash_file_ranges(options.algo, options.file, options.ranges)) ? 0 : 1;
+
     while (true) {
         clear_screen();
         std::cout << "=== main menu ===\n";
         std::cout << "[1] get hash\n";
         std::cout << "[2] verify hash\n";
+        std::cout << "[3] rehash appendable file\n";
+        std::cout << "[4] hash with checkpoints\n";
+        std::cout << "[5] hash byte ranges\n";
+        std::cout << "[6] piecewise hash\n";
+        std::cout << "[7] merkle index\n";
+        std::cout << "[8] s3 etag\n";
+        std::cout << "[9] glacier / dropbox hash\n";
+        std::cout << "[10] bittorrent pieces\n";
+        std::cout << "[11] git object id\n";
+        std::cout << "[12] fs-verity digest\n";
+        std::cout << "[13] verify content-addressed store\n";
+        std::cout << "[14] content-defined chunking\n";
+        std::cout << "[15] rsync signature / delta\n";
+        std::cout << "[16] fuzzy hash (ssdeep)\n";
         std::cout << "[0] exit\n";
         std::cout << "> ";
         int mode;
@@ -198,6 +1116,20 @@ int main() {
         switch (mode) {
             case 1: run_hash(); break;
             case 2: run_verify(); break;
+            case 3: run_incremental(); break;
+            case 4: run_checkpointed(); break;
+            case 5: run_ranges(); break;
+            case 6: run_piecewise(); break;
+            case 7: run_merkle(); break;
+            case 8: run_etag(); break;
+            case 9: run_tree_hash(); break;
+            case 10: run_torrent(); break;
+            case 11: run_git_hash(); break;
+            case 12: run_fsverity(); break;
+            case 13: run_cas_verify(); break;
+            case 14: run_cdc(); break;
+            case 15: run_rsync(); break;
+            case 16: run_fuzzy(); break;
             case 0: return 0;
             default: std::cout << "invalid choice.\n";
         }
@@ -0,0 +1,189 @@
+/**
+ * @file merkle.cpp
+ * @brief Индекс‑дерево Меркла для проверки произвольных диапазонов файла.
+ */
+
+#include "../include/merkle.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/parallel.h"
+
+#include <atomic>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    using Node = std::array<uint8_t, 32>;
+
+    const char MERKLE_MAGIC[] = "HMRK";
+    constexpr uint8_t MERKLE_VERSION = 1;
+    constexpr uint64_t MERKLE_HEADER = 32;
+
+    struct Header {
+        uint64_t leaf_size = 0;
+        uint64_t file_size = 0;
+        uint64_t leaf_count = 0;
+    };
+
+    /// Размеры уровней от листьев к корню.
+    std::vector<uint64_t> level_sizes(uint64_t leaf_count) {
+        std::vector<uint64_t> sizes = { leaf_count };
+        while (sizes.back() > 1) sizes.push_back((sizes.back() + 1) / 2);
+        return sizes;
+    }
+
+    Node hash_children(const Node& left, const Node& right) {
+        Sha256Context ctx;
+        sha256_init(ctx);
+        const uint8_t tag = 0x01;
+        sha256_update(ctx, &tag, 1);
+        sha256_update(ctx, left.data(), left.size());
+        sha256_update(ctx, right.data(), right.size());
+        Node node;
+        sha256_final(ctx, node.data());
+        return node;
+    }
+
+    bool hash_leaf(const RandomAccessFile& file, uint64_t offset, uint64_t length, Node& node) {
+        Sha256Context ctx;
+        sha256_init(ctx);
+        const uint8_t tag = 0x00;
+        sha256_update(ctx, &tag, 1);
+        if (!file.read_range(offset, length, [&](const uint8_t* data, size_t size) { sha256_update(ctx, data, size); }))
+            return false;
+        sha256_final(ctx, node.data());
+        return true;
+    }
+
+    uint64_t leaf_count_for(uint64_t file_size, uint64_t leaf_size) {
+        return file_size == 0 ? 1 : (file_size + leaf_size - 1) / leaf_size;
+    }
+
+    bool read_header(const RandomAccessFile& index, Header& h) {
+        uint8_t raw[MERKLE_HEADER];
+        if (index.read_at(0, raw, sizeof(raw)) != static_cast<int64_t>(sizeof(raw))) return false;
+        if (std::string(reinterpret_cast<const char*>(raw), 4) != MERKLE_MAGIC || raw[4] != MERKLE_VERSION)
+            return false;
+        h.leaf_size = load_le64(raw + 8);
+        h.file_size = load_le64(raw + 16);
+        h.leaf_count = load_le64(raw + 24);
+        return h.leaf_size > 0 && h.leaf_count == leaf_count_for(h.file_size, h.leaf_size);
+    }
+
+    bool read_node(const RandomAccessFile& index, uint64_t position, Node& node) {
+        uint64_t offset = MERKLE_HEADER + position * node.size();
+        return index.read_at(offset, node.data(), node.size()) == static_cast<int64_t>(node.size());
+    }
+}
+
+std::string merkle_path(const std::string& filepath) {
+    return filepath + ".merkle";
+}
+
+bool merkle_build(const std::string& filepath, const std::string& index, uint64_t leaf_size,
+                  std::string& root, unsigned threads) {
+    if (leaf_size == 0) return false;
+    RandomAccessFile file(filepath);
+    if (!file.is_open()) return false;
+
+    const uint64_t size = file.size();
+    std::vector<uint64_t> sizes = level_sizes(leaf_count_for(size, leaf_size));
+    std::vector<std::vector<Node>> levels(sizes.size());
+    levels[0].resize(sizes[0]);
+
+    std::atomic<bool> ok(true);
+    parallel_for(sizes[0], [&](size_t i) {
+        uint64_t offset = i * leaf_size;
+        uint64_t length = std::min(leaf_size, size - std::min(size, offset));
+        if (!hash_leaf(file, offset, length, levels[0][i])) ok = false;
+    }, threads);
+    if (!ok) return false;
+
+    for (size_t k = 1; k < sizes.size(); ++k) {
+        const std::vector<Node>& below = levels[k - 1];
+        levels[k].resize(sizes[k]);
+        for (uint64_t i = 0; i < sizes[k]; ++i)
+            levels[k][i] = 2 * i + 1 < below.size() ? hash_children(below[2 * i], below[2 * i + 1]) : below[2 * i];
+    }
+
+    // Индекс пишется во временный файл и переименовывается, чтобы сбой
+    // посреди записи не оставил вместо старого индекса обрезанный.
+    const std::string path = index.empty() ? merkle_path(filepath) : index;
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out) return false;
+        std::string header(MERKLE_MAGIC, 4);
+        header.append(4, '\0');
+        header[4] = static_cast<char>(MERKLE_VERSION);
+        append_le64(header, leaf_size);
+        append_le64(header, size);
+        append_le64(header, sizes[0]);
+        out.write(header.data(), header.size());
+        for (const std::vector<Node>& level : levels)
+            for (const Node& node : level)
+                out.write(reinterpret_cast<const char*>(node.data()), node.size());
+        out.close();
+        if (!out) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+
+    root = to_hex(levels.back()[0].data(), 32);
+    return true;
+}
+
+bool merkle_verify_range(const std::string& filepath, const std::string& index,
+                         uint64_t offset, uint64_t length, std::vector<uint64_t>& bad_leaves) {
+    bad_leaves.clear();
+    RandomAccessFile file(filepath);
+    RandomAccessFile tree(index.empty() ? merkle_path(filepath) : index);
+    Header h;
+    if (!file.is_open() || !tree.is_open() || !read_header(tree, h)) return false;
+    if (file.size() != h.file_size || offset > h.file_size || length > h.file_size - offset) return false;
+    // Пустой диапазон не задевает ни одного листа; при offset == file_size
+    // номер «первого листа» равнялся бы leaf_count.
+    if (length == 0) return true;
+
+    std::vector<uint64_t> sizes = level_sizes(h.leaf_count);
+    std::vector<uint64_t> level_start(sizes.size(), 0);
+    for (size_t k = 1; k < sizes.size(); ++k) level_start[k] = level_start[k - 1] + sizes[k - 1];
+
+    Node root;
+    if (!read_node(tree, level_start.back(), root)) return false;
+
+    const uint64_t first = offset / h.leaf_size;
+    const uint64_t last = (offset + length - 1) / h.leaf_size;
+    std::vector<Node> leaves(last - first + 1);
+    std::vector<char> readable(leaves.size(), 1);
+    parallel_for(leaves.size(), [&](size_t i) {
+        uint64_t start = (first + i) * h.leaf_size;
+        uint64_t len = std::min(h.leaf_size, h.file_size - std::min(h.file_size, start));
+        if (!hash_leaf(file, start, len, leaves[i])) readable[i] = 0;
+    });
+
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        if (!readable[i]) return false;
+        Node node = leaves[i];
+        uint64_t position = first + i;
+        for (size_t k = 0; k + 1 < sizes.size(); ++k, position /= 2) {
+            uint64_t sibling = position ^ 1;
+            if (sibling >= sizes[k]) continue;
+            Node other;
+            if (!read_node(tree, level_start[k] + sibling, other)) return false;
+            node = position & 1 ? hash_children(other, node) : hash_children(node, other);
+        }
+        if (node != root) bad_leaves.push_back(first + i);
+    }
+    return true;
+}
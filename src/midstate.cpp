@@ -0,0 +1,139 @@
+/**
+ * @file midstate.cpp
+ * @brief Инкрементальное хеширование дописываемых файлов через сохранённый midstate.
+ */
+
+#include "../include/midstate.h"
+#include "../include/hasher.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Содержимое файла‑спутника.
+     *
+     * Формат текстовый, по одному полю в строке:
+     * @code
+     * midstate 1
+     * algo sha256
+     * size 1048576
+     * mtime 1700000000000000000
+     * prefix 1048576
+     * tail <sha256 последних байт префикса>
+     * state <H[0]> <H[1]> ...
+     * @endcode
+     */
+    struct Midstate {
+        std::string algo;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        uint64_t prefix = 0;
+        std::string tail;
+        std::vector<uint32_t> state;
+    };
+
+    bool load_midstate(const std::string& path, Midstate& m) {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::string key;
+        int version = 0;
+        if (!(in >> key >> version) || key != "midstate" || version != 1) return false;
+        in >> key >> m.algo >> key >> m.size >> key >> m.mtime >> key >> m.prefix >> key >> m.tail >> key;
+        if (!in || key != "state") return false;
+        uint32_t word;
+        while (in >> std::hex >> word) m.state.push_back(word);
+        return !m.state.empty();
+    }
+
+    bool save_midstate(const std::string& path, const Midstate& m) {
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp);
+            if (!out) return false;
+            out << "midstate 1\n"
+                << "algo " << m.algo << "\n"
+                << "size " << m.size << "\n"
+                << "mtime " << m.mtime << "\n"
+                << "prefix " << m.prefix << "\n"
+                << "tail " << m.tail << "\n"
+                << "state";
+            for (uint32_t word : m.state)
+                out << ' ' << std::hex << std::setw(8) << std::setfill('0') << word;
+            out << "\n";
+            if (!out) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) std::remove(tmp.c_str());
+        return !ec;
+    }
+
+    /// SHA‑256 последних MIDSTATE_TAIL_SIZE байт перед offset.
+    std::string tail_digest(const std::string& filepath, uint64_t offset) {
+        uint64_t len = std::min(offset, MIDSTATE_TAIL_SIZE);
+        Sha256Context ctx;
+        sha256_init(ctx);
+        if (!read_file_range(filepath, offset - len, len,
+                             [&](const uint8_t* data, size_t size) { sha256_update(ctx, data, size); }))
+            return "";
+        uint8_t digest[32];
+        sha256_final(ctx, digest);
+        return to_hex(digest, sizeof(digest));
+    }
+}
+
+std::string midstate_path(const std::string& filepath, const std::string& algo) {
+    return filepath + "." + algo + ".midstate";
+}
+
+IncrementalResult hash_file_incremental(const std::string& algo, const std::string& filepath, bool tail_check) {
+    IncrementalResult result;
+    std::error_code ec;
+    uint64_t size = std::filesystem::file_size(filepath, ec);
+    if (ec) return result;
+    int64_t mtime = std::filesystem::last_write_time(filepath, ec).time_since_epoch().count();
+    if (ec) return result;
+
+    std::unique_ptr<Hasher> hasher = make_hasher(algo);
+    if (!hasher) return result;
+    auto update = [&](const uint8_t* data, size_t n) { hasher->update(data, n); };
+
+    const std::string sidecar = midstate_path(filepath, algo);
+    Midstate saved;
+    uint64_t start = 0;
+    if (load_midstate(sidecar, saved) && saved.algo == algo
+        && saved.prefix <= size && size >= saved.size
+        && mtime >= saved.mtime && (size != saved.size || mtime == saved.mtime)
+        && (!tail_check || tail_digest(filepath, saved.prefix) == saved.tail)
+        && hasher->import_midstate(saved.state, saved.prefix)) {
+        start = saved.prefix;
+    }
+
+    // Midstate сохраняется после последнего целого блока, остаток
+    // (меньше блока) дочитывается при каждом запуске заново.
+    uint64_t prefix = size / hasher->block_size() * hasher->block_size();
+    if (!read_file_range(filepath, start, prefix - start, update)) return result;
+
+    Midstate next;
+    next.algo = algo;
+    next.size = size;
+    next.mtime = mtime;
+    next.prefix = prefix;
+    bool have_state = hasher->export_midstate(next.state, next.prefix);
+
+    if (!read_file_range(filepath, prefix, size - prefix, update)) return result;
+    std::string digest = hasher->digest();
+
+    result.hash = to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+    result.reused = start;
+    result.hashed = size - start;
+
+    next.tail = tail_digest(filepath, prefix);
+    if (have_state && !next.tail.empty()) save_midstate(sidecar, next);
+    return result;
+}
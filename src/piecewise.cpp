@@ -0,0 +1,130 @@
+/**
+ * @file piecewise.cpp
+ * @brief Поблочное хеширование файла окнами фиксированного размера.
+ */
+
+#include "../include/piecewise.h"
+#include "../include/hasher.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+namespace {
+    std::string hex_digest(Hasher& hasher) {
+        std::string digest = hasher.digest();
+        return to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+    }
+}
+
+PiecewiseResult piecewise_hash(const std::string& algo, const std::string& filepath,
+                               uint64_t window_size, unsigned threads) {
+    PiecewiseResult result;
+    result.algo = algo;
+    result.window_size = window_size;
+    if (window_size == 0) return result;
+
+    RandomAccessFile file(filepath);
+    std::unique_ptr<Hasher> whole = make_hasher(algo);
+    if (!file.is_open() || !whole) return result;
+
+    const uint64_t size = file.size();
+    const size_t count = static_cast<size_t>((size + window_size - 1) / window_size);
+    if (threads == 0) threads = worker_count();
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, count)));
+
+    std::vector<std::string> windows(count);
+    std::vector<std::unique_ptr<Hasher>> hashers(count);
+    bool ok = true;
+    {
+        // Окно w обрабатывается исполнителем w % threads, поэтому порции
+        // одного окна идут по порядку, а разные окна — параллельно.
+        SerialExecutor whole_executor;
+        std::vector<std::unique_ptr<SerialExecutor>> executors;
+        for (unsigned t = 0; t < threads; ++t) executors.push_back(std::make_unique<SerialExecutor>());
+
+        for (size_t w = 0; w < count && ok; ++w) {
+            const uint64_t start = w * window_size;
+            const uint64_t end = std::min(size, start + window_size);
+            SerialExecutor& executor = *executors[w % threads];
+            executor.submit([&, w] { hashers[w] = make_hasher(algo); });
+
+            for (uint64_t pos = start; pos < end; ) {
+                // Буфер отдаётся обоим потребителям и вернётся в пул после
+                // последнего из них; при нехватке памяти здесь ждём.
+                auto buffer = std::make_shared<buffer_pool::Buffer>(buffer_pool::acquire());
+                size_t want = static_cast<size_t>(std::min<uint64_t>(end - pos, buffer->size()));
+                int64_t got = file.read_at(pos, buffer->data(), want);
+                if (got <= 0) { ok = false; break; }
+                size_t n = static_cast<size_t>(got);
+                whole_executor.submit([&, buffer, n] { whole->update(buffer->data(), n); });
+                executor.submit([&, buffer, n, w] { hashers[w]->update(buffer->data(), n); });
+                pos += n;
+            }
+            executor.submit([&, w] {
+                windows[w] = hex_digest(*hashers[w]);
+                hashers[w].reset();
+            });
+        }
+    }
+    if (!ok) return result;
+
+    result.size = size;
+    result.windows = std::move(windows);
+    result.hash = hex_digest(*whole);
+    return result;
+}
+
+bool write_window_table(const std::string& path, const PiecewiseResult& result) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# piecewise " << result.algo << " window=" << result.window_size << " size=" << result.size << "\n";
+    for (size_t w = 0; w < result.windows.size(); ++w) {
+        uint64_t start = w * result.window_size;
+        uint64_t end = std::min(result.size, start + result.window_size);
+        out << start << " - " << end << ": " << result.windows[w] << "\n";
+    }
+    out << "total: " << result.hash << "\n";
+    return static_cast<bool>(out);
+}
+
+bool read_window_table(const std::string& path, PiecewiseResult& result) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    if (!std::getline(in, line)) return false;
+    std::istringstream header(line);
+    std::string hash_sign, tag, window, size;
+    header >> hash_sign >> tag >> result.algo >> window >> size;
+    if (hash_sign != "#" || tag != "piecewise" || window.rfind("window=", 0) != 0 || size.rfind("size=", 0) != 0)
+        return false;
+    std::istringstream window_value(window.substr(7)), size_value(size.substr(5));
+    if (!(window_value >> result.window_size) || !(size_value >> result.size)) return false;
+
+    result.windows.clear();
+    while (std::getline(in, line)) {
+        if (line.rfind("total: ", 0) == 0) {
+            result.hash = line.substr(7);
+            return true;
+        }
+        size_t colon = line.find(": ");
+        if (colon == std::string::npos) return false;
+        result.windows.push_back(line.substr(colon + 2));
+    }
+    return false;
+}
+
+std::vector<size_t> changed_windows(const PiecewiseResult& expected, const PiecewiseResult& actual) {
+    std::vector<size_t> changed;
+    size_t count = std::max(expected.windows.size(), actual.windows.size());
+    for (size_t w = 0; w < count; ++w) {
+        if (w >= expected.windows.size() || w >= actual.windows.size()
+            || expected.windows[w] != actual.windows[w])
+            changed.push_back(w);
+    }
+    return changed;
+}
@@ -0,0 +1,333 @@
+/**
+ * @file rsync.cpp
+ * @brief Сигнатуры и дельты в стиле rsync: скользящая слабая сумма и сильный хеш блоков.
+ */
+
+#include "../include/rsync.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/file_io.h"
+#include "../include/buffer_pool.h"
+#include "../include/parallel.h"
+#include "../include/cpu_features.h"
+
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    /// Окон, проверяемых за одно чтение нового файла.
+    constexpr size_t SCAN_SEGMENT = 64 << 10;
+
+    uint32_t pack(uint32_t a, uint32_t b) {
+        return ((b & 0xffff) << 16) | (a & 0xffff);
+    }
+
+    uint16_t tag_of(uint32_t weak) {
+        return static_cast<uint16_t>((weak >> 16) + (weak & 0xffff));
+    }
+
+    std::string strong_digest(Hasher& hasher, const uint8_t* data, size_t size) {
+        hasher.reset();
+        hasher.update(data, size);
+        return hasher.digest();
+    }
+
+    /// Слабая сумма данных, дописанных к уже посчитанным: b сдвигается на size·a.
+    uint32_t weak_extend(uint32_t weak, const uint8_t* data, size_t size) {
+        const uint32_t tail = rsync_weak(data, size);
+        const uint32_t a = weak & 0xffff;
+        return pack(a + (tail & 0xffff), (weak >> 16) + static_cast<uint32_t>(size) * a + (tail >> 16));
+    }
+
+    std::string hex(const std::string& bytes) {
+        return to_hex(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    }
+
+    bool bytes_from_hex(const std::string& text, std::string& out) {
+        if (text.size() % 2 != 0 || text.find_first_not_of("0123456789abcdef") != std::string::npos) return false;
+        out.clear();
+        for (size_t i = 0; i < text.size(); i += 2)
+            out += static_cast<char>(std::stoi(text.substr(i, 2), nullptr, 16));
+        return true;
+    }
+
+#ifdef HASH_X86_SIMD
+    /// a и b по 32‑байтным порциям: psadbw даёт Σxᵢ, pmaddubsw с весами 32..1 — Σ(32 − t)·xᵢ.
+    __attribute__((target("avx2")))
+    void weak_avx2(const uint8_t* data, size_t blocks, uint32_t& a, uint32_t& b) {
+        const __m256i weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                                 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+        const __m256i ones = _mm256_set1_epi16(1);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i s1 = zero, s2 = zero, prev = zero;
+        for (size_t j = 0; j < blocks; ++j) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32 * j));
+            prev = _mm256_add_epi32(prev, s1);
+            s1 = _mm256_add_epi32(s1, _mm256_sad_epu8(v, zero));
+            s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(_mm256_maddubs_epi16(v, weights), ones));
+        }
+        alignas(32) uint32_t lanes[3][8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), s1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), s2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), prev);
+        uint32_t sum1 = 0, sum2 = 0, sum_prev = 0;
+        for (int i = 0; i < 8; ++i) {
+            sum1 += lanes[0][i];
+            sum2 += lanes[1][i];
+            sum_prev += lanes[2][i];
+        }
+        a = sum1;
+        b = 32 * sum_prev + sum2;
+    }
+#endif
+}
+
+uint32_t rsync_weak(const uint8_t* data, size_t size) {
+    uint32_t a = 0, b = 0;
+    size_t done = 0;
+#ifdef HASH_X86_SIMD
+    if (size >= 64 && cpu_has_avx2()) {
+        done = size / 32 * 32;
+        weak_avx2(data, size / 32, a, b);
+    }
+#endif
+    for (size_t i = done; i < size; ++i) {
+        a += data[i];
+        b += a;
+    }
+    return pack(a, b);
+}
+
+void rsync_weak_windows(const uint8_t* data, size_t window, size_t count, uint32_t* out) {
+    if (count == 0) return;
+    // Первое окно — целиком, дальше прокатка: a += in − out, b += a − window·out.
+    const uint32_t first = rsync_weak(data, window);
+    uint32_t a = first & 0xffff, b = first >> 16;
+    out[0] = first;
+    const uint32_t w = static_cast<uint32_t>(window);
+    for (size_t k = 1; k < count; ++k) {
+        const uint32_t leaving = data[k - 1];
+        a += data[k + window - 1] - leaving;
+        b += a - w * leaving;
+        out[k] = pack(a, b);
+    }
+}
+
+bool rsync_signature(const std::string& filepath, const std::string& algo, uint64_t block_size,
+                     RsyncSignature& signature, unsigned threads) {
+    signature = RsyncSignature();
+    RandomAccessFile file(filepath);
+    if (block_size == 0 || !make_hasher(algo) || !file.is_open()) return false;
+
+    const uint64_t size = file.size();
+    const uint64_t blocks = (size + block_size - 1) / block_size;
+    signature.algo = algo;
+    signature.block_size = block_size;
+    signature.file_size = size;
+    signature.weak.resize(blocks);
+    signature.strong.resize(blocks);
+
+    // Задача читает столько блоков, сколько помещается в буфер пула; блок
+    // длиннее буфера проходит через него частями.
+    const uint64_t per_task = std::max<uint64_t>(1, buffer_pool::buffer_size() / block_size);
+    std::atomic<bool> ok(true);
+    parallel_for((blocks + per_task - 1) / per_task, [&](size_t task) {
+        const uint64_t first = task * per_task;
+        const uint64_t count = std::min(per_task, blocks - first);
+        const uint64_t offset = first * block_size;
+        const uint64_t length = std::min(count * block_size, size - offset);
+        buffer_pool::Buffer buffer = buffer_pool::acquire();
+        std::unique_ptr<Hasher> hasher = make_hasher(algo);
+        if (length <= buffer.size()) {
+            if (file.read_at(offset, buffer.data(), static_cast<size_t>(length)) != static_cast<int64_t>(length)) {
+                ok = false;
+                return;
+            }
+            for (uint64_t i = 0; i < count; ++i) {
+                const uint8_t* block = buffer.data() + i * block_size;
+                size_t n = static_cast<size_t>(std::min<uint64_t>(block_size, length - i * block_size));
+                signature.weak[first + i] = rsync_weak(block, n);
+                signature.strong[first + i] = strong_digest(*hasher, block, n);
+            }
+            return;
+        }
+        for (uint64_t i = 0; i < count && ok; ++i) {
+            const uint64_t begin = offset + i * block_size;
+            const uint64_t end = std::min(begin + block_size, size);
+            uint32_t weak = 0;
+            hasher->reset();
+            for (uint64_t pos = begin; pos < end; ) {
+                const size_t n = static_cast<size_t>(std::min<uint64_t>(buffer.size(), end - pos));
+                if (file.read_at(pos, buffer.data(), n) != static_cast<int64_t>(n)) {
+                    ok = false;
+                    return;
+                }
+                weak = weak_extend(weak, buffer.data(), n);
+                hasher->update(buffer.data(), n);
+                pos += n;
+            }
+            signature.weak[first + i] = weak;
+            signature.strong[first + i] = hasher->digest();
+        }
+    }, threads);
+    return ok;
+}
+
+bool write_signature(const std::string& path, const RsyncSignature& signature) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# rsync-signature " << signature.algo << " block=" << signature.block_size
+        << " size=" << signature.file_size << "\n";
+    for (size_t i = 0; i < signature.weak.size(); ++i) {
+        out << std::hex << std::setw(8) << std::setfill('0') << signature.weak[i] << std::dec
+            << " " << hex(signature.strong[i]) << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool read_signature(const std::string& path, RsyncSignature& signature) {
+    signature = RsyncSignature();
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    if (!std::getline(in, line)) return false;
+    std::istringstream header(line);
+    std::string hash_sign, tag, block, size;
+    header >> hash_sign >> tag >> signature.algo >> block >> size;
+    if (hash_sign != "#" || tag != "rsync-signature" || block.rfind("block=", 0) != 0 || size.rfind("size=", 0) != 0)
+        return false;
+    std::istringstream block_value(block.substr(6)), size_value(size.substr(5));
+    if (!(block_value >> signature.block_size) || !(size_value >> signature.file_size)) return false;
+    std::unique_ptr<Hasher> hasher = make_hasher(signature.algo);
+    if (!hasher || signature.block_size == 0) return false;
+
+    while (std::getline(in, line)) {
+        std::istringstream entry(line);
+        std::string weak, strong, bytes;
+        uint32_t value = 0;
+        if (!(entry >> weak >> strong) || weak.size() != 8 || !bytes_from_hex(strong, bytes)
+            || bytes.size() != hasher->digest_size())
+            return false;
+        // Ровно восемь hex‑цифр; std::stoul бросил бы исключение или остановился бы на первой не‑цифре.
+        if (weak.find_first_not_of("0123456789abcdef") != std::string::npos) return false;
+        if (std::from_chars(weak.data(), weak.data() + weak.size(), value, 16).ec != std::errc()) return false;
+        signature.weak.push_back(value);
+        signature.strong.push_back(bytes);
+    }
+    return signature.weak.size() == (signature.file_size + signature.block_size - 1) / signature.block_size;
+}
+
+bool rsync_delta(const std::string& filepath, const RsyncSignature& signature, RsyncDelta& delta) {
+    delta = RsyncDelta();
+    RandomAccessFile file(filepath);
+    const uint64_t L = signature.block_size;
+    std::unique_ptr<Hasher> hasher = make_hasher(signature.algo);
+    if (!file.is_open() || L == 0 || !hasher || signature.weak.size() != signature.strong.size())
+        return false;
+
+    const uint64_t size = file.size();
+    const uint64_t full_blocks = signature.file_size / L;
+    const uint64_t tail_length = signature.file_size % L;
+    if (signature.weak.size() != full_blocks + (tail_length ? 1 : 0)) return false;
+
+    std::unordered_map<uint32_t, std::vector<uint64_t>> table;
+    std::vector<bool> tags(1 << 16, false);
+    for (uint64_t j = 0; j < full_blocks; ++j) {
+        table[signature.weak[j]].push_back(j);
+        tags[tag_of(signature.weak[j])] = true;
+    }
+
+    uint64_t literal_start = 0;
+    auto emit = [&](uint64_t block, uint64_t offset, uint64_t length) {
+        if (offset > literal_start) {
+            delta.ops.push_back({ DeltaOp::LITERAL, literal_start, offset - literal_start });
+            delta.literal_bytes += offset - literal_start;
+        }
+        DeltaOp* last = delta.ops.empty() ? nullptr : &delta.ops.back();
+        if (last && last->block != DeltaOp::LITERAL && last->offset + last->length == offset
+            && last->block + last->length / L == block)
+            last->length += length;
+        else
+            delta.ops.push_back({ block, offset, length });
+        delta.matched_bytes += length;
+        literal_start = offset + length;
+    };
+
+    // Окна читаются в буфер пула. Блоку длиннее буфера нужно окно
+    // L + SCAN_SEGMENT − 1 байт вне пула: его размер задан сигнатурой.
+    buffer_pool::Buffer buffer = buffer_pool::acquire();
+    std::vector<uint8_t> large;
+    uint8_t* window = buffer.data();
+    size_t segment = SCAN_SEGMENT;
+    if (L < buffer.size()) {
+        segment = std::min(segment, buffer.size() - static_cast<size_t>(L) + 1);
+    } else {
+        large.resize(static_cast<size_t>(L) + SCAN_SEGMENT - 1);
+        window = large.data();
+    }
+
+    uint64_t expected = 0;
+    std::vector<uint32_t> weak;
+    for (uint64_t pos = 0; full_blocks > 0 && pos + L <= size; ) {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(segment, size - L - pos + 1));
+        const size_t length = static_cast<size_t>(count + L - 1);
+        weak.resize(count);
+        if (file.read_at(pos, window, length) != static_cast<int64_t>(length)) return false;
+        rsync_weak_windows(window, static_cast<size_t>(L), count, weak.data());
+
+        size_t k = 0;
+        while (k < count) {
+            if (!tags[tag_of(weak[k])]) { ++k; continue; }
+            auto it = table.find(weak[k]);
+            if (it == table.end()) { ++k; continue; }
+
+            std::string strong = strong_digest(*hasher, window + k, static_cast<size_t>(L));
+            uint64_t match = DeltaOp::LITERAL;
+            for (uint64_t j : it->second) {
+                if (signature.strong[j] != strong) continue;
+                if (match == DeltaOp::LITERAL || j == expected) match = j;
+                if (j == expected) break;
+            }
+            if (match == DeltaOp::LITERAL) { ++k; continue; }
+
+            emit(match, pos + k, L);
+            expected = match + 1;
+            k += static_cast<size_t>(L);
+        }
+        pos += k;
+    }
+
+    // Короткий последний блок старого файла может совпасть только с концом нового.
+    if (tail_length > 0 && size >= tail_length && size - tail_length >= literal_start) {
+        // Хвост короче блока и помещается в окно.
+        const uint64_t offset = size - tail_length;
+        const size_t n = static_cast<size_t>(tail_length);
+        if (file.read_at(offset, window, n) != static_cast<int64_t>(n)) return false;
+        if (rsync_weak(window, n) == signature.weak[full_blocks]
+            && strong_digest(*hasher, window, n) == signature.strong[full_blocks])
+            emit(full_blocks, offset, tail_length);
+    }
+    if (size > literal_start) {
+        delta.ops.push_back({ DeltaOp::LITERAL, literal_start, size - literal_start });
+        delta.literal_bytes += size - literal_start;
+    }
+    return true;
+}
+
+bool write_delta(const std::string& path, const RsyncDelta& delta) {
+    std::ofstream out(path);
+    if (!out) return false;
+    for (const DeltaOp& op : delta.ops) {
+        if (op.block == DeltaOp::LITERAL) out << "literal " << op.offset << " " << op.length << "\n";
+        else out << "copy " << op.block << " " << op.offset << " " << op.length << "\n";
+    }
+    return static_cast<bool>(out);
+}
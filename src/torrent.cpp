@@ -0,0 +1,294 @@
+/**
+ * @file torrent.cpp
+ * @brief Хеши кусков BitTorrent: v1 (SHA‑1 кусков) и v2 (деревья SHA‑256, BEP 52).
+ */
+
+#include "../include/torrent.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::string sha256_pair(const std::string& left, const std::string& right) {
+        Sha256Context ctx;
+        sha256_init(ctx);
+        sha256_update(ctx, reinterpret_cast<const uint8_t*>(left.data()), left.size());
+        sha256_update(ctx, reinterpret_cast<const uint8_t*>(right.data()), right.size());
+        uint8_t digest[32];
+        sha256_final(ctx, digest);
+        return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+    }
+
+    /// Корень поддерева над nodes, дополненного до width узлов хешем pad.
+    std::string subtree_root(std::vector<std::string> nodes, uint64_t width, std::string pad) {
+        nodes.resize(static_cast<size_t>(width), pad);
+        while (nodes.size() > 1) {
+            for (size_t i = 0; i < nodes.size() / 2; ++i)
+                nodes[i] = sha256_pair(nodes[2 * i], nodes[2 * i + 1]);
+            nodes.resize(nodes.size() / 2);
+        }
+        return nodes[0];
+    }
+
+    uint64_t next_pow2(uint64_t n) {
+        uint64_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::string bytes_from_hex(const std::string& hex) {
+        std::string out;
+        for (size_t i = 0; i + 1 < hex.size(); i += 2)
+            out += static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16));
+        return out;
+    }
+
+    std::string hex(const std::string& bytes) {
+        return to_hex(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    }
+
+    bool is_hex(const std::string& text) {
+        return !text.empty() && text.size() % 2 == 0
+            && text.find_first_not_of("0123456789abcdef") == std::string::npos;
+    }
+}
+
+bool torrent_file_list(const std::string& path, std::vector<std::string>& files) {
+    files.clear();
+    std::error_code ec;
+    if (fs::is_regular_file(path, ec)) {
+        files.push_back(path);
+        return true;
+    }
+    if (!fs::is_directory(path, ec)) return false;
+    for (fs::recursive_directory_iterator it(path, ec), end; it != end && !ec; it.increment(ec)) {
+        if (it->is_regular_file(ec)) files.push_back(it->path().generic_string());
+    }
+    if (ec) return false;
+    std::sort(files.begin(), files.end());
+    return true;
+}
+
+bool torrent_v1_pieces(const std::vector<std::string>& files, uint64_t piece_length,
+                       std::vector<std::string>& pieces, unsigned threads) {
+    if (piece_length == 0) return false;
+
+    // starts[i] — смещение файла i в общем потоке.
+    std::vector<uint64_t> starts;
+    uint64_t total = 0;
+    for (const std::string& f : files) {
+        std::error_code ec;
+        uint64_t size = fs::file_size(f, ec);
+        if (ec) return false;
+        starts.push_back(total);
+        total += size;
+    }
+
+    pieces.assign(static_cast<size_t>((total + piece_length - 1) / piece_length), "");
+    // Задача — отрезок соседних кусков: файл, на котором кончился один
+    // кусок, остаётся открытым для следующего.
+    const size_t tasks = std::min(pieces.size(), 4 * static_cast<size_t>(threads ? threads : worker_count()));
+    std::atomic<bool> ok(true);
+    parallel_for(tasks, [&](size_t t) {
+        std::unique_ptr<RandomAccessFile> file;
+        size_t open = files.size();
+        const size_t last = pieces.size() * (t + 1) / tasks;
+        for (size_t p = pieces.size() * t / tasks; p < last && ok; ++p) {
+            uint64_t begin = p * piece_length;
+            uint64_t end = std::min(total, begin + piece_length);
+            size_t f = std::upper_bound(starts.begin(), starts.end(), begin) - starts.begin() - 1;
+
+            Sha1Context ctx;
+            sha1_init(ctx);
+            for (uint64_t pos = begin; pos < end && ok; ++f) {
+                uint64_t file_end = f + 1 < starts.size() ? starts[f + 1] : total;
+                if (file_end <= pos) continue;
+                uint64_t len = std::min(end, file_end) - pos;
+                if (f != open) {
+                    file = std::make_unique<RandomAccessFile>(files[f]);
+                    open = f;
+                }
+                if (!file->read_range(pos - starts[f], len, [&](const uint8_t* data, size_t size) { sha1_update(ctx, data, size); }))
+                    ok = false;
+                pos += len;
+            }
+            uint8_t digest[20];
+            sha1_final(ctx, digest);
+            pieces[p].assign(reinterpret_cast<const char*>(digest), sizeof(digest));
+        }
+    }, threads);
+    return ok;
+}
+
+bool torrent_v2_hashes(const std::vector<std::string>& files, uint64_t piece_length,
+                       std::vector<TorrentV2File>& result, unsigned threads) {
+    if (piece_length < TORRENT_V2_BLOCK_SIZE || (piece_length & (piece_length - 1)) != 0) return false;
+    const uint64_t blocks_per_piece = piece_length / TORRENT_V2_BLOCK_SIZE;
+
+    // zero[h] — корень поддерева высоты h из нулевых листьев.
+    std::vector<std::string> zero = { std::string(32, '\0') };
+    for (int h = 0; h < 63; ++h) zero.push_back(sha256_pair(zero[h], zero[h]));
+    int piece_height = 0;
+    while ((1ull << piece_height) < blocks_per_piece) ++piece_height;
+
+    result.assign(files.size(), TorrentV2File());
+    uint64_t total_pieces = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::error_code ec;
+        result[i].path = files[i];
+        result[i].size = fs::file_size(files[i], ec);
+        if (ec) return false;
+        uint64_t count = (result[i].size + piece_length - 1) / piece_length;
+        result[i].layer.resize(static_cast<size_t>(count));
+        total_pieces += count;
+    }
+
+    // Задача — отрезок соседних кусков одного файла; файл открывается раз на задачу.
+    struct Task { size_t file; uint64_t first; uint64_t count; };
+    std::vector<Task> tasks;
+    const uint64_t span = std::max<uint64_t>(1, total_pieces / (4 * static_cast<uint64_t>(threads ? threads : worker_count())));
+    for (size_t i = 0; i < files.size(); ++i)
+        for (uint64_t p = 0; p < result[i].layer.size(); p += span)
+            tasks.push_back({ i, p, std::min<uint64_t>(span, result[i].layer.size() - p) });
+
+    std::atomic<bool> ok(true);
+    parallel_for(tasks.size(), [&](size_t t) {
+        TorrentV2File& entry = result[tasks[t].file];
+        RandomAccessFile file(entry.path);
+        for (uint64_t piece = tasks[t].first; piece < tasks[t].first + tasks[t].count && ok; ++piece) {
+            uint64_t begin = piece * piece_length;
+            uint64_t end = std::min(entry.size, begin + piece_length);
+
+            std::vector<std::string> leaves;
+            for (uint64_t pos = begin; pos < end; pos += TORRENT_V2_BLOCK_SIZE) {
+                Sha256Context ctx;
+                sha256_init(ctx);
+                uint64_t len = std::min(TORRENT_V2_BLOCK_SIZE, end - pos);
+                if (!file.read_range(pos, len, [&](const uint8_t* data, size_t size) { sha256_update(ctx, data, size); }))
+                    ok = false;
+                uint8_t digest[32];
+                sha256_final(ctx, digest);
+                leaves.emplace_back(reinterpret_cast<const char*>(digest), sizeof(digest));
+            }
+            // Файл не больше куска дополняется только до степени двойки своих блоков.
+            uint64_t width = entry.size > piece_length ? blocks_per_piece : next_pow2(leaves.size());
+            entry.layer[piece] = subtree_root(leaves, width, zero[0]);
+        }
+    }, threads);
+    if (!ok) return false;
+
+    for (TorrentV2File& entry : result) {
+        if (entry.layer.empty()) continue;
+        entry.root = subtree_root(entry.layer, next_pow2(entry.layer.size()), zero[piece_height]);
+        if (entry.size <= piece_length) entry.layer.clear();
+    }
+    return true;
+}
+
+bool write_torrent_v1(const std::string& path, uint64_t piece_length, const std::vector<std::string>& pieces) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# bittorrent v1 piece=" << piece_length << "\n";
+    for (const std::string& p : pieces) out << hex(p) << "\n";
+    return static_cast<bool>(out);
+}
+
+bool write_torrent_v2(const std::string& path, uint64_t piece_length, const std::vector<TorrentV2File>& files) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# bittorrent v2 piece=" << piece_length << "\n";
+    for (const TorrentV2File& f : files) {
+        out << "file " << f.size << " " << f.path << "\n";
+        out << "root " << (f.root.empty() ? "-" : hex(f.root)) << "\n";
+        for (const std::string& h : f.layer) out << hex(h) << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool read_torrent_hashes(const std::string& path, int& version, uint64_t& piece_length,
+                         std::vector<std::string>& pieces, std::vector<TorrentV2File>& files) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line, hash_sign, tag, v, piece;
+    if (!std::getline(in, line)) return false;
+    std::istringstream header(line);
+    header >> hash_sign >> tag >> v >> piece;
+    if (hash_sign != "#" || tag != "bittorrent" || (v != "v1" && v != "v2") || piece.rfind("piece=", 0) != 0)
+        return false;
+    std::istringstream piece_value(piece.substr(6));
+    if (!(piece_value >> piece_length)) return false;
+    version = v == "v1" ? 1 : 2;
+
+    pieces.clear();
+    files.clear();
+    while (std::getline(in, line)) {
+        if (version == 2 && line.rfind("file ", 0) == 0) {
+            std::istringstream item(line.substr(5));
+            TorrentV2File f;
+            if (!(item >> f.size)) return false;
+            std::getline(item >> std::ws, f.path);
+            files.push_back(f);
+        } else if (version == 2 && line.rfind("root ", 0) == 0 && !files.empty()) {
+            std::string root = line.substr(5);
+            if (root != "-" && !is_hex(root)) return false;
+            files.back().root = root == "-" ? "" : bytes_from_hex(root);
+        } else if (is_hex(line)) {
+            if (version == 1) pieces.push_back(bytes_from_hex(line));
+            else if (!files.empty()) files.back().layer.push_back(bytes_from_hex(line));
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool torrent_verify(const std::string& path, const std::string& hashfile, std::vector<std::string>& bad) {
+    bad.clear();
+    int version;
+    uint64_t piece_length;
+    std::vector<std::string> expected_pieces, files;
+    std::vector<TorrentV2File> expected_files;
+    if (!read_torrent_hashes(hashfile, version, piece_length, expected_pieces, expected_files)) return false;
+    if (!torrent_file_list(path, files)) return false;
+
+    if (version == 1) {
+        std::vector<std::string> pieces;
+        if (!torrent_v1_pieces(files, piece_length, pieces)) return false;
+        if (pieces.size() != expected_pieces.size()) return false;
+        for (size_t p = 0; p < pieces.size(); ++p)
+            if (pieces[p] != expected_pieces[p]) bad.push_back("piece " + std::to_string(p));
+        return true;
+    }
+
+    std::vector<TorrentV2File> actual;
+    if (!torrent_v2_hashes(files, piece_length, actual)) return false;
+    if (actual.size() != expected_files.size()) return false;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        const TorrentV2File& a = actual[i];
+        const TorrentV2File& e = expected_files[i];
+        if (a.size != e.size) return false;
+        if (a.layer.empty() || a.layer.size() != e.layer.size()) {
+            if (a.root != e.root) bad.push_back(a.path);
+            continue;
+        }
+        bool piece_bad = false;
+        for (size_t p = 0; p < a.layer.size(); ++p)
+            if (a.layer[p] != e.layer[p]) {
+                bad.push_back(a.path + " piece " + std::to_string(p));
+                piece_bad = true;
+            }
+        // Расхождение корня без расхождения кусков — испорчен сам файл хешей.
+        if (a.root != e.root && !piece_bad) bad.push_back(a.path);
+    }
+    return true;
+}
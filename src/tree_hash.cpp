@@ -0,0 +1,50 @@
+/**
+ * @file tree_hash.cpp
+ * @brief Хеши‑от‑хешей облачных хранилищ: Glacier tree hash и Dropbox content_hash.
+ */
+
+#include "../include/tree_hash.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/file_io.h"
+
+#include <vector>
+
+namespace {
+    std::string sha256_concat(const std::string& a, const std::string& b = "") {
+        Sha256Context ctx;
+        sha256_init(ctx);
+        sha256_update(ctx, reinterpret_cast<const uint8_t*>(a.data()), a.size());
+        sha256_update(ctx, reinterpret_cast<const uint8_t*>(b.data()), b.size());
+        uint8_t digest[32];
+        sha256_final(ctx, digest);
+        return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+    }
+}
+
+std::string glacier_tree_hash(const std::string& filepath, unsigned threads) {
+    RandomAccessFile file(filepath);
+    std::vector<std::string> level;
+    if (!file.is_open() || !digest_chunks("sha256", file, GLACIER_CHUNK_SIZE, level, threads)) return "";
+
+    while (level.size() > 1) {
+        std::vector<std::string> next;
+        for (size_t i = 0; i < level.size(); i += 2)
+            next.push_back(i + 1 < level.size() ? sha256_concat(level[i], level[i + 1]) : level[i]);
+        level.swap(next);
+    }
+    return to_hex(reinterpret_cast<const uint8_t*>(level[0].data()), level[0].size());
+}
+
+std::string dropbox_content_hash(const std::string& filepath, unsigned threads) {
+    RandomAccessFile file(filepath);
+    std::vector<std::string> blocks;
+    if (!file.is_open() || !digest_chunks("sha256", file, DROPBOX_BLOCK_SIZE, blocks, threads)) return "";
+    // У пустого файла блоков нет: content_hash — SHA‑256 пустой строки.
+    if (file.size() == 0) blocks.clear();
+
+    std::string joined;
+    for (const std::string& b : blocks) joined += b;
+    std::string digest = sha256_concat(joined);
+    return to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+}
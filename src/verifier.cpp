@@ -5,6 +5,10 @@
 
 #include "../include/verifier.h"
 #include "../include/hash.h"
+#include "../include/blake2.h"
+#include "../include/blake3.h"
+#include "../include/keccak.h"
+#include "../include/xxh3.h"
 
 bool verify_md5(const std::string& path, const std::string& expected) {
     std::string actual = md5_file(path);
@@ -19,4 +23,49 @@ bool verify_sha1(const std::string& path, const std::string& expected) {
 bool verify_sha256(const std::string& path, const std::string& expected) {
     std::string actual = sha256_file(path);
     return actual == expected;
-}
\ No newline at end of file
+}
+
+bool verify_sha384(const std::string& path, const std::string& expected) {
+    std::string actual = sha384_file(path);
+    return actual == expected;
+}
+
+bool verify_sha512(const std::string& path, const std::string& expected) {
+    std::string actual = sha512_file(path);
+    return actual == expected;
+}
+
+bool verify_sha512_256(const std::string& path, const std::string& expected) {
+    std::string actual = sha512_256_file(path);
+    return actual == expected;
+}
+
+bool verify_blake2b(const std::string& path, const std::string& expected, const std::string& key) {
+    std::string actual = blake2b_file(path, key);
+    return actual == expected;
+}
+
+bool verify_blake2s(const std::string& path, const std::string& expected, const std::string& key) {
+    std::string actual = blake2s_file(path, key);
+    return actual == expected;
+}
+
+bool verify_blake3(const std::string& path, const std::string& expected) {
+    std::string actual = blake3_file(path);
+    return actual == expected;
+}
+
+bool verify_sha3_256(const std::string& path, const std::string& expected) {
+    std::string actual = sha3_256_file(path);
+    return actual == expected;
+}
+
+bool verify_xxh3(const std::string& path, const std::string& expected) {
+    std::string actual = xxh3_file(path);
+    return actual == expected;
+}
+
+bool verify_xxh128(const std::string& path, const std::string& expected) {
+    std::string actual = xxh128_file(path);
+    return actual == expected;
+}
@@ -0,0 +1,566 @@
+/**
+ * @file xxh3.cpp
+ * @brief XXH3‑64 и XXH128 (некриптографические): короткие ветки, потоковое
+ *        состояние и ядра накопления SSE2/AVX2/AVX‑512.
+ */
+
+#include "../include/xxh3.h"
+#include "../include/hash.h"
+#include "../include/file_io.h"
+#include "../include/byte_order.h"
+#include "../include/cpu_features.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef HASH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    constexpr uint32_t PRIME32_1 = 0x9E3779B1U;
+    constexpr uint32_t PRIME32_2 = 0x85EBCA77U;
+    constexpr uint32_t PRIME32_3 = 0xC2B2AE3DU;
+    constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+    constexpr uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+    constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+    /// Стандартный секрет XXH3 (192 байта).
+    const uint8_t SECRET[192] = {
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+        0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+        0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+        0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+        0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+        0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+        0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+        0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+        0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+    };
+
+    constexpr size_t STRIPE_LEN = 64;
+    constexpr size_t SECRET_CONSUME_RATE = 8;
+    /// Полос в блоке: секрет сдвигается на 8 байт за полосу, пока не кончится.
+    constexpr size_t STRIPES_PER_BLOCK = (sizeof(SECRET) - STRIPE_LEN) / SECRET_CONSUME_RATE;
+    constexpr size_t SECRET_LASTACC_START = 7;
+    constexpr size_t SECRET_MERGEACCS_START = 11;
+    constexpr size_t SECRET_SIZE_MIN = 136;
+    constexpr size_t MIDSIZE_MAX = 240;
+    constexpr size_t MIDSIZE_STARTOFFSET = 3;
+    constexpr size_t MIDSIZE_LASTOFFSET = 17;
+
+    const uint64_t INIT_ACC[8] = {
+        PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+    };
+
+    inline uint64_t rotl64(uint64_t x, int n) {
+        return (x << n) | (x >> (64 - n));
+    }
+
+    inline uint32_t rotl32(uint32_t x, int n) {
+        return (x << n) | (x >> (32 - n));
+    }
+
+    inline uint64_t swap64(uint64_t x) {
+        uint8_t b[8];
+        store_le64(b, x);
+        return load_be64(b);
+    }
+
+    inline uint32_t swap32(uint32_t x) {
+        uint8_t b[4];
+        store_le32(b, x);
+        return load_be32(b);
+    }
+
+    /// Полное 128‑битное произведение из 32‑битных половин.
+    inline void mult64to128(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+        const uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+        const uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+        const uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+        const uint64_t hi_hi = (a >> 32) * (b >> 32);
+        const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+        hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+        lo = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    }
+
+    inline uint64_t mul128_fold64(uint64_t a, uint64_t b) {
+        uint64_t lo, hi;
+        mult64to128(a, b, lo, hi);
+        return lo ^ hi;
+    }
+
+    inline uint64_t xxh64_avalanche(uint64_t h) {
+        h ^= h >> 33;
+        h *= PRIME64_2;
+        h ^= h >> 29;
+        h *= PRIME64_3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    inline uint64_t avalanche(uint64_t h) {
+        h ^= h >> 37;
+        h *= PRIME_MX1;
+        h ^= h >> 32;
+        return h;
+    }
+
+    inline uint64_t rrmxmx(uint64_t h, uint64_t len) {
+        h ^= rotl64(h, 49) ^ rotl64(h, 24);
+        h *= PRIME_MX2;
+        h ^= (h >> 35) + len;
+        h *= PRIME_MX2;
+        h ^= h >> 28;
+        return h;
+    }
+
+    inline uint64_t mix16b(const uint8_t* input, const uint8_t* secret) {
+        return mul128_fold64(load_le64(input) ^ load_le64(secret), load_le64(input + 8) ^ load_le64(secret + 8));
+    }
+
+    // ---------- Короткие входы (до 240 байт), XXH3‑64 ----------
+
+    uint64_t short_64(const uint8_t* input, size_t len) {
+        const uint8_t* secret = SECRET;
+        if (len == 0) return xxh64_avalanche(load_le64(secret + 56) ^ load_le64(secret + 64));
+        if (len <= 3) {
+            const uint32_t combined = (uint32_t(input[0]) << 16) | (uint32_t(input[len >> 1]) << 24)
+                                    | uint32_t(input[len - 1]) | (uint32_t(len) << 8);
+            const uint64_t bitflip = load_le32(secret) ^ load_le32(secret + 4);
+            return xxh64_avalanche(combined ^ bitflip);
+        }
+        if (len <= 8) {
+            const uint64_t input64 = load_le32(input + len - 4) + (uint64_t(load_le32(input)) << 32);
+            const uint64_t bitflip = load_le64(secret + 8) ^ load_le64(secret + 16);
+            return rrmxmx(input64 ^ bitflip, len);
+        }
+        if (len <= 16) {
+            const uint64_t lo = load_le64(input) ^ load_le64(secret + 24) ^ load_le64(secret + 32);
+            const uint64_t hi = load_le64(input + len - 8) ^ load_le64(secret + 40) ^ load_le64(secret + 48);
+            return avalanche(len + swap64(lo) + hi + mul128_fold64(lo, hi));
+        }
+        uint64_t acc = len * PRIME64_1;
+        if (len <= 128) {
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96) {
+                        acc += mix16b(input + 48, secret + 96);
+                        acc += mix16b(input + len - 64, secret + 112);
+                    }
+                    acc += mix16b(input + 32, secret + 64);
+                    acc += mix16b(input + len - 48, secret + 80);
+                }
+                acc += mix16b(input + 16, secret + 32);
+                acc += mix16b(input + len - 32, secret + 48);
+            }
+            acc += mix16b(input, secret);
+            acc += mix16b(input + len - 16, secret + 16);
+            return avalanche(acc);
+        }
+        const size_t rounds = len / 16;
+        for (size_t i = 0; i < 8; ++i) acc += mix16b(input + 16 * i, secret + 16 * i);
+        acc = avalanche(acc);
+        for (size_t i = 8; i < rounds; ++i)
+            acc += mix16b(input + 16 * i, secret + 16 * (i - 8) + MIDSIZE_STARTOFFSET);
+        acc += mix16b(input + len - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET);
+        return avalanche(acc);
+    }
+
+    // ---------- Короткие входы (до 240 байт), XXH128 ----------
+
+    inline void mix32b(uint64_t& low, uint64_t& high, const uint8_t* input1, const uint8_t* input2,
+                       const uint8_t* secret) {
+        low += mix16b(input1, secret);
+        low ^= load_le64(input2) + load_le64(input2 + 8);
+        high += mix16b(input2, secret + 16);
+        high ^= load_le64(input1) + load_le64(input1 + 8);
+    }
+
+    Xxh128Hash finish_mid_128(uint64_t low, uint64_t high, size_t len) {
+        Xxh128Hash h;
+        h.low = avalanche(low + high);
+        h.high = 0 - avalanche(low * PRIME64_1 + high * PRIME64_4 + len * PRIME64_2);
+        return h;
+    }
+
+    Xxh128Hash short_128(const uint8_t* input, size_t len) {
+        const uint8_t* secret = SECRET;
+        Xxh128Hash h;
+        if (len == 0) {
+            h.low = xxh64_avalanche(load_le64(secret + 64) ^ load_le64(secret + 72));
+            h.high = xxh64_avalanche(load_le64(secret + 80) ^ load_le64(secret + 88));
+            return h;
+        }
+        if (len <= 3) {
+            const uint32_t combined_lo = (uint32_t(input[0]) << 16) | (uint32_t(input[len >> 1]) << 24)
+                                       | uint32_t(input[len - 1]) | (uint32_t(len) << 8);
+            const uint32_t combined_hi = rotl32(swap32(combined_lo), 13);
+            const uint64_t bitflip_lo = load_le32(secret) ^ load_le32(secret + 4);
+            const uint64_t bitflip_hi = load_le32(secret + 8) ^ load_le32(secret + 12);
+            h.low = xxh64_avalanche(combined_lo ^ bitflip_lo);
+            h.high = xxh64_avalanche(combined_hi ^ bitflip_hi);
+            return h;
+        }
+        if (len <= 8) {
+            const uint64_t input64 = load_le32(input) + (uint64_t(load_le32(input + len - 4)) << 32);
+            const uint64_t keyed = input64 ^ (load_le64(secret + 16) ^ load_le64(secret + 24));
+            uint64_t lo, hi;
+            mult64to128(keyed, PRIME64_1 + (len << 2), lo, hi);
+            hi += lo << 1;
+            lo ^= hi >> 3;
+            lo ^= lo >> 35;
+            lo *= PRIME_MX2;
+            lo ^= lo >> 28;
+            h.low = lo;
+            h.high = avalanche(hi);
+            return h;
+        }
+        if (len <= 16) {
+            const uint64_t bitflip_lo = load_le64(secret + 32) ^ load_le64(secret + 40);
+            const uint64_t bitflip_hi = load_le64(secret + 48) ^ load_le64(secret + 56);
+            const uint64_t input_lo = load_le64(input);
+            uint64_t input_hi = load_le64(input + len - 8);
+            uint64_t lo, hi;
+            mult64to128(input_lo ^ input_hi ^ bitflip_lo, PRIME64_1, lo, hi);
+            lo += uint64_t(len - 1) << 54;
+            input_hi ^= bitflip_hi;
+            hi += input_hi + uint64_t(uint32_t(input_hi)) * (PRIME32_2 - 1);
+            lo ^= swap64(hi);
+            uint64_t out_lo, out_hi;
+            mult64to128(lo, PRIME64_2, out_lo, out_hi);
+            out_hi += hi * PRIME64_2;
+            h.low = avalanche(out_lo);
+            h.high = avalanche(out_hi);
+            return h;
+        }
+        uint64_t low = len * PRIME64_1, high = 0;
+        if (len <= 128) {
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96) mix32b(low, high, input + 48, input + len - 64, secret + 96);
+                    mix32b(low, high, input + 32, input + len - 48, secret + 64);
+                }
+                mix32b(low, high, input + 16, input + len - 32, secret + 32);
+            }
+            mix32b(low, high, input, input + len - 16, secret);
+            return finish_mid_128(low, high, len);
+        }
+        const size_t rounds = len / 32;
+        for (size_t i = 0; i < 4; ++i) mix32b(low, high, input + 32 * i, input + 32 * i + 16, secret + 32 * i);
+        low = avalanche(low);
+        high = avalanche(high);
+        for (size_t i = 4; i < rounds; ++i)
+            mix32b(low, high, input + 32 * i, input + 32 * i + 16, secret + MIDSIZE_STARTOFFSET + 32 * (i - 4));
+        mix32b(low, high, input + len - 16, input + len - 32, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET - 16);
+        return finish_mid_128(low, high, len);
+    }
+
+    // ---------- Длинные входы: накопление полос ----------
+
+    /**
+     * @brief Добавляет stripes полос по 64 байта; секрет сдвигается на 8 байт за полосу.
+     *
+     * Для каждого 64‑битного слова: acc[i ^ 1] += данные,
+     * acc[i] += lo32(данные ^ секрет) · hi32(данные ^ секрет).
+     */
+    void accumulate_portable(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes) {
+        for (size_t s = 0; s < stripes; ++s) {
+            for (size_t i = 0; i < 8; ++i) {
+                const uint64_t data = load_le64(input + STRIPE_LEN * s + 8 * i);
+                const uint64_t key = data ^ load_le64(secret + SECRET_CONSUME_RATE * s + 8 * i);
+                acc[i ^ 1] += data;
+                acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+            }
+        }
+    }
+
+    /// Перемешивание аккумуляторов в конце блока.
+    void scramble_portable(uint64_t acc[8], const uint8_t* secret) {
+        for (size_t i = 0; i < 8; ++i) {
+            uint64_t a = acc[i];
+            a ^= a >> 47;
+            a ^= load_le64(secret + 8 * i);
+            acc[i] = a * PRIME32_1;
+        }
+    }
+
+#ifdef HASH_X86_SIMD
+    // Умножение 32×32→64 — pmuludq по младшим половинам; старшие половины
+    // подставляются туда pshufd. Обмен соседних аккумуляторов (i ^ 1) —
+    // перестановка 64‑битных слов внутри 128‑битной дорожки.
+
+    __attribute__((target("sse2")))
+    void accumulate_sse2(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes) {
+        __m128i a[4];
+        for (int i = 0; i < 4; ++i) a[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+        for (size_t s = 0; s < stripes; ++s) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(input + STRIPE_LEN * s);
+            const __m128i* key = reinterpret_cast<const __m128i*>(secret + SECRET_CONSUME_RATE * s);
+            for (int i = 0; i < 4; ++i) {
+                const __m128i data = _mm_loadu_si128(in + i);
+                const __m128i data_key = _mm_xor_si128(data, _mm_loadu_si128(key + i));
+                const __m128i product = _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+            }
+        }
+        for (int i = 0; i < 4; ++i) _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, a[i]);
+    }
+
+    __attribute__((target("sse2")))
+    void scramble_sse2(uint64_t acc[8], const uint8_t* secret) {
+        const __m128i prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+        for (int i = 0; i < 4; ++i) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+            a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+            a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+            const __m128i lo = _mm_mul_epu32(a, prime);
+            const __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void accumulate_avx2(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes) {
+        __m256i a[2];
+        for (int i = 0; i < 2; ++i) a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+        for (size_t s = 0; s < stripes; ++s) {
+            const __m256i* in = reinterpret_cast<const __m256i*>(input + STRIPE_LEN * s);
+            const __m256i* key = reinterpret_cast<const __m256i*>(secret + SECRET_CONSUME_RATE * s);
+            for (int i = 0; i < 2; ++i) {
+                const __m256i data = _mm256_loadu_si256(in + i);
+                const __m256i data_key = _mm256_xor_si256(data, _mm256_loadu_si256(key + i));
+                const __m256i product = _mm256_mul_epu32(data_key,
+                                                         _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                a[i] = _mm256_add_epi64(a[i], _mm256_add_epi64(product, swapped));
+            }
+        }
+        for (int i = 0; i < 2; ++i) _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, a[i]);
+    }
+
+    __attribute__((target("avx2")))
+    void scramble_avx2(uint64_t acc[8], const uint8_t* secret) {
+        const __m256i prime = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+        for (int i = 0; i < 2; ++i) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+            a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+            a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+            const __m256i lo = _mm256_mul_epu32(a, prime);
+            const __m256i hi = _mm256_mul_epu32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+        }
+    }
+
+HASH_AVX512_WARNINGS_PUSH
+    /// На AVX‑512 вся полоса и все восемь аккумуляторов — один регистр.
+    __attribute__((target("avx512f")))
+    void accumulate_avx512(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes) {
+        __m512i a = _mm512_loadu_si512(acc);
+        for (size_t s = 0; s < stripes; ++s) {
+            const __m512i data = _mm512_loadu_si512(input + STRIPE_LEN * s);
+            const __m512i data_key = _mm512_xor_si512(data, _mm512_loadu_si512(secret + SECRET_CONSUME_RATE * s));
+            const __m512i product = _mm512_mul_epu32(
+                data_key, _mm512_shuffle_epi32(data_key, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(0, 3, 0, 1))));
+            const __m512i swapped = _mm512_shuffle_epi32(data, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(1, 0, 3, 2)));
+            a = _mm512_add_epi64(a, _mm512_add_epi64(product, swapped));
+        }
+        _mm512_storeu_si512(acc, a);
+    }
+
+    __attribute__((target("avx512f")))
+    void scramble_avx512(uint64_t acc[8], const uint8_t* secret) {
+        const __m512i prime = _mm512_set1_epi32(static_cast<int>(PRIME32_1));
+        __m512i a = _mm512_loadu_si512(acc);
+        a = _mm512_xor_si512(a, _mm512_srli_epi64(a, 47));
+        a = _mm512_xor_si512(a, _mm512_loadu_si512(secret));
+        const __m512i lo = _mm512_mul_epu32(a, prime);
+        const __m512i hi = _mm512_mul_epu32(_mm512_shuffle_epi32(a, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(0, 3, 0, 1))),
+                                            prime);
+        _mm512_storeu_si512(acc, _mm512_add_epi64(lo, _mm512_slli_epi64(hi, 32)));
+    }
+HASH_AVX512_WARNINGS_POP
+#endif
+
+    void accumulate(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx512f()) {
+            accumulate_avx512(acc, input, secret, stripes);
+            return;
+        }
+        if (cpu_has_avx2()) {
+            accumulate_avx2(acc, input, secret, stripes);
+            return;
+        }
+        if (cpu_has_sse2()) {
+            accumulate_sse2(acc, input, secret, stripes);
+            return;
+        }
+#endif
+        accumulate_portable(acc, input, secret, stripes);
+    }
+
+    void scramble(uint64_t acc[8], const uint8_t* secret) {
+#ifdef HASH_X86_SIMD
+        if (cpu_has_avx512f()) {
+            scramble_avx512(acc, secret);
+            return;
+        }
+        if (cpu_has_avx2()) {
+            scramble_avx2(acc, secret);
+            return;
+        }
+        if (cpu_has_sse2()) {
+            scramble_sse2(acc, secret);
+            return;
+        }
+#endif
+        scramble_portable(acc, secret);
+    }
+
+    /**
+     * @brief Добавляет полосы, перемешивая аккумуляторы на каждой границе блока.
+     *
+     * Вызывающий гарантирует, что после этих полос есть ещё данные, поэтому
+     * перемешивание на границе последнего блока совпадает с однопроходным XXH3.
+     */
+    void consume_stripes(uint64_t acc[8], size_t& done, const uint8_t* input, size_t stripes) {
+        while (stripes > 0) {
+            const size_t take = std::min(stripes, STRIPES_PER_BLOCK - done);
+            accumulate(acc, input, SECRET + SECRET_CONSUME_RATE * done, take);
+            input += STRIPE_LEN * take;
+            stripes -= take;
+            done += take;
+            if (done == STRIPES_PER_BLOCK) {
+                scramble(acc, SECRET + sizeof(SECRET) - STRIPE_LEN);
+                done = 0;
+            }
+        }
+    }
+
+    inline uint64_t merge_accs(const uint64_t acc[8], const uint8_t* secret, uint64_t start) {
+        uint64_t result = start;
+        for (size_t i = 0; i < 4; ++i)
+            result += mul128_fold64(acc[2 * i] ^ load_le64(secret + 16 * i), acc[2 * i + 1] ^ load_le64(secret + 16 * i + 8));
+        return avalanche(result);
+    }
+
+    /**
+     * @brief Аккумуляторы длинного входа (> 240 байт) после последней полосы.
+     *
+     * Последняя полоса — всегда последние 64 байта входа; если в буфере
+     * их меньше, недостающее начало берётся из хвоста буфера, куда
+     * xxh3_update() сохраняет предыдущую полосу.
+     */
+    void long_accumulators(const Xxh3State& state, uint64_t acc[8]) {
+        std::copy(state.acc.begin(), state.acc.end(), acc);
+        size_t done = state.stripes;
+        uint8_t last[STRIPE_LEN];
+        if (state.buffered >= STRIPE_LEN) {
+            consume_stripes(acc, done, state.buffer.data(), (state.buffered - 1) / STRIPE_LEN);
+            std::memcpy(last, state.buffer.data() + state.buffered - STRIPE_LEN, STRIPE_LEN);
+        } else {
+            const size_t catchup = STRIPE_LEN - state.buffered;
+            std::memcpy(last, state.buffer.data() + state.buffer.size() - catchup, catchup);
+            std::memcpy(last + catchup, state.buffer.data(), state.buffered);
+        }
+        accumulate(acc, last, SECRET + sizeof(SECRET) - STRIPE_LEN - SECRET_LASTACC_START, 1);
+    }
+}
+
+void xxh3_init(Xxh3State& state) {
+    std::copy(INIT_ACC, INIT_ACC + 8, state.acc.begin());
+    state.buffer.fill(0);
+    state.buffered = 0;
+    state.stripes = 0;
+    state.total = 0;
+}
+
+void xxh3_update(Xxh3State& state, const uint8_t* data, size_t size) {
+    const size_t B = state.buffer.size();
+    state.total += size;
+    if (state.buffered + size <= B) {
+        std::memcpy(state.buffer.data() + state.buffered, data, size);
+        state.buffered += size;
+        return;
+    }
+    if (state.buffered) {
+        const size_t fill = B - state.buffered;
+        std::memcpy(state.buffer.data() + state.buffered, data, fill);
+        data += fill;
+        size -= fill;
+        consume_stripes(state.acc.data(), state.stripes, state.buffer.data(), B / STRIPE_LEN);
+        state.buffered = 0;
+    }
+    if (size > B) {
+        // Все полосы, кроме содержащей последний байт, — прямо из входа.
+        const size_t stripes = (size - 1) / STRIPE_LEN;
+        consume_stripes(state.acc.data(), state.stripes, data, stripes);
+        data += stripes * STRIPE_LEN;
+        size -= stripes * STRIPE_LEN;
+        std::memcpy(state.buffer.data() + B - STRIPE_LEN, data - STRIPE_LEN, STRIPE_LEN);
+    }
+    std::memcpy(state.buffer.data(), data, size);
+    state.buffered = size;
+}
+
+uint64_t xxh3_64_digest(const Xxh3State& state) {
+    if (state.total <= MIDSIZE_MAX) return short_64(state.buffer.data(), static_cast<size_t>(state.total));
+    uint64_t acc[8];
+    long_accumulators(state, acc);
+    return merge_accs(acc, SECRET + SECRET_MERGEACCS_START, state.total * PRIME64_1);
+}
+
+Xxh128Hash xxh3_128_digest(const Xxh3State& state) {
+    if (state.total <= MIDSIZE_MAX) return short_128(state.buffer.data(), static_cast<size_t>(state.total));
+    uint64_t acc[8];
+    long_accumulators(state, acc);
+    Xxh128Hash h;
+    h.low = merge_accs(acc, SECRET + SECRET_MERGEACCS_START, state.total * PRIME64_1);
+    h.high = merge_accs(acc, SECRET + sizeof(SECRET) - STRIPE_LEN - SECRET_MERGEACCS_START, ~(state.total * PRIME64_2));
+    return h;
+}
+
+uint64_t xxh3_64(const uint8_t* data, size_t size) {
+    Xxh3State state;
+    xxh3_init(state);
+    xxh3_update(state, data, size);
+    return xxh3_64_digest(state);
+}
+
+Xxh128Hash xxh3_128(const uint8_t* data, size_t size) {
+    Xxh3State state;
+    xxh3_init(state);
+    xxh3_update(state, data, size);
+    return xxh3_128_digest(state);
+}
+
+std::string xxh3_file(const std::string& filepath) {
+    Xxh3State state;
+    xxh3_init(state);
+    if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { xxh3_update(state, data, size); }))
+        return "";
+    uint8_t out[8];
+    store_be64(out, xxh3_64_digest(state));
+    return to_hex(out, sizeof(out));
+}
+
+std::string xxh128_file(const std::string& filepath) {
+    Xxh3State state;
+    xxh3_init(state);
+    if (!read_file_chunks(filepath, [&](const uint8_t* data, size_t size) { xxh3_update(state, data, size); }))
+        return "";
+    const Xxh128Hash h = xxh3_128_digest(state);
+    uint8_t out[16];
+    store_be64(out, h.high);
+    store_be64(out + 8, h.low);
+    return to_hex(out, sizeof(out));
+}
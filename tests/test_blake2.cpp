@@ -0,0 +1,113 @@
+#include "../include/doctest.h"
+#include "../include/blake2.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/verifier.h"
+#include "../include/cpu_features.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    std::string key_bytes(size_t size) {
+        std::string key(size, '\0');
+        for (size_t i = 0; i < size; ++i) key[i] = static_cast<char>(i);
+        return key;
+    }
+
+    std::string b2b(const std::string& data, const std::string& key = "", size_t out_len = 64) {
+        Blake2bContext ctx;
+        REQUIRE(blake2b_init(ctx, out_len, reinterpret_cast<const uint8_t*>(key.data()), key.size()));
+        blake2b_update(ctx, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        uint8_t out[64];
+        blake2b_final(ctx, out);
+        return to_hex(out, out_len);
+    }
+
+    std::string b2s(const std::string& data, const std::string& key = "", size_t out_len = 32) {
+        Blake2sContext ctx;
+        REQUIRE(blake2s_init(ctx, out_len, reinterpret_cast<const uint8_t*>(key.data()), key.size()));
+        blake2s_update(ctx, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        uint8_t out[32];
+        blake2s_final(ctx, out);
+        return to_hex(out, out_len);
+    }
+}
+
+TEST_SUITE("BLAKE2 Tests") {
+    TEST_CASE("Known answers around block boundaries") {
+        // Эталоны — hashlib.blake2b / hashlib.blake2s.
+        struct Vector { size_t size; const char* b; const char* s; };
+        const Vector vectors[] = {
+            { 0, "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419d25e1031afee585313896444934eb04b903a685b1448b755d56f701afe9be2ce",
+              "69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9" },
+            { 127, "a328043e9429817e8bc86a06e010c501bb0efb4989986216dc4d6fec8284637f7a4175c8b77510ebd7f5132d33222c2ffc4bc5371d9044546e17ba11bd89aad4",
+              "18232436256b61eb50685d7e2dcd343eca7569f1661ac92398dd9faaf24e62fc" },
+            { 128, "e1a5c90c7ec03f5dedaefc53bd8ff60e393d13d0a83dafcadc8f387a5578cd9a5d68e233a500c08a2516c863313754da1adacfd7bdde32b87dacf630c2c09e92",
+              "aa8720b8c48c5d79a196db33eafa9b37147e8e626ffaa8842463651706f8ffc4" },
+            { 129, "8e5ee4845c094fcd0ab471474a2c6931052913632a83035c79fd255b11a7e01a5d4b0d384e9de22351af219109605293d89b5b7a95f918cfe58823f04a73f04c",
+              "aaf3dd1fe7ef067bdb8a1cb015b43790cb18600dceca7678ea1b62560443d69a" },
+            { 256, "3ef11e8f6a5244fb0f825c432b123025521e2d9926d3dc66d7f7c0c05ac4fef9ce5f7ae1df6efc34e74f6ca698ed1f1a142ae62c754d99591842e3d1b861149f",
+              "1a088a8083a7c0454967abf77ae09fd24852383a787344e255d2a77295e0607c" },
+            { 1000, "30bc1b2bfe6fb16ba15fae7218aacf452473c496fa9de8652bf59bd4c4e9b473803a523439c48148f00340f2f10ed4852bfabf9f54d65d141bdabcebd67b08a9",
+              "a70229beeb97a968513da353ed5531f2a949cca135c1f0fbd8ea6ae981463a4b" },
+        };
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            CHECK(b2b("abc") == "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+            CHECK(b2s("abc") == "508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982");
+            for (const Vector& v : vectors) {
+                const std::string data = pattern(v.size);
+                CHECK(b2b(data) == v.b);
+                CHECK(b2s(data) == v.s);
+
+                // Побайтовая подача: последний блок не должен сжаться раньше времени.
+                for (const char* algo : { "blake2b", "blake2s" }) {
+                    std::unique_ptr<Hasher> hasher = make_hasher(algo);
+                    for (char c : data) hasher->update(reinterpret_cast<const uint8_t*>(&c), 1);
+                    std::string digest = hasher->digest();
+                    CHECK(to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size())
+                          == (algo[6] == 'b' ? v.b : v.s));
+                }
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+    }
+
+    TEST_CASE("Keyed mode and digest length") {
+        CHECK(b2b("", key_bytes(64)) == "10ebb67700b1868efb4417987acf4690ae9d972fb7a590c2f02871799aaa4786b5e996e8f0f4eb981fc214b005f42d2ff4233499391653df7aefcbc13fc51568");
+        CHECK(b2b(pattern(200), "secret") == "48fcd8cc32c0326a66aa0edc8df92abbe13107fe16a574f5c4b99d81e036111d9623d580c177d1717c30096bdb0c0c0a04d99872b05792e78b10dcbaebfb3a9a");
+        CHECK(b2s("", key_bytes(32)) == "48a8997da407876b3d79c0d92325ad3b89cbb754d86ab71aee047ad345fd2c49");
+        CHECK(b2s(pattern(200), "secret") == "762cd207ae373df1398374ff3d80026c11fb41d06443f75993a68168b989339f");
+        CHECK(b2b(pattern(200), "", 32) == "c38831a812570d45f7d516bb336fe4fffcfb5ea598f86ad76a4de1615d4b769c");
+        CHECK(b2s(pattern(200), "", 16) == "235b27088bf0e431551a2a0ae501ed75");
+
+        Blake2bContext b;
+        Blake2sContext s;
+        CHECK_FALSE(blake2b_init(b, 0));
+        CHECK_FALSE(blake2b_init(b, 65));
+        CHECK_FALSE(blake2s_init(s, 33));
+        const std::string long_key = key_bytes(33);
+        CHECK_FALSE(blake2s_init(s, 32, reinterpret_cast<const uint8_t*>(long_key.data()), long_key.size()));
+    }
+
+    TEST_CASE("File hashing") {
+        const std::string test_file = "blake2_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            std::string data = pattern(3 * 1024 * 1024 + 12345);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        const std::string expected_b = "dfb5b608075f749b0ba5342a8233c62a8e8b95cd44486ee6874a7ec047f0e17eac99f7b59bd11edc770d4f162ba8b575f3ad84a6b1bc03175328bd7ac314e33a";
+        const std::string expected_s = "791360cb3e993c0f149a2b276aae44b5069a1c1ed42bc97f48198051cba97c82";
+        CHECK(blake2b_file(test_file) == expected_b);
+        CHECK(blake2s_file(test_file) == expected_s);
+        CHECK(hash_file("blake2b", test_file) == expected_b);
+        CHECK(verify_blake2b(test_file, expected_b));
+        CHECK(verify_blake2s(test_file, expected_s));
+        CHECK_FALSE(verify_blake2s(test_file, expected_s, "secret"));
+        CHECK(blake2b_file(test_file, "", 0).empty());
+        std::filesystem::remove(test_file);
+        CHECK(blake2b_file("non_existent_file.txt").empty());
+    }
+}
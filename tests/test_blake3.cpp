@@ -0,0 +1,75 @@
+#include "../include/doctest.h"
+#include "../include/blake3.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/verifier.h"
+#include "../include/cpu_features.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    std::string blake3_hex(const std::string& data, size_t out_size = 32) {
+        Blake3Context ctx;
+        blake3_init(ctx);
+        blake3_update(ctx, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        std::vector<uint8_t> out(out_size);
+        blake3_final(ctx, out.data(), out_size);
+        return to_hex(out.data(), out.size());
+    }
+}
+
+TEST_SUITE("BLAKE3 Tests") {
+    TEST_CASE("Known answers at chunk boundaries") {
+        // Эталоны — пакет blake3 для Python.
+        const std::pair<size_t, const char*> vectors[] = {
+            { 0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262" },
+            { 1, "448bd8dd9624154a690f8e84dc52d6f633ba7cd545c4d3c9b4e0f6a2f6fa71f4" },
+            { 64, "468e04355a965d211227cb377a24e31815162503014e81d2a014c098c3b43629" },
+            { 1023, "c015bd346d1aa26e7d6635188899c99d73d1793fe4074c24ae1c793595e050ac" },
+            { 1024, "628779c7aa7f0c7c2f16fc4aa893bb91b6ca30baea6ebe2cb4070aba928b7090" },
+            { 1025, "22fe99634072d625f2e36f73ee2c5a3cd0cab0bf98f7cefc64d86a4250a5ec01" },
+            { 2048, "8766e3838d4dbd6de7eadb953b365438570510fb8daeccb72852bcad4834d8e2" },
+            // 31 целый кусок уходит в ядра 16 + 8 + 4 + 3 одиночных.
+            { 31 * 1024 + 5, "a9e0fef511472e58a77a8d4f1930c2269f7d63348b4b3364333c9cb332c490d1" },
+        };
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            for (const auto& v : vectors) {
+                const std::string data = pattern(v.first);
+                CHECK(blake3_hex(data) == v.second);
+
+                // Побайтовая подача проходит через неполные блоки и куски.
+                std::unique_ptr<Hasher> hasher = make_hasher("blake3");
+                for (char c : data) hasher->update(reinterpret_cast<const uint8_t*>(&c), 1);
+                std::string digest = hasher->digest();
+                CHECK(to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size()) == v.second);
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+    }
+
+    TEST_CASE("Extended output") {
+        CHECK(blake3_hex("abc") == "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+        CHECK(blake3_hex("abc", 100) == "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85"
+                                        "1fb250ae7393f5d02813b65d521a0d492d9ba09cf7ce7f4cffd900f23374bf0b"
+                                        "c08a1fb0b38ed276181ccbd9f7b7edbddf9f86404ad7929605f6ffa3fb1ac879"
+                                        "83105f01");
+    }
+
+    TEST_CASE("Multithreaded file hashing") {
+        const std::string test_file = "blake3_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            std::string data = pattern(3 * 1024 * 1024 + 12345);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        const std::string expected = "3297f0da00cdf1a6f927eea27ca3ba55c0fc8b2e95d709ec6df40e46db765a2f";
+        CHECK(blake3_file(test_file, 1) == expected);
+        CHECK(blake3_file(test_file, 4) == expected);
+        CHECK(hash_file("blake3", test_file) == expected);
+        CHECK(verify_blake3(test_file, expected));
+        std::filesystem::remove(test_file);
+        CHECK(blake3_file("non_existent_file.txt").empty());
+    }
+}
@@ -0,0 +1,73 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/buffer_pool.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+TEST_SUITE("Buffer Pool Tests") {
+    TEST_CASE("Buffers are recycled") {
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        uint8_t* first;
+        {
+            buffer_pool::Buffer buffer = buffer_pool::acquire();
+            first = buffer.data();
+            CHECK(buffer.size() == buffer_pool::DEFAULT_BUFFER_SIZE);
+        }
+        size_t allocated = buffer_pool::allocated_buffers();
+        buffer_pool::Buffer again = buffer_pool::acquire();
+        CHECK(again.data() == first);
+        CHECK(buffer_pool::allocated_buffers() == allocated);
+    }
+
+    TEST_CASE("Acquire blocks when the limit is exhausted") {
+        buffer_pool::set_memory_limit(2 * buffer_pool::MIN_BUFFER_SIZE);
+        CHECK(buffer_pool::buffer_size() == buffer_pool::MIN_BUFFER_SIZE);
+
+        buffer_pool::Buffer a = buffer_pool::acquire();
+        buffer_pool::Buffer b = buffer_pool::acquire();
+        std::atomic<bool> got(false);
+        std::thread waiter([&] {
+            buffer_pool::Buffer c = buffer_pool::acquire();
+            got = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK(got == false);
+        a = buffer_pool::Buffer();
+        waiter.join();
+        CHECK(got == true);
+        CHECK(buffer_pool::allocated_buffers() <= 2);
+
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+    }
+
+    TEST_CASE("Limits below one buffer are rejected") {
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        CHECK_FALSE(buffer_pool::set_memory_limit(0));
+        CHECK_FALSE(buffer_pool::set_memory_limit(buffer_pool::MIN_BUFFER_SIZE - 1));
+        CHECK(buffer_pool::memory_limit() == buffer_pool::DEFAULT_MEMORY_LIMIT);
+        CHECK(buffer_pool::buffer_size() == buffer_pool::DEFAULT_BUFFER_SIZE);
+
+        // Меньше четырёх минимальных буферов: буфер не больше лимита.
+        REQUIRE(buffer_pool::set_memory_limit(100000));
+        CHECK(buffer_pool::buffer_size() == buffer_pool::MIN_BUFFER_SIZE);
+        CHECK(buffer_pool::buffer_size() <= buffer_pool::memory_limit());
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+    }
+
+    TEST_CASE("Streaming hashes across buffer boundaries") {
+        // Эталонные значения для миллиона символов 'a' (FIPS 180, RFC 1321 test suite).
+        const std::string test_file = "million_a.txt";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << std::string(1000000, 'a');
+        }
+        buffer_pool::set_memory_limit(buffer_pool::MIN_BUFFER_SIZE);
+        CHECK(md5_file(test_file) == "7707d6ae4e027c70eea2a935c2296f21");
+        CHECK(sha1_file(test_file) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+        CHECK(sha256_file(test_file) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        std::filesystem::remove(test_file);
+    }
+}
@@ -0,0 +1,52 @@
+#include "../include/doctest.h"
+#include "../include/cas.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    void write_text(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+}
+
+TEST_SUITE("CAS Verify Tests") {
+    TEST_CASE("OCI layout with good, corrupt and misnamed blobs") {
+        const std::string dir = "cas_test_dir";
+        const std::string sha256 = dir + "/blobs/sha256/";
+        std::filesystem::create_directories(sha256);
+        std::filesystem::create_directories(dir + "/blobs/md5/5d");
+        std::filesystem::create_directories(dir + "/blobs/unknown");
+        write_text(dir + "/oci-layout", "{\"imageLayoutVersion\": \"1.0.0\"}");
+        write_text(dir + "/blobs/unknown/file", "ignored");
+
+        // SHA‑256 и MD5 строки "hello".
+        write_text(sha256 + "2cf24dba5fb0a30e26e83b2ac5b9e29e1b161e5c1fa7425e73043362938b9824", "hello");
+        write_text(dir + "/blobs/md5/5d/5d41402abc4b2a76b9719d911017c592", "hello");
+        write_text(sha256 + "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "");
+        write_text(sha256 + "0000000000000000000000000000000000000000000000000000000000000000", "hello");
+        write_text(sha256 + "2CF24DBA5FB0A30E26E83B2AC5B9E29E1B161E5C1FA7425E73043362938B9824", "hello");
+        write_text(sha256 + "not-a-digest", "hello");
+
+        for (unsigned threads : { 0u, 1u }) {
+            CasReport report;
+            REQUIRE(cas_verify(dir, report, threads));
+            CHECK(report.verified == 3);
+            CHECK(report.bytes == 20);
+            REQUIRE(report.corrupt.size() == 1);
+            CHECK(report.corrupt[0].find("00000000") != std::string::npos);
+            REQUIRE(report.misnamed.size() == 2);
+            CHECK(report.misnamed[0].find("2CF24DBA") != std::string::npos);
+            CHECK(report.misnamed[1].find("not-a-digest") != std::string::npos);
+            CHECK(report.unreadable.empty());
+        }
+
+        // Без каталога blobs корнем считается сам каталог.
+        CasReport report;
+        REQUIRE(cas_verify(dir + "/blobs", report));
+        CHECK(report.verified == 3);
+
+        std::filesystem::remove_all(dir);
+        CHECK_FALSE(cas_verify(dir, report));
+    }
+}
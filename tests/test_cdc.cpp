@@ -0,0 +1,92 @@
+#include "../include/doctest.h"
+#include "../include/cdc.h"
+#include "../include/hasher.h"
+#include "../include/buffer_pool.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+TEST_SUITE("FastCDC Tests") {
+    TEST_CASE("Chunks cover the file within size bounds") {
+        const std::string test_file = "cdc_test.bin";
+        write_bytes(test_file, random_bytes(3 * 1024 * 1024 + 777, 1));
+        CdcParams params{ 2048, 8192, 65536 };
+
+        std::vector<CdcChunk> chunks;
+        REQUIRE(cdc_chunk_file(test_file, params, chunks));
+        REQUIRE(chunks.size() > 1);
+        uint64_t offset = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            CHECK(chunks[i].offset == offset);
+            CHECK(chunks[i].length <= params.max_size);
+            if (i + 1 < chunks.size()) CHECK(chunks[i].length > params.min_size);
+            offset += chunks[i].length;
+        }
+        CHECK(offset == 3 * 1024 * 1024 + 777);
+        double mean = static_cast<double>(offset) / static_cast<double>(chunks.size());
+        CHECK(mean > params.avg_size / 2.0);
+        CHECK(mean < params.avg_size * 2.0);
+
+        for (size_t i : { size_t(0), chunks.size() / 2, chunks.size() - 1 })
+            CHECK(chunks[i].hash == hash_file_range("sha256", test_file, chunks[i].offset, chunks[i].length));
+
+        // Результат не зависит от числа потоков и размера буферов.
+        std::vector<CdcChunk> single;
+        REQUIRE(cdc_chunk_file(test_file, params, single, 1));
+        const size_t old_limit = buffer_pool::memory_limit();
+        buffer_pool::set_memory_limit(256 << 10);
+        std::vector<CdcChunk> small;
+        REQUIRE(cdc_chunk_file(test_file, params, small, 3));
+        buffer_pool::set_memory_limit(old_limit);
+        REQUIRE(single.size() == chunks.size());
+        REQUIRE(small.size() == chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            CHECK(single[i].hash == chunks[i].hash);
+            CHECK(small[i].hash == chunks[i].hash);
+            CHECK(small[i].length == chunks[i].length);
+        }
+        std::filesystem::remove(test_file);
+
+        CHECK_FALSE(cdc_chunk_file("non_existent_file.txt", params, chunks));
+        CHECK_FALSE(cdc_params_valid({ 8192, 4096, 65536 }));
+        CHECK_FALSE(cdc_params_valid({ 16, 4096, 65536 }));
+    }
+
+    TEST_CASE("Boundaries survive insertion and duplicates are counted once") {
+        const std::string dir = "cdc_test_dir";
+        std::filesystem::create_directories(dir);
+        const std::string data = random_bytes(2 * 1024 * 1024, 7);
+        write_bytes(dir + "/a.bin", data);
+        write_bytes(dir + "/b.bin", data);
+        write_bytes(dir + "/shifted.bin", random_bytes(100, 9) + data);
+        write_bytes(dir + "/empty.bin", "");
+        CdcParams params{ 2048, 8192, 65536 };
+
+        std::vector<CdcChunk> original, shifted;
+        REQUIRE(cdc_chunk_file(dir + "/a.bin", params, original));
+        REQUIRE(cdc_chunk_file(dir + "/shifted.bin", params, shifted));
+        std::unordered_set<std::string> seen;
+        DedupStats stats;
+        add_dedup_stats(original, seen, stats);
+        add_dedup_stats(shifted, seen, stats);
+        // После вставки в начало меняются только первые куски.
+        CHECK(stats.unique_chunks <= original.size() + 2);
+
+        const std::string list = "cdc_test_list.txt";
+        REQUIRE(cdc_chunk_tree(dir, params, list, stats));
+        CHECK(stats.files == 4);
+        CHECK(stats.total_bytes == 3 * data.size() + 100);
+        CHECK(stats.unique_bytes < data.size() + params.max_size * 2);
+        CHECK(stats.ratio() > 2.9);
+
+        std::ifstream in(list);
+        std::string header;
+        std::getline(in, header);
+        CHECK(header == "# fastcdc min=2048 avg=8192 max=65536");
+        in.close();
+
+        std::filesystem::remove(list);
+        std::filesystem::remove_all(dir);
+        CHECK_FALSE(cdc_chunk_tree(dir, params, "", stats));
+    }
+}
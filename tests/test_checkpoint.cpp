@@ -0,0 +1,140 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/checkpoint.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char* const ALGORITHMS[] = { "md5", "sha1", "sha256", "sha384", "sha512", "sha512_256", "blake2b",
+                                       "blake2s", "blake3", "sha3_224", "sha3_256", "sha3_384", "sha3_512",
+                                       "shake128", "shake256", "k12", "xxh3", "xxh128", "crc32", "crc32c" };
+}
+
+TEST_SUITE("Checkpoint Tests") {
+    TEST_CASE("Hash state round-trips through a blob") {
+        const std::string text = "The quick brown fox jumps over the lazy dog, twice over the lazy dog";
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+        for (const char* algo : {"md5", "sha1", "sha256"}) {
+            std::unique_ptr<Hasher> whole = make_hasher(algo);
+            whole->update(data, text.size());
+
+            std::unique_ptr<Hasher> first = make_hasher(algo);
+            first->update(data, 37);
+            std::string blob = first->save_state();
+            REQUIRE(!blob.empty());
+
+            std::unique_ptr<Hasher> second = make_hasher(algo);
+            REQUIRE(second->load_state(blob));
+            second->update(data + 37, text.size() - 37);
+            CHECK(second->digest() == whole->digest());
+        }
+    }
+
+    TEST_CASE("Every algorithm saves and restores its state") {
+        // Точки разреза — внутри блока, на границах блоков, кусков BLAKE3/K12 и полос XXH3.
+        const std::string data = random_bytes(40000, 5);
+        for (const char* algo : ALGORITHMS) {
+            std::unique_ptr<Hasher> whole = make_hasher(algo);
+            whole->update(bytes(data), data.size());
+            const std::string expected = whole->digest();
+
+            for (size_t cut : { size_t(0), size_t(1), size_t(64), size_t(200), size_t(1024), size_t(8192),
+                                size_t(8193), size_t(33000) }) {
+                std::unique_ptr<Hasher> first = make_hasher(algo);
+                first->update(bytes(data), cut);
+                const std::string blob = first->save_state();
+                REQUIRE_MESSAGE(!blob.empty(), algo);
+
+                std::unique_ptr<Hasher> second = make_hasher(algo);
+                REQUIRE_MESSAGE(second->load_state(blob), algo);
+                second->update(bytes(data) + cut, data.size() - cut);
+                CHECK_MESSAGE(second->digest() == expected, algo << " cut " << cut);
+                CHECK_FALSE(make_hasher(algo)->load_state(blob.substr(0, blob.size() - 1)));
+            }
+        }
+    }
+
+    TEST_CASE("Reset returns a hasher to its initial state") {
+        const std::string text = "The quick brown fox jumps over the lazy dog";
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+        for (const char* algo : ALGORITHMS) {
+            std::unique_ptr<Hasher> fresh = make_hasher(algo);
+            REQUIRE(fresh);
+            fresh->update(data, text.size());
+
+            std::unique_ptr<Hasher> reused = make_hasher(algo);
+            reused->update(data, 10);
+            reused->digest();
+            reused->reset();
+            reused->update(data, text.size());
+            CHECK_MESSAGE(reused->digest() == fresh->digest(), algo);
+        }
+    }
+
+    TEST_CASE("Foreign or damaged blobs are rejected") {
+        std::unique_ptr<Hasher> md5 = make_hasher("md5");
+        std::string blob = md5->save_state();
+        CHECK(make_hasher("sha1")->load_state(blob) == false);
+        CHECK(make_hasher("md5")->load_state(blob.substr(0, blob.size() - 1)) == false);
+        blob[2] = 99;
+        CHECK(make_hasher("md5")->load_state(blob) == false);
+    }
+
+    TEST_CASE("Checkpointed hash matches and cleans up") {
+        const std::string test_file = "checkpoint_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << std::string(3 << 20, 'c');
+        }
+        CheckpointResult result = hash_file_checkpointed("sha256", test_file, 1 << 20);
+        CHECK(result.hash == sha256_file(test_file));
+        CHECK(result.checkpoints == 2);
+        CHECK(!std::filesystem::exists(checkpoint_path(test_file, "sha256")));
+        for (const char* algo : { "blake3", "crc32", "sha3_256", "xxh3", "k12" }) {
+            result = hash_file_checkpointed(algo, test_file, 1 << 20);
+            CHECK(result.hash == hash_file(algo, test_file));
+            CHECK_MESSAGE(result.checkpoints == 2, algo);
+        }
+        std::filesystem::remove(test_file);
+    }
+
+#ifndef _WIN32
+    TEST_CASE("An interrupted run resumes from its checkpoint") {
+        const std::string test_file = "checkpoint_resume.bin";
+        const std::string checkpoint = checkpoint_path(test_file, "sha256");
+        std::filesystem::remove(checkpoint);
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            for (int i = 0; i < 64; ++i) file << std::string(1 << 20, static_cast<char>(i));
+        }
+
+        // Дочерний процесс убивается, как только записал первую контрольную точку.
+        pid_t child = fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            hash_file_checkpointed("sha256", test_file, 1 << 20);
+            _exit(0);
+        }
+        while (!std::filesystem::exists(checkpoint) && waitpid(child, nullptr, WNOHANG) == 0)
+            usleep(100);
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+        REQUIRE(std::filesystem::exists(checkpoint));
+
+        CheckpointResult result = hash_file_checkpointed("sha256", test_file, 1 << 20);
+        CHECK(result.resumed_from > 0);
+        CHECK(result.resumed_from < (64ull << 20));
+        CHECK(result.hash == sha256_file(test_file));
+        CHECK(!std::filesystem::exists(checkpoint));
+        std::filesystem::remove(test_file);
+    }
+#endif
+}
@@ -0,0 +1,81 @@
+#include "../include/doctest.h"
+#include "../include/crc32.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/cpu_features.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+TEST_SUITE("CRC32 Tests") {
+    TEST_CASE("Check values and lengths around kernel boundaries") {
+        CHECK(crc32_ieee(0, bytes("123456789"), 9) == 0xCBF43926U);
+        CHECK(crc32c(0, bytes("123456789"), 9) == 0xE3069283U);
+
+        // Эталоны — zlib.crc32 и побитовый CRC32C на Python. Длины задевают
+        // 64‑байтную свёртку PCLMUL и тройные блоки 3·256 и 3·8192 для SSE4.2.
+        struct Vector { size_t size; uint32_t ieee; uint32_t castagnoli; };
+        const Vector vectors[] = {
+            { 0, 0x00000000, 0x00000000 },     { 1, 0x4c667a2e, 0x86b737ba },
+            { 7, 0xd0806f18, 0xb45337b6 },     { 8, 0xa963444c, 0xf495041b },
+            { 15, 0x6bd78dc1, 0x46c1cd44 },    { 16, 0x15be90b4, 0x0d2d42ce },
+            { 63, 0x7a442264, 0x956b29e5 },    { 64, 0x431cc738, 0xcf762298 },
+            { 65, 0x12fb9fe7, 0xdf72f8fc },    { 100, 0x85813b4b, 0xdb28fe7a },
+            { 767, 0x17d0af93, 0xbb8d3ab0 },   { 768, 0xfbccf6ba, 0x68012c80 },
+            { 769, 0x6729ec4a, 0x04290dee },   { 1000, 0x7a3ab675, 0x0da3ddc8 },
+            { 24575, 0xf2b7e9ed, 0xbfb51c42 }, { 24576, 0x4c94cdc7, 0x7a500b24 },
+            { 24577, 0x492ab9f0, 0x61ea7e70 }, { 30000, 0xae065942, 0x5821725a },
+        };
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            for (const Vector& v : vectors) {
+                const std::string data = pattern(v.size);
+                CHECK(crc32_ieee(0, bytes(data), data.size()) == v.ieee);
+                CHECK(crc32c(0, bytes(data), data.size()) == v.castagnoli);
+
+                // Продолжение с итога предыдущей части.
+                const size_t half = v.size / 3;
+                CHECK(crc32_ieee(crc32_ieee(0, bytes(data), half), bytes(data) + half, v.size - half) == v.ieee);
+                CHECK(crc32c(crc32c(0, bytes(data), half), bytes(data) + half, v.size - half) == v.castagnoli);
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+    }
+
+    TEST_CASE("Combine merges independently computed parts") {
+        const std::string data = pattern(30000);
+        for (size_t split : { size_t(0), size_t(1), size_t(4096), size_t(29999), size_t(30000) }) {
+            const size_t rest = data.size() - split;
+            const uint32_t a = crc32c(0, bytes(data), split);
+            const uint32_t b = crc32c(0, bytes(data) + split, rest);
+            CHECK(crc32c_combine(a, b, rest) == 0x5821725aU);
+            const uint32_t c = crc32_ieee(0, bytes(data), split);
+            const uint32_t d = crc32_ieee(0, bytes(data) + split, rest);
+            CHECK(crc32_ieee_combine(c, d, rest) == 0xae065942U);
+        }
+    }
+
+    TEST_CASE("File checksums and hasher registry") {
+        const std::string test_file = "crc32_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            std::string data = pattern(3 * 1024 * 1024 + 12345);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        for (unsigned threads : { 1u, 4u }) {
+            CHECK(crc32_file(test_file, threads) == "cb847269");
+            CHECK(crc32c_file(test_file, threads) == "1a972415");
+        }
+        CHECK(hash_file("crc32", test_file) == "cb847269");
+        CHECK(hash_file("crc32c", test_file) == "1a972415");
+        std::filesystem::remove(test_file);
+
+        { std::ofstream empty(test_file, std::ios::binary); }
+        CHECK(crc32c_file(test_file) == "00000000");
+        std::filesystem::remove(test_file);
+        CHECK(crc32_file("non_existent_file.txt").empty());
+
+        CHECK_FALSE(make_hasher("crc32")->cryptographic());
+        CHECK_FALSE(make_hasher("crc32c")->cryptographic());
+    }
+}
@@ -0,0 +1,29 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/etag.h"
+#include <filesystem>
+
+TEST_SUITE("S3 ETag Tests") {
+    TEST_CASE("Multipart ETag and part size detection") {
+        const std::string test_file = "etag_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            for (int i = 0; i < 12 * 1024 * 1024 + 5; ++i) file.put(static_cast<char>(i * 17 % 256));
+        }
+
+        // Эталоны посчитаны независимо: md5(md5(part1) || md5(part2) || ...) + "-N".
+        CHECK(s3_etag(test_file, 5 << 20) == "8cfadb99f37578ff1aad5c52dddb6f75-3");
+        CHECK(s3_etag(test_file, 8 << 20, 2) == "021954657d2f91c178e6bce84a1b9a00-2");
+        CHECK(s3_etag(test_file, 16 << 20) == md5_file(test_file));
+
+        uint64_t part = 0;
+        CHECK(verify_s3_etag(test_file, "\"8cfadb99f37578ff1aad5c52dddb6f75-3\"", &part));
+        CHECK(part == (5u << 20));
+        CHECK(verify_s3_etag(test_file, "021954657D2F91C178E6BCE84A1B9A00-2", &part));
+        CHECK(part == (8u << 20));
+        CHECK(verify_s3_etag(test_file, md5_file(test_file)));
+        CHECK(verify_s3_etag(test_file, "021954657d2f91c178e6bce84a1b9a00-3") == false);
+
+        std::filesystem::remove(test_file);
+    }
+}
@@ -0,0 +1,75 @@
+#include "../include/doctest.h"
+#include "../include/fuzzy.h"
+#include "../include/hash.h"
+#include "../include/buffer_pool.h"
+#include "test_util.h"
+#include <filesystem>
+
+namespace {
+    std::string fuzzy_of(const std::string& data) {
+        FuzzyHasher hasher;
+        hasher.update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        return hasher.digest();
+    }
+}
+
+TEST_SUITE("Fuzzy Hash Tests") {
+    TEST_CASE("CTPH signatures") {
+        // Эталоны сверены с классическим двухпроходным алгоритмом spamsum.
+        CHECK(fuzzy_of("") == "3::");
+        CHECK(fuzzy_of("hello") == "3:iKn:p");
+
+        const std::string data = random_bytes(100000, 5);
+        const std::string sig = fuzzy_of(data);
+        CHECK(sig == "3072:ZmMwLHd+635Nhq+NJwox8d4bP0CBc486EltQVB:ULHLNhvJLWdC0CBj02VB");
+
+        // Результат не зависит от разбиения входа на порции.
+        FuzzyHasher split;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+        split.update(bytes, 1);
+        split.update(bytes + 1, 4095);
+        split.update(bytes + 4096, data.size() - 4096);
+        CHECK(split.digest() == sig);
+    }
+
+    TEST_CASE("Similarity score") {
+        const std::string data = random_bytes(100000, 5);
+        std::string edited = data;
+        for (size_t i = 20000; i < 20500; ++i) edited[i] = 'x';
+        edited.insert(70000, "some inserted text");
+        const std::string a = fuzzy_of(data), b = fuzzy_of(edited), other = fuzzy_of(random_bytes(100000, 6));
+
+        CHECK(fuzzy_compare(a, a) == 100);
+        int score = fuzzy_compare(a, b);
+        CHECK(score > 50);
+        CHECK(score < 100);
+        CHECK(fuzzy_compare(b, a) == score);
+        CHECK(fuzzy_compare(a, other) == 0);
+        CHECK(fuzzy_compare(a, "3:iKn:p") == 0);
+        CHECK(fuzzy_compare(a + ",\"file.bin\"", a) == 100);
+        CHECK(fuzzy_compare(a, "not a signature") == -1);
+        CHECK(fuzzy_compare(a, "99999999999999999999999:iKn:p") == -1);
+        CHECK(fuzzy_compare(a, "+3:iKn:p") == -1);
+    }
+
+    TEST_CASE("Fuzzy and crypto digests in one pass") {
+        const std::string test_file = "fuzzy_test.bin";
+        const std::string data = random_bytes(3 * 1024 * 1024 + 17, 9);
+        write_bytes(test_file, data);
+        const size_t old_limit = buffer_pool::memory_limit();
+        buffer_pool::set_memory_limit(256 << 10);
+        std::vector<std::string> digests;
+        std::string fuzzy;
+        REQUIRE(fuzzy_hash_file(test_file, { "md5", "sha256" }, digests, fuzzy));
+        buffer_pool::set_memory_limit(old_limit);
+
+        REQUIRE(digests.size() == 2);
+        CHECK(digests[0] == md5_file(test_file));
+        CHECK(digests[1] == sha256_file(test_file));
+        CHECK(fuzzy == fuzzy_of(data));
+        std::filesystem::remove(test_file);
+
+        CHECK_FALSE(fuzzy_hash_file("non_existent_file.txt", { "md5" }, digests, fuzzy));
+        CHECK_FALSE(fuzzy_hash_file(test_file, { "crc" }, digests, fuzzy));
+    }
+}
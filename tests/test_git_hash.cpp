@@ -0,0 +1,41 @@
+#include "../include/doctest.h"
+#include "../include/git_hash.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    void write_text(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+}
+
+TEST_SUITE("Git Object Hash Tests") {
+    TEST_CASE("Blob and tree ids match git") {
+        // Эталоны получены `git hash-object` и `git add -A && git write-tree`
+        // на таком же каталоге (в том числе с object-format=sha256).
+        const std::string dir = "git_hash_test_dir";
+        std::filesystem::create_directories(dir + "/sub/deep");
+        std::filesystem::create_directories(dir + "/empty_dir");
+        std::filesystem::create_directories(dir + "/sp ace");
+        write_text(dir + "/a.txt", "hello");
+        write_text(dir + "/sub/big.bin", std::string(70000, 'x'));
+        write_text(dir + "/sub/deep/f", "deep");
+        write_text(dir + "/sp ace/z", "z");
+        write_text(dir + "/sub.txt", "q");
+        write_text(dir + "/sub-a", "r");
+
+        CHECK(git_blob_id(dir + "/a.txt") == "b6fc4c620b67d95f953a5c1c1230aaab5db5a1b0");
+        CHECK(git_blob_id(dir + "/sub/big.bin") == "2a19a886fed45ff5999d8c2a529ba35852fb32b8");
+        CHECK(git_blob_id(dir + "/a.txt", "sha256") == "8aec4e4876f854f688d0ebfc8f37598f38e5fd6903cccc850ca36591175aeb60");
+        CHECK(git_tree_id(dir) == "5c053eafa17e14f3a01d3fafc502e633bde08d4e");
+        CHECK(git_tree_id(dir, "sha1", 1) == "5c053eafa17e14f3a01d3fafc502e633bde08d4e");
+        CHECK(git_tree_id(dir, "sha256") == "e35fd2cdbaab914dd57ab42890c19b1b624ec891f0b167131101960b056e82c2");
+
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        CHECK(git_tree_id(dir) == "4b825dc642cb6eb9a060e54bf8d69288fbee4904");
+        std::filesystem::remove_all(dir);
+        CHECK(git_tree_id(dir).empty());
+    }
+}
@@ -0,0 +1,162 @@
+#include "../include/doctest.h"
+#include "../include/keccak.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/verifier.h"
+#include "../include/cpu_features.h"
+#include "../include/buffer_pool.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    std::string sha3_hex(size_t bits, const std::string& data, size_t step) {
+        KeccakContext ctx;
+        sha3_init(ctx, bits);
+        for (size_t pos = 0; pos < data.size(); pos += step)
+            keccak_update(ctx, bytes(data) + pos, std::min(step, data.size() - pos));
+        uint8_t out[64];
+        keccak_final(ctx, out);
+        return to_hex(out, ctx.out_len);
+    }
+
+    std::string shake_hex(size_t bits, const std::string& data, size_t out_len) {
+        KeccakContext ctx;
+        shake_init(ctx, bits, out_len);
+        keccak_update(ctx, bytes(data), data.size());
+        std::vector<uint8_t> out(out_len);
+        keccak_final(ctx, out.data());
+        return to_hex(out.data(), out.size());
+    }
+
+    std::string k12_hex(const std::string& data, size_t step, size_t out_len = 32) {
+        K12Context ctx;
+        k12_init(ctx);
+        for (size_t pos = 0; pos < data.size(); pos += step)
+            k12_update(ctx, bytes(data) + pos, std::min(step, data.size() - pos));
+        std::vector<uint8_t> out(out_len);
+        k12_final(ctx, out.data(), out_len);
+        return to_hex(out.data(), out.size());
+    }
+}
+
+TEST_SUITE("Keccak Tests") {
+    TEST_CASE("SHA-3 and SHAKE known answers") {
+        CHECK(sha3_hex(224, "abc", 3) == "e642824c3f8cf24ad09234ee7d3c766fc9a3a5168d0c94ad73b46fdf");
+        CHECK(sha3_hex(384, "abc", 3) ==
+              "ec01498288516fc926459f58e2c6ad8df9b473cb0fc08c2596da7cf0e49be4b298d88cea927ac7f539f1edf228376d25");
+        CHECK(sha3_hex(512, "abc", 3) ==
+              "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+              "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0");
+        CHECK(shake_hex(256, "abc", 64) ==
+              "483366601360a8771c6863080cc4114d8db44530f8f1e1ee4f94ea37e78b5739"
+              "d5a15bef186a5386c75744c0527e1faa9f8726e462a12a4feb06bd8801e751e4");
+        // Выход длиннее rate: между блоками выжимания нужна перестановка.
+        CHECK(shake_hex(128, "", 200) ==
+              "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef263cb1eea988004b93103cfb0aeefd2a686e01fa4a"
+              "58e8a3639ca8a1e3f9ae57e235b8cc873c23dc62b8d260169afa2f75ab916a58d974918835d25e6a435085b2badfd6dfaac359a5"
+              "efbb7bcc4b59d538df9a04302e10c8bc1cbf1a0b3a5120ea17cda7cfad765f5623474d368ccca8af0007cd9f5e4c849f167a580b"
+              "14aabdefaee7eef47cb0fca9767be1fda69419dfb927e9df07348b196691abaeb580b32def58538b8d23f877");
+
+        KeccakContext ctx;
+        CHECK_FALSE(sha3_init(ctx, 160));
+        CHECK_FALSE(shake_init(ctx, 128, 0));
+    }
+
+    TEST_CASE("SHA3-256, SHAKE128 and K12 across block and chunk boundaries") {
+        // Эталоны — hashlib и KangarooTwelve из pycryptodome. Длины задевают
+        // rate 136/168, границу куска 8192, группы из четырёх листьев (AVX2)
+        // и вырожденный последний лист из одного байта‑суффикса.
+        struct Vector { size_t size; const char* sha3_256; const char* shake128; const char* k12; };
+        const Vector vectors[] = {
+            { 0, "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a",
+              "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26",
+              "1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e5" },
+            { 1, "5223f7670b3b9ba04f57d477478ae77a58190d89f21da0b0be774735e23f9c96",
+              "7c5f30fe262c65b3a20a2c5193a291d33a1022466825e0513dc744f1821aeaed",
+              "4e03754e1abe8e2058209c8fce0ea4ac69270197c08943ce37bff6e75cbe1239" },
+            { 135, "63f84db92886bfa3f64906f97d6be2dd928befdfd397abd92ef328de09d1757c",
+              "1d076d40851774b7a18dbfafee201ff1833d72809e63ffc7574f1e078c2e7f43",
+              "b0ed8af1aa5a3b251751299812beee9572f6f7413f71be2a361da363a73b45fc" },
+            { 136, "5358180254101cbbe0c69ca0cbbaecec7644d07ae7dc913a37c8115c444075d4",
+              "88bb00fa75fa07fb70c6268aae07abfb03779eae96aef1e8acd52bd2cc78439a",
+              "d85aecc3ae7d168cf2edfd9a83f4e4156bd83ef41d10e5efc48083c8e7034339" },
+            { 167, "6e104cb773cbddba7446bb52415626e8ca70887e4850552418e7f396a37b7dc8",
+              "f753936e7c90323047092b575e69e661e15763d39c6417c9ff4a748eba761c13",
+              "38c851fc2810c4697b02f57c4b24b62a6f7bf6e5a6291913d5d6ab3fdf5a8a05" },
+            { 168, "519f8c3e1614831c20b0aee874d127187464bbcf1d19e89c77a036e3c3c9c6a1",
+              "1e8c2560e5900043afe6b28643c1b4c83d67fee1405c009fd9616c0826e8105d",
+              "84137e1a62023a116dfb0a88299f76e47722e6bfcefd1391002388b14caa7c9e" },
+            { 8191, "bb35a32297c587aa044d97970b5e8c0f0e240f8ea366c7ddb53f924c793ff472",
+              "11e0fc37cd9c2ca1baec2a28d25a3d73af3cc8c84057d7766a68199247e4fda0",
+              "6c9fe98deeb81ac2df2165da8b4769f32c0091486255f0ec9f9d2d8159439a23" },
+            { 8192, "660895315cf597fa5aaf150813b4f7d3f887e09cc90891e83ac9fd64025935bb",
+              "554dfc56221310d622440999e093965978f09cbf69763c1b4ee9dbdab9fb2095",
+              "9efe014f120ef45f0bd613d6905cc8568c6c7b16cd9e40a23aecbf6b980e7516" },
+            { 8193, "ad5654bd065446202c6b24ca349762d766ac141bca0a488e1ece7a8b2555ec5a",
+              "409ec1f85b1f9fd68602de15bfc1c9d549a8afe4bc10fed863263d058c22768d",
+              "67d5860ce73aa5945e6395bdd246ef633eb70e2be1a86b6a91c8a628b5d828d4" },
+            { 16384, "a994a76806bb5b8957e7951a2a8e392ac69cb672fb3b971ee98e0f50b5b0ad48",
+              "6cd269cd82717d0f1a1b07741030560f3c1a3544bf7e2e1cfced2a1ff6c83c58",
+              "5da7f414305774f282f91a6f8358d6a9b08d9d216a78e0ba15acbeff9244915c" },
+            { 40959, "05cb3b5b003893120a48eaeed4fdf9eae49ea2e492a9f801e58c65c7920740b1",
+              "8a4de610505265df81cb3c3c53c9cf9ff477ecbe06125d8454d5b4a8c688168a",
+              "2271b21c80047831ff4491de4c1c7118cabb30c321aa7966a70a38da9bc2ea8e" },
+            { 40960, "9f568bd6e839e8cce3ba739d51917dbd8b0e69d4fdb17267946a9df853165026",
+              "061980a14fad5e191135086cf0248e126487da47e3dd5e056c28d2cc1542b01b",
+              "78e82a6dbc5a201e09a277e15dddae70f535c2965955166fd46e6e4a74ff9b79" },
+            { 45057, "e7305bd483e8a3329aac535cda8eef099a35d6ccea0f72bb23a87beda2525456",
+              "9c23233609737efbc8cd29e5ecd9e12b8d98d90c5507eed0ffd51a36da61365d",
+              "3fb99ffb728ee702d2a611db27d4ce28706f5bf9d169a4648b1f9a02970a3dcd" },
+            { 73729, "33f447062b60c4394c0fff7eb26ca66e84c3d325faf8f72c0e8a1c79cc3e9d7a",
+              "6f8fdab40848cc64a7af43f6bce0b6f3ec624c5f6ad09c0678b062a11d0ce1bb",
+              "7961ca1509aa125f72dfe9d955b5ad95fe6a5687dc598871c14bdaa2c39befff" },
+        };
+        // С уровня avx2 — BMI и AVX2 на четыре листа, ниже — форма с дополнением дорожек.
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            for (const Vector& v : vectors) {
+                const std::string data = pattern(v.size);
+                CHECK(shake_hex(128, data, 32) == v.shake128);
+                for (size_t step : { size_t(1), size_t(1000), size_t(40000) }) {
+                    CHECK(sha3_hex(256, data, step) == v.sha3_256);
+                    CHECK(k12_hex(data, step) == v.k12);
+                }
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+    }
+
+    TEST_CASE("File hashing and hasher registry") {
+        const std::string test_file = "keccak_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            std::string data = pattern(3 * 1024 * 1024 + 12345);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        const std::string sha3 = "87169d86f0b94caa6284d4d4228f0cca28c991eab4770fe21015e934243ee29e";
+        const std::string k12 = "03110178e5ea32f7b1e96692a32059eafb223afa51d5d60285e0cc9010ac8fe6";
+        CHECK(sha3_256_file(test_file) == sha3);
+        CHECK(verify_sha3_256(test_file, sha3));
+        CHECK(hash_file("sha3_256", test_file) == sha3);
+        for (unsigned threads : { 1u, 4u }) CHECK(k12_file(test_file, 32, threads) == k12);
+        // Малый буфер пула: CV поглощаются многими пачками, последний сегмент неполный.
+        buffer_pool::set_memory_limit(256 << 10);
+        for (unsigned threads : { 1u, 3u }) CHECK(k12_file(test_file, 32, threads) == k12);
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        CHECK(k12_file(test_file, 64) == k12 + "9dbf83c85b085ec89b178556addbbc8f245131eafb075ee42d8378d3ccc45a9c");
+        CHECK(hash_file("k12", test_file) == k12);
+        std::filesystem::remove(test_file);
+        CHECK(k12_file("non_existent_file.txt").empty());
+        CHECK(sha3_512_file("non_existent_file.txt").empty());
+
+        for (const char* algo : { "sha3_224", "sha3_256", "sha3_384", "sha3_512", "shake128", "shake256", "k12" }) {
+            std::unique_ptr<Hasher> hasher = make_hasher(algo);
+            REQUIRE(hasher);
+            CHECK(hasher->name() == algo);
+            CHECK(hasher->digest().size() == hasher->digest_size());
+        }
+        CHECK(make_hasher("shake256")->digest_size() == 64);
+    }
+}
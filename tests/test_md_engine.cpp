@@ -0,0 +1,122 @@
+#include "../include/doctest.h"
+#include "../include/md_engine.h"
+#include "../include/hasher.h"
+#include "../include/cpu_features.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    /// SHA‑224 описывается одной политикой: SHA‑256 с другим IV и усечённым дайджестом.
+    struct Sha224Policy : Sha256Policy {
+        static constexpr std::array<uint32_t, 8> IV = {
+            0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+        };
+        static constexpr size_t DIGEST = 28;
+    };
+    using Sha224Engine = MdEngine<Sha224Policy>;
+
+    std::string sha224_hex(const std::string& data) {
+        uint8_t out[Sha224Engine::DIGEST];
+        Sha224Engine::digest(bytes(data), data.size(), out);
+        return to_hex(out, sizeof(out));
+    }
+}
+
+TEST_SUITE("Merkle-Damgard Engine Tests") {
+    TEST_CASE("A new policy gets every entry point") {
+        // Эталоны — hashlib.sha224.
+        CHECK(sha224_hex(pattern(0)) == "d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f");
+        CHECK(sha224_hex(pattern(55)) == "5f63fa9aad32ec0faf48d57de10b0a1ecec98b9ec8024251bb1b2aff");
+        CHECK(sha224_hex(pattern(56)) == "ab5193db7be58b4435135d34b2616fb4837eed37930f4ddc85e847c1");
+        CHECK(sha224_hex(pattern(64)) == "1941083dfbb320cd73c76e1a29b0071074db4ea5811f060c88e0e4d6");
+
+        const std::string big = pattern(200000);
+        Sha256Context ctx;
+        Sha224Engine::init(ctx);
+        for (size_t pos = 0; pos < big.size(); pos += 777)
+            Sha224Engine::update(ctx, bytes(big) + pos, std::min<size_t>(777, big.size() - pos));
+        uint8_t out[28];
+        Sha224Engine::final(ctx, out);
+        CHECK(to_hex(out, 28) == "2f4400e5fe210ec11c63188b5638f1e3782d45e8d8909b15a2b9037f");
+
+        // Диапазон: те же 64 байта в середине файла.
+        const std::string path = "md_engine_range.bin";
+        write_bytes(path, pattern(1000) + pattern(64) + pattern(300));
+        {
+            RandomAccessFile file(path);
+            REQUIRE(Sha224Engine::range(file, 1000, 64, out));
+            CHECK(to_hex(out, 28) == "1941083dfbb320cd73c76e1a29b0071074db4ea5811f060c88e0e4d6");
+            CHECK_FALSE(Sha224Engine::range(file, 1300, 100, out));
+        }
+        std::filesystem::remove(path);
+
+        // Набор файлов идёт через планировщик дорожек SHA‑256 (на AVX‑512)
+        // или по одному файлу — результат должен совпасть.
+        const char* expected[] = {
+            "359a69030e484c5a5aca6cb58e3a31ea136d3c2158f120b9013f71e1",
+            "23d8a7400885a1c535dc153333e90430202375e5a634c731f11fbfc3",
+            "da0a940e67c7db0808a123f51ec6d6e5ccbb2f93886b37727c5d0e52",
+            "63658f83e7a4f5637a494f38499e2adc78c415d199e79dfedd03b55b",
+            "1df5b74119ba4a4245463a63439787baa954d456b1ce5e55bcf65d14",
+        };
+        std::vector<std::string> paths;
+        for (int i = 0; i < 5; ++i) {
+            paths.push_back("md_engine_" + std::to_string(i) + ".bin");
+            write_bytes(paths.back(), pattern(70000 + i * 3333, i));
+        }
+        paths.push_back("non_existent_file.txt");
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            std::vector<std::string> hashes = Sha224Engine::files(paths, 1);
+            REQUIRE(hashes.size() == paths.size());
+            for (int i = 0; i < 5; ++i) CHECK(hashes[i] == expected[i]);
+            CHECK(hashes.back().empty());
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+        for (int i = 0; i < 5; ++i) std::filesystem::remove(paths[i]);
+    }
+
+    TEST_CASE("Range digests match hashlib") {
+        // Эталоны — hashlib от байтов [offset, 4000) того же буфера.
+        struct Vector { const char* algo; uint64_t offset; const char* hex; };
+        const Vector vectors[] = {
+            { "md5", 0, "8c3759e412caaef4dedb91e898e17e3d" },
+            { "md5", 1, "3d27c8082865acfdae7e43d6a5e02d90" },
+            { "md5", 130, "765e805c6fdca2e54119ab55cc5f8dfd" },
+            { "sha1", 0, "40ae8a256ce2db2bf8e8bf6465063a0ec8bce3b9" },
+            { "sha1", 1, "2ee5565098249f54e504d221181e2544edc19e90" },
+            { "sha1", 130, "c3a6a8bcd682dab4565148151002ea13175ce20f" },
+            { "sha256", 0, "f323d17212e689b95af180b9fd38dc12200ec1d9ce8b6ee4811532502e008316" },
+            { "sha256", 1, "d4e3f171d63e61fc04c9004f56e6b132268cda725eb664971f9103c73e5b10b5" },
+            { "sha256", 130, "2d7cde0cabdd8d9c1b47f40cc88d54e5bceb5f88a8d73468d1a7cf834c9f8341" },
+            { "sha384", 0, "b29d7745ec61bd3178843e30fb759144cc6e95378376b5f6675b8622fd164f0a"
+                           "bb05ef0eee1999d45b9a40043bf8ffb5" },
+            { "sha384", 1, "acb2da408e1f56a503a8e5560e41d69f0fe8b6de682c112065ea2695862d7c5c"
+                           "0e27f7a27aeaaf82636467d580c1d31d" },
+            { "sha384", 130, "1ed008f81d63a93113915f1f809a4b0fd3f8c83933eb2d16d7a14ad4cf47895d"
+                             "ffc1301060cbc78e631957f1c776dd78" },
+            { "sha512", 0, "45a49e0bf5ba291cadb5c0dc4efc7a26731200ef38d51a03ebc1f1ade3919bc7"
+                           "f5ff07d4ac94ac4cd7429e99a01e3cc651890d3d5cc589784996bcb72e303035" },
+            { "sha512", 1, "e4b09f06c043c6f68b480b1e9535f10f49fff7afb811ab51ec3cbfddcdb0e861"
+                           "fa9958ffa91fa5a4202a42cfcb023d2fdc37c55f739126bdb372d73cdf49289e" },
+            { "sha512", 130, "35d2d9eaff6d4c7cec04be115d68fc75ce3184c83d4b861325187b7a00464fa4"
+                             "da60110fe3e0e12da388c09a72e556ae9d91d04682d1a1ad8bde147cfc73ca7c" },
+            { "sha512_256", 0, "ce319ee5bc53adb19423d2f2657e7dc5ea972b3917f15b4e6d7454dadde7c468" },
+            { "sha512_256", 1, "88137daad36abdf94cef6aad8cf5dc66438a8e22c2930dc49688ba133ac5d9c0" },
+            { "sha512_256", 130, "41bc3cfa5b2ce992a353a170078f466ecbafb2993d4a8620c13d95dd91f77542" },
+        };
+        const std::string path = "md_engine_ranges.bin";
+        write_bytes(path, pattern(5000, 3));
+        RandomAccessFile file(path);
+        for (const Vector& v : vectors) {
+            std::string digest;
+            REQUIRE(digest_range(v.algo, file, v.offset, 4000 - v.offset, digest));
+            CHECK(to_hex(bytes(digest), digest.size()) == v.hex);
+            CHECK(hash_file_range(v.algo, path, v.offset, 4000 - v.offset) == v.hex);
+            CHECK_FALSE(digest_range(v.algo, file, 4990, 20, digest));
+        }
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,78 @@
+#include "../include/doctest.h"
+#include "../include/merkle.h"
+#include <filesystem>
+#include <fstream>
+
+TEST_SUITE("Merkle Index Tests") {
+    TEST_CASE("Range verification finds the damaged leaf") {
+        const std::string test_file = "merkle_test.bin";
+        const std::string index = merkle_path(test_file);
+        std::string content;
+        for (int i = 0; i < 1000000; ++i) content += static_cast<char>(i * 13 % 241);
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << content;
+        }
+
+        std::string root;
+        REQUIRE(merkle_build(test_file, "", 65536, root, 4));
+        CHECK(root.size() == 64);
+
+        std::vector<uint64_t> bad;
+        REQUIRE(merkle_verify_range(test_file, "", 0, content.size(), bad));
+        CHECK(bad.empty());
+
+        content[700000] ^= 0x40;
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << content;
+        }
+        REQUIRE(merkle_verify_range(test_file, "", 100000, 200000, bad));
+        CHECK(bad.empty());
+        REQUIRE(merkle_verify_range(test_file, "", 650000, 100000, bad));
+        CHECK(bad == std::vector<uint64_t>{ 700000 / 65536 });
+
+        CHECK(merkle_verify_range(test_file, "", 999999, 2, bad) == false);
+
+        // Пустые диапазоны, в том числе в самом конце файла.
+        for (uint64_t offset : { uint64_t(0), uint64_t(65536), uint64_t(content.size()) }) {
+            REQUIRE(merkle_verify_range(test_file, "", offset, 0, bad));
+            CHECK(bad.empty());
+        }
+
+        CHECK_FALSE(std::filesystem::exists(index + ".tmp"));
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(index);
+    }
+
+    TEST_CASE("Empty range at the end of a leaf-aligned file") {
+        // Размер кратен листу: offset == file_size даёт номер листа leaf_count.
+        const std::string test_file = "merkle_aligned.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << std::string(4 * 4096, 'a');
+        }
+        std::string root;
+        REQUIRE(merkle_build(test_file, "", 4096, root));
+        std::vector<uint64_t> bad = { 7 };
+        CHECK(merkle_verify_range(test_file, "", 4 * 4096, 0, bad));
+        CHECK(bad.empty());
+        CHECK_FALSE(merkle_verify_range(test_file, "", 4 * 4096 + 1, 0, bad));
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(merkle_path(test_file));
+    }
+
+    TEST_CASE("Empty file has a single leaf") {
+        const std::string test_file = "merkle_empty.bin";
+        { std::ofstream file(test_file, std::ios::binary); }
+        std::string root;
+        REQUIRE(merkle_build(test_file, "", 4096, root));
+        // SHA-256 одного байта 0x00 — лист пустого файла.
+        CHECK(root == "6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d");
+        std::vector<uint64_t> bad;
+        CHECK(merkle_verify_range(test_file, "", 0, 0, bad));
+        CHECK(bad.empty());
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(merkle_path(test_file));
+    }
+}
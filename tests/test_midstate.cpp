@@ -0,0 +1,52 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/midstate.h"
+#include <filesystem>
+
+TEST_SUITE("Midstate Tests") {
+    TEST_CASE("Appended file is rehashed from saved midstate") {
+        const std::string test_file = "midstate_test.log";
+        const std::string sidecar = midstate_path(test_file, "sha256");
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << std::string(10000, 'x');
+        }
+
+        IncrementalResult first = hash_file_incremental("sha256", test_file);
+        CHECK(first.hash == sha256_file(test_file));
+        CHECK(first.reused == 0);
+        CHECK(std::filesystem::exists(sidecar));
+
+        {
+            std::ofstream file(test_file, std::ios::binary | std::ios::app);
+            file << std::string(300, 'y');
+        }
+        IncrementalResult second = hash_file_incremental("sha256", test_file);
+        CHECK(second.hash == sha256_file(test_file));
+        CHECK(second.reused == 10000 / 64 * 64);
+        CHECK(second.hashed == 10300 - second.reused);
+
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(sidecar);
+    }
+
+    TEST_CASE("Changed prefix falls back to a full rehash") {
+        const std::string test_file = "midstate_changed.log";
+        const std::string sidecar = midstate_path(test_file, "md5");
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << std::string(5000, 'a');
+        }
+        hash_file_incremental("md5", test_file);
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << std::string(5000, 'b') << "tail";
+        }
+        IncrementalResult result = hash_file_incremental("md5", test_file);
+        CHECK(result.hash == md5_file(test_file));
+        CHECK(result.reused == 0);
+
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(sidecar);
+    }
+}
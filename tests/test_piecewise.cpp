@@ -0,0 +1,41 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/piecewise.h"
+#include <filesystem>
+
+TEST_SUITE("Piecewise Hash Tests") {
+    TEST_CASE("Window digests and total in one pass") {
+        const std::string test_file = "piecewise_test.bin";
+        const std::string table = "piecewise_test.table";
+        std::string content;
+        for (int i = 0; i < 2500000; ++i) content += static_cast<char>(i * 7 % 253);
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << content;
+        }
+
+        PiecewiseResult result = piecewise_hash("sha256", test_file, 1 << 20, 3);
+        CHECK(result.hash == sha256_file(test_file));
+        REQUIRE(result.windows.size() == 3);
+        CHECK(result.windows[0] == hash_file_range("sha256", test_file, 0, 1 << 20));
+        CHECK(result.windows[2] == hash_file_range("sha256", test_file, 2 << 20, content.size() - (2 << 20)));
+
+        REQUIRE(write_window_table(table, result));
+        PiecewiseResult loaded;
+        REQUIRE(read_window_table(table, loaded));
+        CHECK(loaded.windows == result.windows);
+        CHECK(changed_windows(loaded, result).empty());
+
+        content[1500000] ^= 1;
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << content;
+        }
+        PiecewiseResult damaged = piecewise_hash("sha256", test_file, 1 << 20);
+        CHECK(changed_windows(loaded, damaged) == std::vector<size_t>{ 1 });
+
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(table);
+    }
+}
@@ -0,0 +1,33 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include <filesystem>
+
+TEST_SUITE("Range Hash Tests") {
+    TEST_CASE("Range digest equals digest of the slice") {
+        const std::string test_file = "range_test.bin";
+        const std::string slice_file = "range_slice.bin";
+        std::string content;
+        for (int i = 0; i < 300000; ++i) content += static_cast<char>(i * 31 % 251);
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            file << content;
+            std::ofstream slice(slice_file, std::ios::binary);
+            slice << content.substr(12345, 200000);
+        }
+
+        CHECK(hash_file_range("sha256", test_file, 12345, 200000) == sha256_file(slice_file));
+        CHECK(hash_file_range("md5", test_file, 0, content.size()) == md5_file(test_file));
+        CHECK(hash_file_range("sha1", test_file, 299000, 5000).empty());
+
+        std::vector<ByteRange> ranges;
+        for (uint64_t off = 0; off < 280000; off += 10000) ranges.push_back({ off, 20000 });
+        std::vector<std::string> hashes = hash_file_ranges("sha1", test_file, ranges, 4);
+        REQUIRE(hashes.size() == ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i)
+            CHECK(hashes[i] == hash_file_range("sha1", test_file, ranges[i].offset, ranges[i].length));
+
+        std::filesystem::remove(test_file);
+        std::filesystem::remove(slice_file);
+    }
+}
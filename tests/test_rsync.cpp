@@ -0,0 +1,123 @@
+#include "../include/doctest.h"
+#include "../include/rsync.h"
+#include "../include/buffer_pool.h"
+#include "../include/cpu_features.h"
+#include "test_util.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    /// Восстанавливает новый файл из старого и литералов нового по дельте.
+    std::string apply(const std::string& old_data, const std::string& new_data,
+                      const RsyncDelta& delta, uint64_t block_size) {
+        std::string out;
+        for (const DeltaOp& op : delta.ops) {
+            if (op.block == DeltaOp::LITERAL) out += new_data.substr(op.offset, op.length);
+            else out += old_data.substr(op.block * block_size, op.length);
+        }
+        return out;
+    }
+}
+
+TEST_SUITE("Rsync Tests") {
+    TEST_CASE("Weak checksum: SIMD, scalar and sliding windows agree") {
+        // Эталон — прямой расчёт a = Σx, b = Σa по модулю 2¹⁶.
+        std::string text;
+        for (int i = 0; i < 40; ++i) text += "abcdefghijklmnopqrstuvwxyz";
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(text.data());
+        CHECK(rsync_weak(bytes, text.size()) == 0x90a8bcd8u);
+        set_simd_enabled(false);
+        CHECK(rsync_weak(bytes, text.size()) == 0x90a8bcd8u);
+        set_simd_enabled(true);
+
+        const std::string data = random_bytes(5000, 3);
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data());
+        for (size_t window : { size_t(1), size_t(7), size_t(700) }) {
+            const size_t count = data.size() - window + 1;
+            std::vector<uint32_t> simd(count), scalar(count);
+            rsync_weak_windows(p, window, count, simd.data());
+            set_simd_enabled(false);
+            rsync_weak_windows(p, window, count, scalar.data());
+            set_simd_enabled(true);
+            CHECK(simd == scalar);
+            for (size_t k : { size_t(0), size_t(1), count / 2, count - 1 })
+                CHECK(simd[k] == rsync_weak(p + k, window));
+        }
+    }
+
+    TEST_CASE("Signature and delta reconstruct the new file") {
+        const std::string old_file = "rsync_old.bin", new_file = "rsync_new.bin", sig_file = "rsync_old.sig";
+        const uint64_t block = 1024;
+        const std::string old_data = random_bytes(300 * 1024 + 100, 11);
+        std::string new_data = old_data;
+        new_data.insert(5000, "inserted bytes");
+        new_data[150000] ^= 0x55;
+        new_data.erase(200000, 3000);
+        new_data += "appended";
+        write_bytes(old_file, old_data);
+        write_bytes(new_file, new_data);
+
+        for (const char* algo : { "md5", "sha256" }) {
+            RsyncSignature signature;
+            REQUIRE(rsync_signature(old_file, algo, block, signature));
+            CHECK(signature.weak.size() == 301);
+            REQUIRE(write_signature(sig_file, signature));
+            RsyncSignature loaded;
+            REQUIRE(read_signature(sig_file, loaded));
+            CHECK(loaded.weak == signature.weak);
+            CHECK(loaded.strong == signature.strong);
+
+            RsyncDelta delta;
+            REQUIRE(rsync_delta(new_file, loaded, delta));
+            CHECK(delta.matched_bytes + delta.literal_bytes == new_data.size());
+            CHECK(delta.literal_bytes < 6 * block);
+            CHECK(apply(old_data, new_data, delta, block) == new_data);
+        }
+
+        // Блок длиннее буфера пула проходит через буфер частями.
+        RsyncSignature whole, streamed;
+        REQUIRE(rsync_signature(old_file, "sha256", 100000, whole));
+        buffer_pool::set_memory_limit(256 << 10);
+        REQUIRE(buffer_pool::buffer_size() < 100000);
+        REQUIRE(rsync_signature(old_file, "sha256", 100000, streamed, 3));
+        RsyncDelta streamed_delta;
+        REQUIRE(rsync_delta(new_file, streamed, streamed_delta));
+        buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        CHECK(streamed.weak == whole.weak);
+        CHECK(streamed.strong == whole.strong);
+        CHECK(apply(old_data, new_data, streamed_delta, 100000) == new_data);
+
+        // Неизменённый файл — одна копия, включая короткий последний блок.
+        RsyncSignature signature;
+        REQUIRE(rsync_signature(old_file, "md5", block, signature, 1));
+        RsyncDelta same;
+        REQUIRE(rsync_delta(old_file, signature, same));
+        REQUIRE(same.ops.size() == 1);
+        CHECK(same.ops[0].block == 0);
+        CHECK(same.ops[0].length == old_data.size());
+        CHECK(same.literal_bytes == 0);
+
+        std::filesystem::remove(old_file);
+        std::filesystem::remove(new_file);
+        std::filesystem::remove(sig_file);
+        CHECK_FALSE(rsync_signature("non_existent_file.txt", "md5", block, signature));
+        CHECK_FALSE(rsync_signature(old_file, "crc", block, signature));
+
+        // Слабая сумма — ровно восемь hex‑цифр.
+        const std::string strong(32, '0');
+        for (const char* weak : { "zzzzzzzz", "1234567g", "-1234567", "0x123456" }) {
+            std::ofstream bad(sig_file);
+            bad << "# rsync-signature md5 block=1024 size=10\n" << weak << " " << strong << "\n";
+            bad.close();
+            CHECK_FALSE(read_signature(sig_file, signature));
+        }
+        {
+            std::ofstream good(sig_file);
+            good << "# rsync-signature md5 block=1024 size=10\n0badf00d " << strong << "\n";
+        }
+        REQUIRE(read_signature(sig_file, signature));
+        CHECK(signature.weak == std::vector<uint32_t>{ 0x0badf00d });
+        std::filesystem::remove(sig_file);
+    }
+}
@@ -0,0 +1,122 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/cpu_features.h"
+#include "../include/buffer_pool.h"
+#include "test_util.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    std::string sha256_hex(const std::string& data, size_t step) {
+        Sha256Context ctx;
+        sha256_init(ctx);
+        for (size_t pos = 0; pos < data.size(); pos += step)
+            sha256_update(ctx, reinterpret_cast<const uint8_t*>(data.data()) + pos, std::min(step, data.size() - pos));
+        uint8_t digest[32];
+        sha256_final(ctx, digest);
+        return to_hex(digest, sizeof(digest));
+    }
+}
+
+TEST_SUITE("SHA-256 Tests") {
+    TEST_CASE("Two-block AVX2 schedule matches the scalar transform") {
+        // Эталоны — hashlib. Чётное и нечётное число блоков в одном вызове
+        // update задевает и пары блоков, и одиночный последний блок.
+        struct Vector { size_t size; const char* sha256; };
+        const Vector vectors[] = {
+            { 0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+            { 55, "90049a7259f123e69f1cea2403d496ffa7b647cd45ea9f4487dd778f9578b246" },
+            { 56, "40f60a3a579d89962bdffdbc476f9bd0d9a28231f4b65711c902127841d298e2" },
+            { 64, "e7a402f6bfefa6ff48bc1fe1bb5b77e5c9c24ca9185937a8cf07a8fdaf2424f0" },
+            { 119, "9dda2ff19b1a365f5a1aea438180f213ebd3b9471e96cb6eea744c0155a59a7e" },
+            { 128, "a1e19a9775b673aaeb645655cad464ac5cfed26e721f9eb068194c70af4119e9" },
+            { 192, "2fab4f0a508c865101d01445973308736bfafe51558ff59fe96269828d18a5b3" },
+            { 256, "2aeb6c09d761cd5251a33d9bd5c645a0661713b9aef2bce404549aeca1b978c6" },
+            { 1000, "1d233630ad95d3d0b86b4f4f65abfb23ea0fabd4d2f25fc5fc5f5b2b6cdf74cb" },
+            { 4113, "b48a3afb47eb81835dbd6f04ba5a2d0f143077e66065b27714cdc15e6ac79ecd" },
+            { 100000, "19f97b14865b8f1663f34517b87b8ad07303d928431c1f2a92f446d6586a8d04" },
+        };
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            for (const Vector& v : vectors) {
+                const std::string data = pattern(v.size);
+                for (size_t step : { size_t(1), size_t(100), size_t(192), data.size() + 1 })
+                    CHECK(sha256_hex(data, step) == v.sha256);
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+    }
+
+    TEST_CASE("Sixteen-lane kernels and lane scheduler") {
+        // Разные данные в каждой дорожке: перепутанные дорожки дали бы чужой хеш.
+        std::vector<std::string> blocks;
+        std::array<uint32_t, 8> sha[16], sha_ref[16];
+        std::array<uint32_t, 4> md5[16], md5_ref[16];
+        std::array<uint32_t, 8>* sha_ptr[16];
+        std::array<uint32_t, 4>* md5_ptr[16];
+        const uint8_t* data[16];
+        Sha256Context sc;
+        sha256_init(sc);
+        Md5Context mc;
+        md5_init(mc);
+        for (int l = 0; l < 16; ++l) blocks.push_back(pattern(3 * 64, l * 11));
+        for (int l = 0; l < 16; ++l) {
+            sha_ref[l] = sc.H;
+            md5_ref[l] = mc.H;
+            sha_ptr[l] = &sha[l];
+            md5_ptr[l] = &md5[l];
+            data[l] = reinterpret_cast<const uint8_t*>(blocks[l].data());
+            for (int b = 0; b < 3; ++b) {
+                sha256_internal::sha256_transform(sha_ref[l], data[l] + 64 * b);
+                md5_internal::md5_transform(md5_ref[l], data[l] + 64 * b);
+            }
+        }
+        // avx512bw и avx512f — два разных ядра SHA-256 на 16 дорожек.
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            for (int l = 0; l < 16; ++l) {
+                sha[l] = sc.H;
+                md5[l] = mc.H;
+            }
+            sha256_internal::sha256_transform_x16(sha_ptr, data, 3);
+            md5_internal::md5_transform_x16(md5_ptr, data, 3);
+            for (int l = 0; l < 16; ++l) {
+                CHECK(sha[l] == sha_ref[l]);
+                CHECK(md5[l] == md5_ref[l]);
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+
+        // Файлов больше, чем дорожек, разной длины (в том числе пустые,
+        // короче блока и длиннее доли буфера) и один несуществующий.
+        const size_t sizes[] = { 0, 1, 63, 64, 65, 1000, 70000, 300000, 128, 4095, 4096, 200001,
+                                 5, 640, 99999, 64 * 1024, 64 * 1024 + 1, 7, 12345, 250000, 33, 1 << 20 };
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+            paths.push_back("lanes_test_" + std::to_string(i) + ".bin");
+            std::ofstream file(paths.back(), std::ios::binary);
+            const std::string body = pattern(sizes[i], static_cast<int>(i));
+            file.write(body.data(), static_cast<std::streamsize>(body.size()));
+        }
+        paths.insert(paths.begin() + 9, "non_existent_file.txt");
+
+        for (const char* algo : { "md5", "sha256" }) {
+            set_simd_enabled(false);
+            std::vector<std::string> expected;
+            for (const std::string& path : paths) expected.push_back(hash_file(algo, path));
+            set_simd_enabled(true);
+            for (unsigned threads : { 1u, 2u }) CHECK(hash_files(algo, paths, threads) == expected);
+            CHECK(expected[9].empty());
+
+            // Лимит в один буфер: планировщик не должен брать второй буфер
+            // для хвостов, иначе он ждёт сам себя.
+            buffer_pool::set_memory_limit(100000);
+            for (unsigned threads : { 1u, 2u }) CHECK(hash_files(algo, paths, threads) == expected);
+            buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        }
+        for (const std::string& path : paths) std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,117 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/verifier.h"
+#include "../include/cpu_features.h"
+#include "../include/buffer_pool.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    std::string digest_of(const std::string& algo, const std::string& data) {
+        std::unique_ptr<Hasher> hasher = make_hasher(algo);
+        hasher->update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        std::string digest = hasher->digest();
+        return to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size());
+    }
+}
+
+TEST_SUITE("SHA-512 Family Tests") {
+    TEST_CASE("Known answers, including padding boundaries") {
+        // Эталоны — hashlib (sha512, sha384, sha512_256).
+        CHECK(digest_of("sha512", "") == "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+        CHECK(digest_of("sha384", "") == "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b");
+        CHECK(digest_of("sha512_256", "") == "c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a");
+        CHECK(digest_of("sha512", "abc") == "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+        CHECK(digest_of("sha384", "abc") == "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+        CHECK(digest_of("sha512_256", "abc") == "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23");
+        CHECK(digest_of("sha512", std::string(111, 'a')) == "fa9121c7b32b9e01733d034cfc78cbf67f926c7ed83e82200ef86818196921760b4beff48404df811b953828274461673c68d04e297b0eb7b2b4d60fc6b566a2");
+        CHECK(digest_of("sha512", std::string(112, 'a')) == "c01d080efd492776a1c43bd23dd99d0a2e626d481e16782e75d54c2503b5dc32bd05f0f1ba33e568b88fd2d970929b719ecbb152f58f130a407c8830604b70ca");
+        CHECK(digest_of("sha384", std::string(112, 'a')) == "187d4e07cb306103c69967bf544d0dfbe9042577599c73c330abc0cb64c61236d5ed565ee19119d8c31779a38f791fcd");
+        CHECK(digest_of("sha512_256", std::string(239, 'a')) == "78d0a1b37aaad84c89fff13cbe3cd3d1025bcdb648268f9102b7e7032bea7d2a");
+
+        const std::string test_file = "sha512_test.bin";
+        write_bytes(test_file, pattern(3 * 1024 * 1024 + 12345));
+        const std::string expected = "a86a1601140cc03b9c3bf184ee30d0daf0e1619567bcc9e4bcfbcf1043bcf24eb3539f1163fa9bd7fccbae78b85bf17ba39f82e31eaa0b88e40846f30608ad7f";
+        CHECK(sha512_file(test_file) == expected);
+        CHECK(hash_file("sha512", test_file) == expected);
+        CHECK(verify_sha512(test_file, expected));
+        CHECK(verify_sha384(test_file, sha384_file(test_file)));
+        std::filesystem::remove(test_file);
+        CHECK(sha512_file("non_existent_file.txt").empty());
+    }
+
+    TEST_CASE("Midstate and saved state") {
+        const std::string data = pattern(1000);
+        std::unique_ptr<Hasher> first = make_hasher("sha512");
+        CHECK(first->block_size() == 128);
+        first->update(reinterpret_cast<const uint8_t*>(data.data()), 512);
+        std::vector<uint32_t> state;
+        uint64_t length = 0;
+        REQUIRE(first->export_midstate(state, length));
+        CHECK(state.size() == 16);
+        CHECK(length == 512);
+
+        std::unique_ptr<Hasher> resumed = make_hasher("sha512");
+        REQUIRE(resumed->import_midstate(state, length));
+        resumed->update(reinterpret_cast<const uint8_t*>(data.data()) + 512, data.size() - 512);
+        std::string digest = resumed->digest();
+        CHECK(to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size()) == digest_of("sha512", data));
+
+        std::unique_ptr<Hasher> partial = make_hasher("sha384");
+        partial->update(reinterpret_cast<const uint8_t*>(data.data()), 300);
+        std::string blob = partial->save_state();
+        REQUIRE_FALSE(blob.empty());
+        std::unique_ptr<Hasher> loaded = make_hasher("sha384");
+        REQUIRE(loaded->load_state(blob));
+        loaded->update(reinterpret_cast<const uint8_t*>(data.data()) + 300, data.size() - 300);
+        digest = loaded->digest();
+        CHECK(to_hex(reinterpret_cast<const uint8_t*>(digest.data()), digest.size()) == digest_of("sha384", data));
+    }
+
+    TEST_CASE("Four-lane multi-buffer kernel") {
+        std::string messages[4];
+        for (int l = 0; l < 4; ++l) messages[l] = pattern(128 * 9 + 50, l * 13);
+
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            Sha512Context ctx[4];
+            Sha512Context* lanes[4];
+            const uint8_t* data[4];
+            for (int l = 0; l < 4; ++l) {
+                sha512_init(ctx[l]);
+                lanes[l] = &ctx[l];
+                data[l] = reinterpret_cast<const uint8_t*>(messages[l].data());
+            }
+            sha512_update_x4(lanes, data, messages[0].size());
+            for (int l = 0; l < 4; ++l) {
+                uint8_t digest[64];
+                sha512_final(ctx[l], digest);
+                CHECK(to_hex(digest, 64) == digest_of("sha512", messages[l]));
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+
+        // Файлы разного размера: общая часть идёт в четыре дорожки, хвосты — отдельно.
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < 6; ++i) {
+            paths.push_back("sha512_batch_" + std::to_string(i) + ".bin");
+            write_bytes(paths.back(), pattern(200000 + i * 7777, static_cast<int>(i)));
+        }
+        paths.push_back("non_existent_file.txt");
+        for (const char* algo : { "sha512", "sha384", "sha512_256", "md5" }) {
+            std::vector<std::string> hashes = hash_files(algo, paths);
+            REQUIRE(hashes.size() == paths.size());
+            for (size_t i = 0; i + 1 < paths.size(); ++i) CHECK(hashes[i] == hash_file(algo, paths[i]));
+            CHECK(hashes.back().empty());
+
+            // Лимит в один буфер: дорожки AVX2 не должны ждать второй буфер.
+            buffer_pool::set_memory_limit(100000);
+            CHECK(hash_files(algo, paths, 1) == hashes);
+            CHECK(hash_files(algo, paths, 2) == hashes);
+            buffer_pool::set_memory_limit(buffer_pool::DEFAULT_MEMORY_LIMIT);
+        }
+        for (size_t i = 0; i + 1 < paths.size(); ++i) std::filesystem::remove(paths[i]);
+    }
+}
@@ -0,0 +1,73 @@
+#include "../include/doctest.h"
+#include "../include/hash.h"
+#include "../include/torrent.h"
+#include "test_util.h"
+#include <filesystem>
+
+namespace {
+    std::string hex_of(const std::string& bytes) {
+        return to_hex(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    }
+}
+
+TEST_SUITE("BitTorrent Piece Tests") {
+    TEST_CASE("v1 and v2 piece hashes of a file set") {
+        // Эталоны посчитаны независимой реализацией BEP 3 / BEP 52.
+        const std::string dir = "torrent_test_dir";
+        std::filesystem::create_directories(dir + "/b");
+        write_bytes(dir + "/a.bin", pattern(100000, 3));
+        write_bytes(dir + "/b/empty.bin", "");
+        write_bytes(dir + "/b/c.bin", pattern(40000, 5));
+        write_bytes(dir + "/d.bin", pattern(300000, 7));
+
+        std::vector<std::string> files;
+        REQUIRE(torrent_file_list(dir, files));
+        REQUIRE(files.size() == 4);
+
+        std::vector<std::string> pieces;
+        REQUIRE(torrent_v1_pieces(files, 65536, pieces, 3));
+        REQUIRE(pieces.size() == 7);
+        CHECK(hex_of(pieces[0]) == "f0350bd7d3d4fe86b4da5d4db593ea26f7dcffe1");
+        CHECK(hex_of(pieces[1]) == "599361c46ddc16bba4d65776d78b3fb624bcf977");
+        CHECK(hex_of(pieces[6]) == "251e0c99632cb51994d2da7ff18948e56da0fab2");
+
+        std::vector<TorrentV2File> v2;
+        REQUIRE(torrent_v2_hashes(files, 65536, v2));
+        REQUIRE(v2.size() == 4);
+        CHECK(hex_of(v2[0].root) == "9dfc7b0e7f1cacdfb365f2e51faf0aaf6c43a3446cec4a22ce152e6aca4a0f0e");
+        REQUIRE(v2[0].layer.size() == 2);
+        CHECK(hex_of(v2[0].layer[1]) == "a657643cef0721ff7c66a237aa2bbe82c9fbc65ba6c9aa22252fd82845058e28");
+        CHECK(hex_of(v2[1].root) == "263cd5a86e524619a341c895b6e5c8ae7ae2e3771b3eeb7aa865cebd929b04a3");
+        CHECK(v2[1].layer.empty());
+        CHECK(v2[2].root.empty());
+        CHECK(hex_of(v2[3].root) == "e2c04a07cd913f1980dec23720b9781e0ab40eb94c8ca0b3ffc22b12faf5c518");
+        REQUIRE(v2[3].layer.size() == 5);
+        CHECK(hex_of(v2[3].layer[1]) == "71d85499f0af2a6ac6de2d874909ff1d5785cfbf159c15957aaa871bb6399f59");
+
+        REQUIRE(write_torrent_v1("torrent_v1.txt", 65536, pieces));
+        REQUIRE(write_torrent_v2("torrent_v2.txt", 65536, v2));
+        std::vector<std::string> bad;
+        REQUIRE(torrent_verify(dir, "torrent_v1.txt", bad));
+        CHECK(bad.empty());
+        REQUIRE(torrent_verify(dir, "torrent_v2.txt", bad));
+        CHECK(bad.empty());
+
+        write_bytes(dir + "/b/c.bin", pattern(40000, 6));
+        REQUIRE(torrent_verify(dir, "torrent_v1.txt", bad));
+        CHECK(bad == std::vector<std::string>{ "piece 1", "piece 2" });
+        REQUIRE(torrent_verify(dir, "torrent_v2.txt", bad));
+        CHECK(bad == std::vector<std::string>{ dir + "/b/c.bin" });
+
+        // Расхождения отмечаются по каждому файлу: кусок первого файла не
+        // скрывает несовпавший корень последнего.
+        v2[0].layer[1][0] ^= 1;
+        v2[3].root[0] ^= 1;
+        REQUIRE(write_torrent_v2("torrent_v2.txt", 65536, v2));
+        REQUIRE(torrent_verify(dir, "torrent_v2.txt", bad));
+        CHECK(bad == std::vector<std::string>{ dir + "/a.bin piece 1", dir + "/b/c.bin", dir + "/d.bin" });
+
+        std::filesystem::remove_all(dir);
+        std::filesystem::remove("torrent_v1.txt");
+        std::filesystem::remove("torrent_v2.txt");
+    }
+}
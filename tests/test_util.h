@@ -0,0 +1,39 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Общие помощники тестов: детерминированные данные и запись файлов.
+ */
+
+/// Байты (i * 29 + 7 + seed) mod 256; по ним посчитаны эталоны hashlib в тестах.
+inline std::string pattern(size_t size, int seed = 0) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>((i * 29 + 7 + seed) % 256);
+    return data;
+}
+
+/// Псевдослучайные байты (LCG); в отличие от pattern() не повторяются с периодом 256.
+inline std::string random_bytes(size_t size, uint32_t seed) {
+    std::string data(size, '\0');
+    for (char& c : data) {
+        seed = seed * 1103515245u + 12345u;
+        c = static_cast<char>(seed >> 24);
+    }
+    return data;
+}
+
+inline void write_bytes(const std::string& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+inline const uint8_t* bytes(const std::string& data) {
+    return reinterpret_cast<const uint8_t*>(data.data());
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "../include/doctest.h"
+#include "../include/xxh3.h"
+#include "../include/hash.h"
+#include "../include/hasher.h"
+#include "../include/verifier.h"
+#include "../include/byte_order.h"
+#include "../include/cpu_features.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    std::string hex64(uint64_t value) {
+        uint8_t out[8];
+        store_be64(out, value);
+        return to_hex(out, 8);
+    }
+
+    std::string hex128(const Xxh128Hash& h) {
+        return hex64(h.high) + hex64(h.low);
+    }
+}
+
+TEST_SUITE("XXH3 Tests") {
+    TEST_CASE("Known answers for every length class") {
+        // Эталоны — пакет xxhash для Python (xxh3_64, xxh128).
+        struct Vector { size_t size; const char* h64; const char* h128; };
+        const Vector vectors[] = {
+            { 0, "2d06800538d394c2", "99aa06d3014798d86001c324468d497f" },
+            { 1, "4c5cca45d0f4811f", "495b62073ef70ca44c5cca45d0f4811f" },
+            { 3, "9b9918267a041375", "585bfafb59833d289b9918267a041375" },
+            { 4, "6a7659adbffd6a40", "0685a028b06e1bf7b6a2e7a54787d90c" },
+            { 8, "8f886877e74c6306", "bf0b3fca0747d7add52122a3d0afdbc5" },
+            { 9, "9fadcd3ff79de4d6", "9fcee52851c26769d302862a316dcc2b" },
+            { 16, "4746236b201ad4a0", "fccbbe47e56eee6cb11f86e71431a898" },
+            { 17, "da21e02c176d376e", "1c3ee9b49265e05d0f7682ace46da49b" },
+            { 128, "3ddf31296c5a9114", "b3a84cfdcb6eb87394f39757041d25c3" },
+            { 129, "f44f88fc0869c930", "2d3a4822136304bf5b74c38a25a60595" },
+            { 240, "2cc5010ec5ad5b4a", "888c54f9d53b85f9ffa240d291015b0c" },
+            { 241, "4ea31ca2fee0ef82", "2e9631eed1bf0bbe4ea31ca2fee0ef82" },
+            { 255, "5b944fde287cd3fd", "60af68d6a376912b5b944fde287cd3fd" },
+            { 256, "d9e46e3ef6760faf", "3ae0d29da0a4227cd9e46e3ef6760faf" },
+            { 257, "70e4ff87c2406894", "ae9003be18f3a1e670e4ff87c2406894" },
+            { 1024, "3a2a145ffad119a6", "87faf0d734d883133a2a145ffad119a6" },
+            { 1025, "94394a64dff65a0b", "d782aa7f8b1c43e194394a64dff65a0b" },
+            { 2047, "5d7e7f3f066a628c", "af8acb8c6b2250085d7e7f3f066a628c" },
+            { 5000, "c17d5fc14fcfbe57", "3ac8a88a50b5513ac17d5fc14fcfbe57" },
+        };
+        for (SimdLevel level : SIMD_LEVELS) {
+            set_simd_max_level(level);
+            for (const Vector& v : vectors) {
+                const std::string data = pattern(v.size);
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+                CHECK(hex64(xxh3_64(bytes, data.size())) == v.h64);
+                CHECK(hex128(xxh3_128(bytes, data.size())) == v.h128);
+
+                // Неровные порции: полосы попадают то в буфер, то прямо из входа.
+                for (size_t step : { size_t(1), size_t(7), size_t(300) }) {
+                    Xxh3State state;
+                    xxh3_init(state);
+                    for (size_t pos = 0; pos < data.size(); pos += step)
+                        xxh3_update(state, bytes + pos, std::min(step, data.size() - pos));
+                    CHECK(hex64(xxh3_64_digest(state)) == v.h64);
+                    CHECK(hex128(xxh3_128_digest(state)) == v.h128);
+                }
+            }
+        }
+        set_simd_max_level(SimdLevel::avx512bw);
+    }
+
+    TEST_CASE("File hashing and hasher flags") {
+        const std::string test_file = "xxh3_test.bin";
+        {
+            std::ofstream file(test_file, std::ios::binary);
+            std::string data = pattern(3 * 1024 * 1024 + 12345);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        CHECK(xxh3_file(test_file) == "6784454e34cb1375");
+        CHECK(xxh128_file(test_file) == "2ad184c1198291f96784454e34cb1375");
+        CHECK(hash_file("xxh3", test_file) == "6784454e34cb1375");
+        CHECK(hash_file("xxh128", test_file) == "2ad184c1198291f96784454e34cb1375");
+        CHECK(verify_xxh3(test_file, "6784454e34cb1375"));
+        CHECK(verify_xxh128(test_file, "2ad184c1198291f96784454e34cb1375"));
+        CHECK_FALSE(verify_xxh3(test_file, "6784454e34cb1376"));
+        std::filesystem::remove(test_file);
+        CHECK(xxh3_file("non_existent_file.txt").empty());
+
+        CHECK_FALSE(make_hasher("xxh3")->cryptographic());
+        CHECK_FALSE(make_hasher("xxh128")->cryptographic());
+        CHECK(make_hasher("sha256")->cryptographic());
+        CHECK(make_hasher("blake3")->cryptographic());
+    }
+}